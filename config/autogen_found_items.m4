@@ -0,0 +1,164 @@
+dnl
+dnl $HEADER$
+dnl
+dnl ---------------------------------------------------------------------------
+dnl This file is automatically created by autogen.pl; it should not
+dnl be edited by hand!!
+dnl
+dnl Generated by root at Sun Oct 18 02:47:56 2026
+dnl on vm.
+dnl ---------------------------------------------------------------------------
+
+m4_define([autogen_platform_file], [])
+
+
+dnl Project names
+m4_define([project_name_long], [PRRTE])
+m4_define([project_name_short], [PRRTE])
+
+dnl ---------------------------------------------------------------------------
+dnl ---------------------------------------------------------------------------
+dnl ---------------------------------------------------------------------------
+
+dnl MCA information
+dnl ---------------------------------------------------------------------------
+
+dnl Frameworks in the prrte project and their corresponding directories
+m4_define([mca_prrte_framework_list], [common, errmgr, ess, filem, grpcomm, iof, odls, oob, plm, prtebacktrace, prtecompress, prtedl, prteif, prteinstalldirs, prtereachable, pstat, ras, rmaps, rml, routed, rtc, schizo, state])
+
+dnl Components in the prrte / common framework
+m4_define([mca_prrte_common_m4_config_component_list], [alps])
+m4_define([mca_prrte_common_no_config_component_list], [])
+
+dnl Components in the prrte / errmgr framework
+m4_define([mca_prrte_errmgr_m4_config_component_list], [])
+m4_define([mca_prrte_errmgr_no_config_component_list], [dvm, prted])
+
+dnl Components in the prrte / ess framework
+m4_define([mca_prrte_ess_m4_config_component_list], [alps, lsf, slurm, tm])
+m4_define([mca_prrte_ess_no_config_component_list], [env, hnp])
+
+dnl Components in the prrte / filem framework
+m4_define([mca_prrte_filem_m4_config_component_list], [])
+m4_define([mca_prrte_filem_no_config_component_list], [raw])
+
+dnl Components in the prrte / grpcomm framework
+m4_define([mca_prrte_grpcomm_m4_config_component_list], [])
+m4_define([mca_prrte_grpcomm_no_config_component_list], [direct, rcd])
+
+dnl Components in the prrte / iof framework
+m4_define([mca_prrte_iof_m4_config_component_list], [])
+m4_define([mca_prrte_iof_no_config_component_list], [hnp, prted])
+
+dnl Components in the prrte / odls framework
+m4_define([mca_prrte_odls_m4_config_component_list], [alps, default])
+m4_define([mca_prrte_odls_no_config_component_list], [])
+
+dnl Components in the prrte / oob framework
+m4_define([mca_prrte_oob_m4_config_component_list], [alps, tcp])
+m4_define([mca_prrte_oob_no_config_component_list], [])
+
+dnl Components in the prrte / plm framework
+m4_define([mca_prrte_plm_m4_config_component_list], [alps, lsf, rsh, slurm, tm])
+m4_define([mca_prrte_plm_no_config_component_list], [])
+
+dnl Components in the prrte / prtebacktrace framework
+m4_define([mca_prrte_prtebacktrace_m4_config_component_list], [execinfo, none, printstack])
+m4_define([mca_prrte_prtebacktrace_no_config_component_list], [])
+
+dnl Components in the prrte / prtecompress framework
+m4_define([mca_prrte_prtecompress_m4_config_component_list], [zlib])
+m4_define([mca_prrte_prtecompress_no_config_component_list], [])
+
+dnl Components in the prrte / prtedl framework
+m4_define([mca_prrte_prtedl_m4_config_component_list], [dlopen, libltdl])
+m4_define([mca_prrte_prtedl_no_config_component_list], [])
+
+dnl Components in the prrte / prteif framework
+m4_define([mca_prrte_prteif_m4_config_component_list], [bsdx_ipv4, bsdx_ipv6, linux_ipv6, posix_ipv4, solaris_ipv6])
+m4_define([mca_prrte_prteif_no_config_component_list], [])
+
+dnl Components in the prrte / prteinstalldirs framework
+m4_define([mca_prrte_prteinstalldirs_m4_config_component_list], [config, env])
+m4_define([mca_prrte_prteinstalldirs_no_config_component_list], [])
+
+dnl Components in the prrte / prtereachable framework
+m4_define([mca_prrte_prtereachable_m4_config_component_list], [netlink])
+m4_define([mca_prrte_prtereachable_no_config_component_list], [weighted])
+
+dnl Components in the prrte / pstat framework
+m4_define([mca_prrte_pstat_m4_config_component_list], [linux, test])
+m4_define([mca_prrte_pstat_no_config_component_list], [])
+
+dnl Components in the prrte / ras framework
+m4_define([mca_prrte_ras_m4_config_component_list], [alps, gridengine, lsf, slurm, tm])
+m4_define([mca_prrte_ras_no_config_component_list], [simulator])
+
+dnl Components in the prrte / rmaps framework
+m4_define([mca_prrte_rmaps_m4_config_component_list], [])
+m4_define([mca_prrte_rmaps_no_config_component_list], [mindist, ppr, rank_file, resilient, round_robin, seq])
+
+dnl Components in the prrte / rml framework
+m4_define([mca_prrte_rml_m4_config_component_list], [])
+m4_define([mca_prrte_rml_no_config_component_list], [oob])
+
+dnl Components in the prrte / routed framework
+m4_define([mca_prrte_routed_m4_config_component_list], [])
+m4_define([mca_prrte_routed_no_config_component_list], [binomial, debruijn, direct, radix])
+
+dnl Components in the prrte / rtc framework
+m4_define([mca_prrte_rtc_m4_config_component_list], [])
+m4_define([mca_prrte_rtc_no_config_component_list], [hwloc])
+
+dnl Components in the prrte / schizo framework
+m4_define([mca_prrte_schizo_m4_config_component_list], [singularity, slurm])
+m4_define([mca_prrte_schizo_no_config_component_list], [ompi, pmix, prrte])
+
+dnl Components in the prrte / state framework
+m4_define([mca_prrte_state_m4_config_component_list], [])
+m4_define([mca_prrte_state_no_config_component_list], [dvm, prted])
+
+dnl ---------------------------------------------------------------------------
+
+dnl List of configure.m4 files to include
+m4_include([src/mca/prtebacktrace/configure.m4])
+m4_include([src/mca/prtedl/configure.m4])
+m4_include([src/mca/prteinstalldirs/configure.m4])
+m4_include([src/mca/pstat/configure.m4])
+m4_include([src/mca/common/alps/configure.m4])
+m4_include([src/mca/ess/alps/configure.m4])
+m4_include([src/mca/ess/lsf/configure.m4])
+m4_include([src/mca/ess/slurm/configure.m4])
+m4_include([src/mca/ess/tm/configure.m4])
+m4_include([src/mca/odls/alps/configure.m4])
+m4_include([src/mca/odls/default/configure.m4])
+m4_include([src/mca/oob/alps/configure.m4])
+m4_include([src/mca/oob/tcp/configure.m4])
+m4_include([src/mca/plm/alps/configure.m4])
+m4_include([src/mca/plm/lsf/configure.m4])
+m4_include([src/mca/plm/rsh/configure.m4])
+m4_include([src/mca/plm/slurm/configure.m4])
+m4_include([src/mca/plm/tm/configure.m4])
+m4_include([src/mca/prtebacktrace/execinfo/configure.m4])
+m4_include([src/mca/prtebacktrace/none/configure.m4])
+m4_include([src/mca/prtebacktrace/printstack/configure.m4])
+m4_include([src/mca/prtecompress/zlib/configure.m4])
+m4_include([src/mca/prtedl/dlopen/configure.m4])
+m4_include([src/mca/prtedl/libltdl/configure.m4])
+m4_include([src/mca/prteif/bsdx_ipv4/configure.m4])
+m4_include([src/mca/prteif/bsdx_ipv6/configure.m4])
+m4_include([src/mca/prteif/linux_ipv6/configure.m4])
+m4_include([src/mca/prteif/posix_ipv4/configure.m4])
+m4_include([src/mca/prteif/solaris_ipv6/configure.m4])
+m4_include([src/mca/prteinstalldirs/config/configure.m4])
+m4_include([src/mca/prteinstalldirs/env/configure.m4])
+m4_include([src/mca/prtereachable/netlink/configure.m4])
+m4_include([src/mca/pstat/linux/configure.m4])
+m4_include([src/mca/pstat/test/configure.m4])
+m4_include([src/mca/ras/alps/configure.m4])
+m4_include([src/mca/ras/gridengine/configure.m4])
+m4_include([src/mca/ras/lsf/configure.m4])
+m4_include([src/mca/ras/slurm/configure.m4])
+m4_include([src/mca/ras/tm/configure.m4])
+m4_include([src/mca/schizo/singularity/configure.m4])
+m4_include([src/mca/schizo/slurm/configure.m4])
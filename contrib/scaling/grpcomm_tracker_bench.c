@@ -0,0 +1,214 @@
+/* -*- C -*-
+ *
+ * $HEADER$
+ *
+ * Drive a large number of concurrent grpcomm collective trackers
+ * through prrte_grpcomm_base_get_tracker() - as happens when many
+ * sub-communicator fences are in flight at once - and time how long
+ * it takes to create them, to look each of them up as their
+ * fragments arrive, and to retire them.
+ *
+ * No DVM is required - the grpcomm base is opened in-process with a
+ * stub routing tree, and every proc in the signatures belongs to a
+ * fabricated job that is mapped onto this daemon. Requires PRRTE to
+ * be configured with --with-devel-headers.
+ *
+ * Usage: grpcomm_tracker_bench [-n ntrackers] [-s procs/signature]
+ *                              [-l lookups/tracker] [-linear]
+ *
+ * -linear also times the same lookups using a full signature compare
+ * against every ongoing tracker, for comparison with the index.
+ */
+
+#include "prrte_config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "constants.h"
+#include "src/dss/dss.h"
+#include "src/mca/grpcomm/base/base.h"
+#include "src/mca/rmaps/rmaps_types.h"
+#include "src/mca/routed/routed.h"
+#include "src/runtime/prrte_globals.h"
+#include "src/runtime/runtime.h"
+#include "src/runtime/runtime_internals.h"
+#include "src/util/proc_info.h"
+
+/* every collective is local to this daemon */
+static void no_children(prrte_list_t *coll)
+{
+    return;
+}
+
+static double elapsed(struct timeval *start)
+{
+    struct timeval stop;
+
+    gettimeofday(&stop, NULL);
+    return (double)(stop.tv_sec - start->tv_sec) +
+           (double)(stop.tv_usec - start->tv_usec) / 1000000.0;
+}
+
+/* what every lookup cost before the trackers were indexed */
+static prrte_grpcomm_coll_t* linear_lookup(prrte_grpcomm_signature_t *sig)
+{
+    prrte_grpcomm_coll_t *coll;
+
+    PRRTE_LIST_FOREACH(coll, &prrte_grpcomm_base.ongoing, prrte_grpcomm_coll_t) {
+        if (PRRTE_EQUAL == prrte_dss.compare(sig, coll->sig, PRRTE_SIGNATURE)) {
+            return coll;
+        }
+    }
+    return NULL;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t ntrackers = 10000, sigsize = 32, nlookups = 8;
+    bool linear = false;
+    prrte_grpcomm_signature_t **sigs;
+    prrte_grpcomm_coll_t **colls, *coll;
+    prrte_job_t *jdata;
+    prrte_node_t *node;
+    prrte_proc_t *daemon, *proc;
+    struct timeval start;
+    size_t n, m, k;
+    int i;
+
+    for (i=1; i < argc; i++) {
+        if (0 == strcmp(argv[i], "-n") && i+1 < argc) {
+            ntrackers = strtoul(argv[++i], NULL, 10);
+        } else if (0 == strcmp(argv[i], "-s") && i+1 < argc) {
+            sigsize = strtoul(argv[++i], NULL, 10);
+        } else if (0 == strcmp(argv[i], "-l") && i+1 < argc) {
+            nlookups = strtoul(argv[++i], NULL, 10);
+        } else if (0 == strcmp(argv[i], "-linear")) {
+            linear = true;
+        } else {
+            fprintf(stderr, "Usage: %s [-n ntrackers] [-s procs/signature] [-l lookups/tracker] [-linear]\n", argv[0]);
+            exit(1);
+        }
+    }
+    if (0 == ntrackers || 0 == sigsize) {
+        fprintf(stderr, "ntrackers and procs/signature must be positive\n");
+        exit(1);
+    }
+
+    if (PRRTE_SUCCESS != prrte_init_util(PRRTE_PROC_MASTER)) {
+        fprintf(stderr, "Failed prrte_init_util\n");
+        exit(1);
+    }
+    /* register the runtime data types, signatures among them */
+    if (PRRTE_SUCCESS != prrte_dt_init()) {
+        fprintf(stderr, "Failed prrte_dt_init\n");
+        exit(1);
+    }
+    if (PRRTE_SUCCESS != prrte_mca_base_framework_open(&prrte_grpcomm_base_framework, 0)) {
+        fprintf(stderr, "Failed to open grpcomm\n");
+        exit(1);
+    }
+    prrte_routed.get_routing_list = no_children;
+    PRRTE_PROC_MY_NAME->jobid = 1;
+    PRRTE_PROC_MY_NAME->vpid = 0;
+    prrte_process_info.num_daemons = 1;
+
+    /* fabricate a job whose procs are all hosted by us. The
+     * trackers only need to find each proc's daemon, so every
+     * vpid can share the same proc object */
+    prrte_job_data = PRRTE_NEW(prrte_hash_table_t);
+    prrte_hash_table_init(prrte_job_data, 128);
+    daemon = PRRTE_NEW(prrte_proc_t);
+    daemon->name = *PRRTE_PROC_MY_NAME;
+    node = PRRTE_NEW(prrte_node_t);
+    node->daemon = daemon;
+    jdata = PRRTE_NEW(prrte_job_t);
+    jdata->jobid = 2;
+    jdata->map = PRRTE_NEW(prrte_job_map_t);
+    prrte_pointer_array_add(jdata->map->nodes, node);
+    jdata->map->num_nodes = 1;
+    proc = PRRTE_NEW(prrte_proc_t);
+    proc->node = node;
+    for (n=0; n < ntrackers * sigsize; n++) {
+        prrte_pointer_array_set_item(jdata->procs, n, proc);
+    }
+    prrte_hash_table_set_value_uint32(prrte_job_data, jdata->jobid, jdata);
+
+    /* tracker n covers every ntrackers'th proc starting at n, as
+     * a split of a single communicator by color would */
+    sigs = (prrte_grpcomm_signature_t**)malloc(ntrackers * sizeof(prrte_grpcomm_signature_t*));
+    colls = (prrte_grpcomm_coll_t**)malloc(ntrackers * sizeof(prrte_grpcomm_coll_t*));
+    for (n=0; n < ntrackers; n++) {
+        sigs[n] = PRRTE_NEW(prrte_grpcomm_signature_t);
+        sigs[n]->sz = sigsize;
+        sigs[n]->signature = (prrte_process_name_t*)malloc(sigsize * sizeof(prrte_process_name_t));
+        for (m=0; m < sigsize; m++) {
+            sigs[n]->signature[m].jobid = jdata->jobid;
+            sigs[n]->signature[m].vpid = n + m * ntrackers;
+        }
+    }
+
+    gettimeofday(&start, NULL);
+    for (n=0; n < ntrackers; n++) {
+        if (NULL == (colls[n] = prrte_grpcomm_base_get_tracker(sigs[n], true))) {
+            fprintf(stderr, "Failed to create tracker %lu\n", (unsigned long)n);
+            exit(1);
+        }
+    }
+    fprintf(stdout, "create   %lu trackers: %f sec\n", (unsigned long)ntrackers, elapsed(&start));
+
+    /* fragments arrive in no particular order, so stride
+     * through the trackers rather than walking them in
+     * creation order */
+    gettimeofday(&start, NULL);
+    for (k=0; k < nlookups; k++) {
+        for (n=0; n < ntrackers; n++) {
+            m = (n * 7919 + k) % ntrackers;
+            if (colls[m] != prrte_grpcomm_base_get_tracker(sigs[m], false)) {
+                fprintf(stderr, "Lookup of tracker %lu failed\n", (unsigned long)m);
+                exit(1);
+            }
+        }
+    }
+    fprintf(stdout, "index    %lu lookups: %f sec\n",
+            (unsigned long)(nlookups * ntrackers), elapsed(&start));
+
+    if (linear) {
+        gettimeofday(&start, NULL);
+        for (k=0; k < nlookups; k++) {
+            for (n=0; n < ntrackers; n++) {
+                m = (n * 7919 + k) % ntrackers;
+                if (colls[m] != linear_lookup(sigs[m])) {
+                    fprintf(stderr, "Linear lookup of tracker %lu failed\n", (unsigned long)m);
+                    exit(1);
+                }
+            }
+        }
+        fprintf(stdout, "linear   %lu lookups: %f sec\n",
+                (unsigned long)(nlookups * ntrackers), elapsed(&start));
+    }
+
+    gettimeofday(&start, NULL);
+    for (n=0; n < ntrackers; n++) {
+        coll = colls[n];
+        prrte_grpcomm_base_remove_tracker(coll);
+        PRRTE_RELEASE(coll);
+    }
+    fprintf(stdout, "remove   %lu trackers: %f sec\n", (unsigned long)ntrackers, elapsed(&start));
+    if (0 != prrte_list_get_size(&prrte_grpcomm_base.ongoing)) {
+        fprintf(stderr, "%lu trackers left behind\n",
+                (unsigned long)prrte_list_get_size(&prrte_grpcomm_base.ongoing));
+        exit(1);
+    }
+
+    for (n=0; n < ntrackers; n++) {
+        PRRTE_RELEASE(sigs[n]);
+    }
+    free(sigs);
+    free(colls);
+
+    prrte_mca_base_framework_close(&prrte_grpcomm_base_framework);
+    return 0;
+}
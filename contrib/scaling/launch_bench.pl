@@ -0,0 +1,122 @@
+#!/usr/bin/env perl
+#
+# Copyright (c) 2020      Intel, Inc. All rights reserved.
+#
+# Time how long it takes to launch N trivial procs on each node,
+# once with the daemons forking every proc and once with them
+# using vfork (odls_default_use_vfork). Each run is timed from
+# the starter's invocation until every proc has exited, so run a
+# few reps and compare the two columns rather than reading too
+# much into the absolute numbers.
+#
+
+use strict;
+use Getopt::Long;
+use Time::HiRes qw(gettimeofday tv_interval);
+
+# globals
+my @ppn = (1, 16, 64);
+my $reps = 3;
+my $exe = "/bin/true";
+my $hostfile;
+my $starter = "prte";
+my $modes = "fork,vfork";
+my $myresults;
+
+# Set to true if the script should merely print the cmds
+# it would run, but don't run them
+my $SHOWME = 0;
+# Set to true to suppress most informational messages.
+my $QUIET = 0;
+# Set to true if we just want to see the help message
+my $HELP = 0;
+
+GetOptions(
+    "help" => \$HELP,
+    "quiet" => \$QUIET,
+    "showme" => \$SHOWME,
+    "ppn=s" => sub { @ppn = split(/,/, $_[1]); },
+    "reps=i" => \$reps,
+    "exe=s" => \$exe,
+    "hostfile=s" => \$hostfile,
+    "starter=s" => \$starter,
+    "modes=s" => \$modes,
+    "results=s" => \$myresults,
+) or die "unable to parse options, stopped";
+
+if ($HELP) {
+    print "$0 [options]
+
+--help | -h          This help message
+--quiet | -q         Only output critical messages to stdout
+--showme             Show the actual commands without executing them
+--ppn=list           Comma-separated list of procs/node to launch (default: 1,16,64)
+--reps=n             Number of times to launch each configuration (default: 3)
+--exe=path           Executable to launch (default: /bin/true)
+--hostfile=file      Nodes to launch on (default: just this node)
+--starter=cmd        Command used to start the procs (default: prte)
+--modes=list         Comma-separated list of spawn modes to time (default: fork,vfork)
+--results=file       Write the timings to file as csv
+";
+    exit(0);
+}
+
+my $nnodes = 1;
+if (defined $hostfile) {
+    open(my $fh, "<", $hostfile) or die "cannot open $hostfile: $!";
+    $nnodes = scalar(grep { /^\s*[^#\s]/ } <$fh>);
+    close($fh);
+}
+
+my @results;
+
+foreach my $n (@ppn) {
+    my $nprocs = $n * $nnodes;
+    foreach my $mode (split(/,/, $modes)) {
+        my $cmd = "$starter";
+        if ($mode eq "vfork") {
+            $cmd = $cmd . " --prtemca odls_default_use_vfork 1";
+        } elsif ($mode ne "fork") {
+            die "unknown spawn mode $mode, stopped";
+        }
+        if (defined $hostfile) {
+            $cmd = $cmd . " --hostfile $hostfile";
+        }
+        $cmd = $cmd . " --map-by ppr:$n:node:OVERSUBSCRIBE -n $nprocs $exe";
+
+        if ($SHOWME) {
+            print $cmd . "\n";
+            next;
+        }
+        if (!$QUIET) {
+            print "Launching $n procs/node on $nnodes nodes with $mode\n";
+        }
+        my $total = 0;
+        my $done = 0;
+        for (my $rep=0; $rep < $reps; $rep++) {
+            my $start = [gettimeofday];
+            my $rc = system("$cmd > /dev/null 2>&1");
+            my $secs = tv_interval($start);
+            if (0 != $rc) {
+                print "    $mode failed to launch - rc $rc\n";
+                last;
+            }
+            push @results, "$mode,$nnodes,$n,$rep,$secs";
+            printf("    rep %d: %12.6f sec\n", $rep, $secs) unless $QUIET;
+            $total += $secs;
+            $done++;
+        }
+        if (0 < $done && !$QUIET) {
+            printf("    %-12s mean %12.6f sec\n", $mode, $total / $done);
+        }
+    }
+}
+
+if (defined $myresults && 0 < scalar(@results)) {
+    open(my $fh, ">", $myresults) or die "cannot create $myresults: $!";
+    print $fh "mode,nodes,ppn,rep,seconds\n";
+    foreach my $row (@results) {
+        print $fh "$row\n";
+    }
+    close($fh);
+}
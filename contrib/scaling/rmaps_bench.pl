@@ -0,0 +1,193 @@
+#!/usr/bin/env perl
+#
+# Copyright (c) 2020      Intel, Inc. All rights reserved.
+#
+# Time the mapping, ranking, and binding phases of each rmaps
+# component against a simulated allocation. No processes are
+# launched - the ras simulator fabricates the nodes and forces
+# do-not-launch, and rmaps_base_report_timing has the HNP print
+# the time spent in each phase along with its peak memory.
+#
+
+use strict;
+use Getopt::Long;
+use File::Temp qw(tempdir);
+
+# globals
+my @num_nodes = (1000);
+my $slots = 16;
+my $topology = "socket:2 core:8 pu:2";
+my $topofile;
+my $device = "auto";
+my $reps = 1;
+my $np = 0;
+my $mappers = "round_robin,ppr,mindist,seq,rank_file,resilient";
+my $starter = "prte";
+my $rawoutput = 0;
+my $myresults;
+
+# Set to true if the script should merely print the cmds
+# it would run, but don't run them
+my $SHOWME = 0;
+# Set to true to suppress most informational messages.
+my $QUIET = 0;
+# Set to true if we just want to see the help message
+my $HELP = 0;
+
+GetOptions(
+    "help" => \$HELP,
+    "quiet" => \$QUIET,
+    "showme" => \$SHOWME,
+    "nodes=s" => sub { @num_nodes = split(/,/, $_[1]); },
+    "slots=i" => \$slots,
+    "np=i" => \$np,
+    "topology=s" => \$topology,
+    "topofile=s" => \$topofile,
+    "device=s" => \$device,
+    "reps=i" => \$reps,
+    "mappers=s" => \$mappers,
+    "starter=s" => \$starter,
+    "results=s" => \$myresults,
+    "rawout" => \$rawoutput,
+) or die "unable to parse options, stopped";
+
+if ($HELP) {
+    print "$0 [options]
+
+--help | -h          This help message
+--quiet | -q         Only output critical messages to stdout
+--showme             Show the actual commands without executing them
+--nodes=list         Comma-separated list of allocation sizes to simulate (default: 1000)
+--slots=n            Number of slots on each simulated node (default: 16)
+--np=n               Number of procs to map (default: fill every slot)
+--topology=desc      Synthetic hwloc topology for each node (default: \"socket:2 core:8 pu:2\")
+--topofile=file      XML topology file to use instead of a synthetic topology
+--device=name        Device for the mindist mapper (default: auto)
+--reps=n             Number of times to map each configuration (default: 1)
+--mappers=list       Comma-separated list of mappers to exercise
+                     (default: round_robin,ppr,mindist,seq,rank_file,resilient)
+--starter=cmd        Command used to start the mapping (default: prte)
+--results=file       Write the timings to file as csv
+--rawout             Also print the raw output of each run
+";
+    exit(0);
+}
+
+my $dir = tempdir(CLEANUP => 1);
+my @results;
+
+# the ras simulator names its nodes "nodeA" followed by the
+# node index, zero-padded to the number of digits in the
+# allocation size
+sub node_names {
+    my $n = shift;
+    my $dig = length("$n");
+    my @names;
+    for (my $i=0; $i < $n; $i++) {
+        push @names, sprintf("nodeA%0*d", $dig, $i);
+    }
+    return @names;
+}
+
+# build any input files a mapper needs and return the
+# options that select it
+sub mapper_options {
+    my ($mapper, $nnodes, $nprocs) = @_;
+    my @names = node_names($nnodes);
+    my $file;
+    my $fh;
+
+    if ($mapper eq "round_robin") {
+        return "--map-by slot";
+    } elsif ($mapper eq "ppr") {
+        return "--map-by ppr:$slots:node";
+    } elsif ($mapper eq "mindist") {
+        return "--mca rmaps_dist_device $device --map-by dist";
+    } elsif ($mapper eq "seq") {
+        $file = "$dir/hostfile.$nnodes";
+        open($fh, ">", $file) or die "cannot create $file: $!";
+        for (my $i=0; $i < $nprocs; $i++) {
+            print $fh $names[int($i / $slots)] . "\n";
+        }
+        close($fh);
+        return "--map-by seq --hostfile $file";
+    } elsif ($mapper eq "rank_file") {
+        $file = "$dir/rankfile.$nnodes";
+        open($fh, ">", $file) or die "cannot create $file: $!";
+        for (my $i=0; $i < $nprocs; $i++) {
+            printf $fh "rank %d=%s slot=%d\n", $i, $names[int($i / $slots)], $i % $slots;
+        }
+        close($fh);
+        return "--mca rmaps_rank_file_path $file";
+    } elsif ($mapper eq "resilient") {
+        # put every 16 nodes into their own fault group
+        $file = "$dir/ftgrps.$nnodes";
+        open($fh, ">", $file) or die "cannot create $file: $!";
+        for (my $i=0; $i < $nnodes; $i += 16) {
+            my $last = ($i + 15 < $nnodes) ? $i + 15 : $nnodes - 1;
+            print $fh join(",", @names[$i..$last]) . "\n";
+        }
+        close($fh);
+        return "--mca rmaps_resilient_fault_grp_file $file";
+    }
+    die "unknown mapper $mapper, stopped";
+}
+
+foreach my $nnodes (@num_nodes) {
+    my $nprocs = ($np > 0) ? $np : $nnodes * $slots;
+    foreach my $mapper (split(/,/, $mappers)) {
+        my $cmd = "$starter --mca ras simulator --mca ras_simulator_num_nodes $nnodes";
+        $cmd = $cmd . " --mca ras_simulator_slots $slots";
+        if (defined $topofile) {
+            $cmd = $cmd . " --mca ras_simulator_topo_files $topofile";
+        } else {
+            $cmd = $cmd . " --mca ras_simulator_topologies \"$topology\"";
+        }
+        $cmd = $cmd . " --mca rmaps $mapper --mca rmaps_base_report_timing 1";
+        $cmd = $cmd . " " . mapper_options($mapper, $nnodes, $nprocs);
+        $cmd = $cmd . " --oversubscribe -np $nprocs hostname 2>&1";
+
+        for (my $rep=0; $rep < $reps; $rep++) {
+            if ($SHOWME) {
+                print $cmd . "\n";
+                next;
+            }
+            if (!$QUIET) {
+                print "Mapping $nprocs procs on $nnodes nodes with $mapper\n";
+            }
+            my @output = `$cmd`;
+            my $found = 0;
+            foreach my $line (@output) {
+                if ($rawoutput) {
+                    print $line;
+                }
+                # [name] rmaps:timing job J nodes N procs P phase X: T sec maxrss M
+                if ($line =~ /rmaps:timing job \S+ nodes (\d+) procs (\d+) phase (\S+): ([\d.]+) sec maxrss (\d+)/) {
+                    my $phase = $3;
+                    # the mapping phase is reported under the name
+                    # of whichever mapper actually did the work
+                    if ($phase ne "compute_vpids" && $phase ne "compute_local_ranks" &&
+                        $phase ne "assign_locations" && $phase ne "compute_bindings" &&
+                        $phase ne "total") {
+                        $phase = "map_job($phase)";
+                    }
+                    push @results, "$mapper,$nnodes,$2,$rep,$phase,$4,$5";
+                    printf("    %-28s %12.6f sec  maxrss %d\n", $phase, $4, $5) unless $QUIET;
+                    $found = 1;
+                }
+            }
+            if (!$found) {
+                print "    $mapper failed to map - no timing reported\n";
+            }
+        }
+    }
+}
+
+if (defined $myresults && 0 < scalar(@results)) {
+    open(my $fh, ">", $myresults) or die "cannot create $myresults: $!";
+    print $fh "mapper,nodes,procs,rep,phase,seconds,maxrss\n";
+    foreach my $row (@results) {
+        print $fh "$row\n";
+    }
+    close($fh);
+}
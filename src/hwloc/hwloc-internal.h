@@ -129,10 +129,17 @@ typedef struct {
 } prrte_hwloc_summary_t;
 PRRTE_CLASS_DECLARATION(prrte_hwloc_summary_t);
 
+/* highest cache level we index directly - deeper caches
+ * fall back to a search of the summary list */
+#define PRRTE_HWLOC_SUMMARY_MAX_CACHE_LEVEL  4
+
 typedef struct {
     prrte_object_t super;
     hwloc_cpuset_t available;
     prrte_list_t summaries;
+    /* non-owning index into the summaries list, by resource
+     * type, object type, and cache level */
+    prrte_hwloc_summary_t *sumidx[PRRTE_HWLOC_AVAILABLE][HWLOC_OBJ_TYPE_MAX][PRRTE_HWLOC_SUMMARY_MAX_CACHE_LEVEL+1];
 
     /** \brief Additional space for custom data */
     void *userdata;
@@ -340,6 +347,11 @@ PRRTE_EXPORT unsigned int prrte_hwloc_base_get_nbobjs_by_type(hwloc_topology_t t
                                                               hwloc_obj_type_t target,
                                                               unsigned cache_level,
                                                               prrte_hwloc_resource_type_t rtype);
+/**
+ * Precompute the object counts the mappers ask for so that
+ * every node sharing this topology can use the cached values
+ */
+PRRTE_EXPORT void prrte_hwloc_base_summarize(hwloc_topology_t topo);
 PRRTE_EXPORT void prrte_hwloc_base_clear_usage(hwloc_topology_t topo);
 
 PRRTE_EXPORT hwloc_obj_t prrte_hwloc_base_get_obj_by_type(hwloc_topology_t topo,
@@ -13,6 +13,8 @@
 
 #include "prrte_config.h"
 
+#include <string.h>
+
 #include "src/include/constants.h"
 #include "src/dss/dss.h"
 #include "src/util/argv.h"
@@ -418,6 +420,7 @@ static void topo_data_const(prrte_hwloc_topo_data_t *ptr)
 {
     ptr->available = NULL;
     PRRTE_CONSTRUCT(&ptr->summaries, prrte_list_t);
+    memset(ptr->sumidx, 0, sizeof(ptr->sumidx));
     ptr->userdata = NULL;
 }
 static void topo_data_dest(prrte_hwloc_topo_data_t *ptr)
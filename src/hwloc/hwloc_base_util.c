@@ -675,6 +675,7 @@ unsigned int prrte_hwloc_base_get_nbobjs_by_type(hwloc_topology_t topo,
     hwloc_obj_t obj;
     prrte_hwloc_summary_t *sum;
     prrte_hwloc_topo_data_t *data;
+    bool indexed;
     int rc;
 
     /* bozo check */
@@ -707,9 +708,17 @@ unsigned int prrte_hwloc_base_get_nbobjs_by_type(hwloc_topology_t topo,
 
     /* first see if the topology already has this summary */
     data = (prrte_hwloc_topo_data_t*)obj->userdata;
+    indexed = (0 < rtype && rtype <= PRRTE_HWLOC_AVAILABLE &&
+               (unsigned)target < HWLOC_OBJ_TYPE_MAX &&
+               cache_level <= PRRTE_HWLOC_SUMMARY_MAX_CACHE_LEVEL);
     if (NULL == data) {
         data = PRRTE_NEW(prrte_hwloc_topo_data_t);
         obj->userdata = (void*)data;
+    } else if (indexed) {
+        sum = data->sumidx[rtype-1][target][cache_level];
+        if (NULL != sum) {
+            return sum->num_objs;
+        }
     } else {
         PRRTE_LIST_FOREACH(sum, &data->summaries, prrte_hwloc_summary_t) {
             if (target == sum->type &&
@@ -734,6 +743,9 @@ unsigned int prrte_hwloc_base_get_nbobjs_by_type(hwloc_topology_t topo,
     sum->num_objs = num_objs;
     sum->rtype = rtype;
     prrte_list_append(&data->summaries, &sum->super);
+    if (indexed) {
+        data->sumidx[rtype-1][target][cache_level] = sum;
+    }
 
     PRRTE_OUTPUT_VERBOSE((5, prrte_hwloc_base_output,
                          "hwloc:base:get_nbojbs computed data %u of %s:%u",
@@ -742,6 +754,23 @@ unsigned int prrte_hwloc_base_get_nbobjs_by_type(hwloc_topology_t topo,
     return num_objs;
 }
 
+void prrte_hwloc_base_summarize(hwloc_topology_t topo)
+{
+    if (NULL == topo) {
+        return;
+    }
+    /* these are the counts the mappers and the topology
+     * report consult for every node - compute them once
+     * per topology so identical nodes just read the cache */
+    (void)prrte_hwloc_base_get_nbobjs_by_type(topo, HWLOC_OBJ_NODE, 0, PRRTE_HWLOC_AVAILABLE);
+    (void)prrte_hwloc_base_get_nbobjs_by_type(topo, HWLOC_OBJ_SOCKET, 0, PRRTE_HWLOC_AVAILABLE);
+    (void)prrte_hwloc_base_get_nbobjs_by_type(topo, HWLOC_OBJ_L3CACHE, 3, PRRTE_HWLOC_AVAILABLE);
+    (void)prrte_hwloc_base_get_nbobjs_by_type(topo, HWLOC_OBJ_L2CACHE, 2, PRRTE_HWLOC_AVAILABLE);
+    (void)prrte_hwloc_base_get_nbobjs_by_type(topo, HWLOC_OBJ_L1CACHE, 1, PRRTE_HWLOC_AVAILABLE);
+    (void)prrte_hwloc_base_get_nbobjs_by_type(topo, HWLOC_OBJ_CORE, 0, PRRTE_HWLOC_AVAILABLE);
+    (void)prrte_hwloc_base_get_nbobjs_by_type(topo, HWLOC_OBJ_PU, 0, PRRTE_HWLOC_AVAILABLE);
+}
+
 /* as above, only return the Nth instance of the specified object
  * type from inside the topology
  */
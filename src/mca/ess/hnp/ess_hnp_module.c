@@ -483,7 +483,10 @@ static int rte_init(int argc, char **argv)
     /* generate the signature */
     prrte_topo_signature = prrte_hwloc_base_get_topo_signature(prrte_hwloc_topology);
     t->sig = strdup(prrte_topo_signature);
-    prrte_pointer_array_add(prrte_node_topologies, t);
+    if (PRRTE_SUCCESS != (ret = prrte_set_topology_object(t))) {
+        error = "record topology";
+        goto error;
+    }
     node->topology = t;
     if (15 < prrte_output_get_verbosity(prrte_ess_base_framework.framework_output)) {
         prrte_output(0, "%s Topology Info:", PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME));
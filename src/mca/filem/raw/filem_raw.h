@@ -16,6 +16,11 @@
 
 #include "prrte_config.h"
 
+#include <sys/types.h>
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif
+
 #include "src/mca/mca.h"
 #include "src/class/prrte_object.h"
 #include "src/event/event-internal.h"
@@ -28,8 +33,22 @@ PRRTE_MODULE_EXPORT extern prrte_filem_base_component_t prrte_filem_raw_componen
 PRRTE_EXPORT extern prrte_filem_base_module_t prrte_filem_raw_module;
 
 extern bool prrte_filem_raw_flatten_trees;
+extern int prrte_filem_raw_chunk_size;
+extern int prrte_filem_raw_window;
+extern bool prrte_filem_raw_report_throughput;
+extern bool prrte_filem_raw_cache;
+extern bool prrte_filem_raw_stream_extract;
+
+#define PRRTE_FILEM_RAW_CHUNK_SIZE  (1024 * 1024)
+#define PRRTE_FILEM_RAW_WINDOW      8
 
-#define PRRTE_FILEM_RAW_CHUNK_MAX 16384
+/* chunk number used to tell the daemons that they already
+ * hold the contents of a file under the given digest */
+#define PRRTE_FILEM_RAW_CACHED      -2
+
+/* chunk number carried by a daemon's final report on a file,
+ * as opposed to its acknowledgement of a single chunk */
+#define PRRTE_FILEM_RAW_DONE        -1
 
 /* local classes */
 typedef struct {
@@ -53,6 +72,28 @@ typedef struct {
     int32_t nchunk;
     int status;
     prrte_vpid_t nrecvd;
+    /* source file and read position */
+    int fd;
+    off_t offset;
+    unsigned char *buf;
+    /* flow control - the number of leading chunks every daemon
+     * has acknowledged, the number of daemons still acknowledging,
+     * and a count of acks for each chunk in the window */
+    int32_t nacked;
+    prrte_vpid_t nackers;
+    prrte_vpid_t *acks;
+    /* for the throughput report */
+    struct timeval start;
+    uint64_t nbytes;
+    /* content digest, and the source attributes it was computed
+     * from so we only need to compute it once per version */
+    char *digest;
+    time_t mtime;
+    off_t size;
+    /* the daemons were asked to position the file from their
+     * cached copy, and at least one of them didn't have it */
+    bool cached;
+    bool missed;
 } prrte_filem_raw_xfer_t;
 PRRTE_CLASS_DECLARATION(prrte_filem_raw_xfer_t);
 
@@ -68,13 +109,23 @@ typedef struct {
     int32_t type;
     char **link_pts;
     prrte_list_t outputs;
+    char *digest;
+    /* pipe to, and pid of, the process extracting an
+     * archive as it arrives */
+    prrte_event_t xev;
+    int xfd;
+    pid_t xpid;
 } prrte_filem_raw_incoming_t;
 PRRTE_CLASS_DECLARATION(prrte_filem_raw_incoming_t);
 
 typedef struct {
     prrte_list_item_t super;
     int numbytes;
-    unsigned char data[PRRTE_FILEM_RAW_CHUNK_MAX];
+    /* number of bytes already written */
+    int nwritten;
+    /* number of bytes already handed to the extractor */
+    int npiped;
+    unsigned char *data;
 } prrte_filem_raw_output_t;
 PRRTE_CLASS_DECLARATION(prrte_filem_raw_output_t);
 
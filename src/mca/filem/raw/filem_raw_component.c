@@ -37,6 +37,11 @@ static int filem_raw_close(void);
 static int filem_raw_query(prrte_mca_base_module_t **module, int *priority);
 
 bool prrte_filem_raw_flatten_trees=false;
+int prrte_filem_raw_chunk_size = PRRTE_FILEM_RAW_CHUNK_SIZE;
+int prrte_filem_raw_window = PRRTE_FILEM_RAW_WINDOW;
+bool prrte_filem_raw_report_throughput = false;
+bool prrte_filem_raw_cache = true;
+bool prrte_filem_raw_stream_extract = true;
 
 prrte_filem_base_component_t prrte_filem_raw_component = {
     .base_version = {
@@ -70,6 +75,52 @@ static int filem_raw_register(void)
                                            PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
                                            &prrte_filem_raw_flatten_trees);
 
+    prrte_filem_raw_chunk_size = PRRTE_FILEM_RAW_CHUNK_SIZE;
+    (void) prrte_mca_base_component_var_register(c, "chunk_size",
+                                           "Number of bytes read from a file and sent to the daemons in each message",
+                                           PRRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           PRRTE_INFO_LVL_9,
+                                           PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                           &prrte_filem_raw_chunk_size);
+    if (prrte_filem_raw_chunk_size <= 0) {
+        prrte_filem_raw_chunk_size = PRRTE_FILEM_RAW_CHUNK_SIZE;
+    }
+
+    prrte_filem_raw_window = PRRTE_FILEM_RAW_WINDOW;
+    (void) prrte_mca_base_component_var_register(c, "window",
+                                           "Maximum number of chunks of a file that may be in flight before every daemon has acknowledged receiving them",
+                                           PRRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           PRRTE_INFO_LVL_9,
+                                           PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                           &prrte_filem_raw_window);
+    if (prrte_filem_raw_window <= 0) {
+        prrte_filem_raw_window = 1;
+    }
+
+    prrte_filem_raw_report_throughput = false;
+    (void) prrte_mca_base_component_var_register(c, "report_throughput",
+                                           "Report the size, time and throughput of each file positioned on the daemons",
+                                           PRRTE_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                           PRRTE_INFO_LVL_9,
+                                           PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                           &prrte_filem_raw_report_throughput);
+
+    prrte_filem_raw_cache = true;
+    (void) prrte_mca_base_component_var_register(c, "cache",
+                                           "Identify positioned files by a digest of their contents so that files already held by the daemons are not sent again",
+                                           PRRTE_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                           PRRTE_INFO_LVL_9,
+                                           PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                           &prrte_filem_raw_cache);
+
+    prrte_filem_raw_stream_extract = true;
+    (void) prrte_mca_base_component_var_register(c, "stream_extract",
+                                           "Extract archives as they are received instead of after the entire archive has arrived",
+                                           PRRTE_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                           PRRTE_INFO_LVL_9,
+                                           PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                           &prrte_filem_raw_stream_extract);
+
     return PRRTE_SUCCESS;
 }
 
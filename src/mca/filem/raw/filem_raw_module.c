@@ -23,6 +23,7 @@
 #include <stdlib.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <errno.h>
 #ifdef HAVE_UNISTD_H
 #include <unistd.h>
 #endif  /* HAVE_UNISTD_H */
@@ -32,6 +33,9 @@
 #ifdef HAVE_FCNTL_H
 #include <fcntl.h>
 #endif
+#ifdef HAVE_SYS_WAIT_H
+#include <sys/wait.h>
+#endif
 
 #include "src/class/prrte_list.h"
 #include "src/event/event-internal.h"
@@ -45,6 +49,7 @@
 #include "src/util/os_path.h"
 #include "src/util/path.h"
 #include "src/util/basename.h"
+#include "src/util/crc.h"
 
 #include "src/util/name_fns.h"
 #include "src/util/proc_info.h"
@@ -97,6 +102,11 @@ static void recv_ack(int status, prrte_process_name_t* sender,
                      prrte_buffer_t* buffer, prrte_rml_tag_t tag,
                      void* cbdata);
 static void write_handler(int fd, short event, void *cbdata);
+static void recv_cached(char *file, prrte_buffer_t *buffer);
+static int resend_file(prrte_filem_raw_xfer_t *xfer);
+static void finish_incoming(prrte_filem_raw_incoming_t *sink);
+static int start_extract(prrte_filem_raw_incoming_t *inbnd);
+static int stop_extract(prrte_filem_raw_incoming_t *inbnd);
 
 static char *filem_session_dir(void)
 {
@@ -183,6 +193,60 @@ static void xfer_complete(int status, prrte_filem_raw_xfer_t *xfer)
     }
 }
 
+static void report_throughput(prrte_filem_raw_xfer_t *xfer)
+{
+    struct timeval now;
+    double secs, rate;
+
+    gettimeofday(&now, NULL);
+    secs = (double)(now.tv_sec - xfer->start.tv_sec) +
+           (double)(now.tv_usec - xfer->start.tv_usec) / 1000000.0;
+    rate = (0.0 < secs) ? ((double)xfer->nbytes / (1024.0 * 1024.0)) / secs : 0.0;
+
+    if (prrte_filem_raw_report_throughput) {
+        prrte_output(0, "%s filem:raw: positioned %s (%lu bytes in %d chunks) on %lu daemons in %.3f sec - %.2f MB/sec",
+                     PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), xfer->src,
+                     (unsigned long)xfer->nbytes, (int)xfer->nchunk,
+                     (unsigned long)xfer->nrecvd, secs, rate);
+    } else {
+        PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
+                             "%s filem:raw: positioned %s (%lu bytes in %d chunks) on %lu daemons in %.3f sec - %.2f MB/sec",
+                             PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), xfer->src,
+                             (unsigned long)xfer->nbytes, (int)xfer->nchunk,
+                             (unsigned long)xfer->nrecvd, secs, rate));
+    }
+}
+
+/* record that a daemon has taken delivery of a chunk, and
+ * resume sending the file if that opens up the window. A
+ * negative chunk just rechecks the window */
+static void ack_chunk(prrte_filem_raw_xfer_t *xfer, int32_t nchunk)
+{
+    if (NULL == xfer->acks) {
+        return;
+    }
+    if (0 <= nchunk) {
+        if (nchunk < xfer->nacked || xfer->nacked + prrte_filem_raw_window <= nchunk) {
+            PRRTE_ERROR_LOG(PRRTE_ERR_BAD_PARAM);
+            return;
+        }
+        xfer->acks[nchunk % prrte_filem_raw_window]++;
+    }
+    /* the daemons each ack in order, so a chunk is through once
+     * all of them have acked it */
+    while (xfer->nacked < xfer->nchunk &&
+           xfer->nackers <= xfer->acks[xfer->nacked % prrte_filem_raw_window]) {
+        xfer->acks[xfer->nacked % prrte_filem_raw_window] = 0;
+        xfer->nacked++;
+    }
+    if (!xfer->pending && 0 <= xfer->fd &&
+        xfer->nchunk - xfer->nacked < prrte_filem_raw_window) {
+        xfer->pending = true;
+        PRRTE_POST_OBJECT(xfer);
+        prrte_event_active(&xfer->ev, PRRTE_EV_WRITE, 1);
+    }
+}
+
 static void recv_ack(int status, prrte_process_name_t* sender,
                      prrte_buffer_t* buffer, prrte_rml_tag_t tag,
                      void* cbdata)
@@ -192,6 +256,7 @@ static void recv_ack(int status, prrte_process_name_t* sender,
     prrte_filem_raw_xfer_t *xfer;
     char *file;
     int st, n, rc;
+    int32_t nchunk;
 
     /* unpack the file */
     n=1;
@@ -204,13 +269,22 @@ static void recv_ack(int status, prrte_process_name_t* sender,
     n=1;
     if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &st, &n, PRRTE_INT))) {
         PRRTE_ERROR_LOG(rc);
+        free(file);
+        return;
+    }
+
+    /* unpack the chunk being acknowledged */
+    n=1;
+    if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &nchunk, &n, PRRTE_INT32))) {
+        PRRTE_ERROR_LOG(rc);
+        free(file);
         return;
     }
 
     PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
-                         "%s filem:raw: recvd ack from %s for file %s status %d",
+                         "%s filem:raw: recvd ack from %s for file %s chunk %d status %d",
                          PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
-                         PRRTE_NAME_PRINT(sender), file, st));
+                         PRRTE_NAME_PRINT(sender), file, nchunk, st));
 
     /* find the corresponding outbound object */
     for (item = prrte_list_get_first(&outbound_files);
@@ -222,18 +296,45 @@ static void recv_ack(int status, prrte_process_name_t* sender,
              itm = prrte_list_get_next(itm)) {
             xfer = (prrte_filem_raw_xfer_t*)itm;
             if (0 == strcmp(file, xfer->file)) {
-                /* if the status isn't success, record it */
-                if (0 != st) {
+                if (PRRTE_FILEM_RAW_DONE != nchunk) {
+                    /* the daemon has taken delivery of this chunk */
+                    ack_chunk(xfer, nchunk);
+                    free(file);
+                    return;
+                }
+                if (xfer->cached && PRRTE_ERR_NOT_FOUND == st) {
+                    /* this daemon has no copy - we will have to
+                     * send it the file after all */
+                    xfer->missed = true;
+                } else if (0 != st) {
+                    /* if the status isn't success, record it */
                     xfer->status = st;
+                    /* this daemon won't acknowledge any more chunks */
+                    if (0 < xfer->nackers) {
+                        xfer->nackers--;
+                    }
+                    ack_chunk(xfer, -1);
                 }
                 /* track number of respondents */
                 xfer->nrecvd++;
+                /* if some daemons couldn't position the file from
+                 * their cache, then send it to everyone once they
+                 * have all responded */
+                if (xfer->nrecvd == prrte_process_info.num_daemons &&
+                    xfer->missed && PRRTE_SUCCESS == xfer->status) {
+                    if (PRRTE_SUCCESS == resend_file(xfer)) {
+                        free(file);
+                        return;
+                    }
+                    xfer->status = PRRTE_ERR_FILE_OPEN_FAILURE;
+                }
                 /* if all daemons have responded, then this is complete */
                 if (xfer->nrecvd == prrte_process_info.num_daemons) {
                     PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
                                          "%s filem:raw: xfer complete for file %s status %d",
                                          PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
                                          file, xfer->status));
+                    report_throughput(xfer);
                     xfer_complete(xfer->status, xfer);
                 }
                 free(file);
@@ -241,6 +342,164 @@ static void recv_ack(int status, prrte_process_name_t* sender,
             }
         }
     }
+    free(file);
+}
+
+/* compute a digest of the contents of a file. The digest is only
+ * used to recognize files the daemons already hold, so a 64-bit
+ * FNV-1a hash, a CRC and the file size are sufficient */
+static int file_digest(const char *path, char **digest,
+                       time_t *mtime, off_t *size)
+{
+    struct stat sb;
+    prrte_list_item_t *itm, *itm2;
+    prrte_filem_raw_outbound_t *optr;
+    prrte_filem_raw_xfer_t *xptr;
+    unsigned char *buf;
+    uint64_t hash = 14695981039346656037ULL;
+    unsigned int crc = CRC_INITIAL_REGISTER;
+    ssize_t nbytes, n;
+    int fd;
+
+    if (0 != stat(path, &sb)) {
+        return PRRTE_ERR_FILE_OPEN_FAILURE;
+    }
+    *mtime = sb.st_mtime;
+    *size = sb.st_size;
+
+    /* if we already computed the digest for this version
+     * of the file, then reuse it */
+    for (itm = prrte_list_get_first(&positioned_files);
+         itm != prrte_list_get_end(&positioned_files);
+         itm = prrte_list_get_next(itm)) {
+        xptr = (prrte_filem_raw_xfer_t*)itm;
+        if (NULL != xptr->digest && 0 == strcmp(path, xptr->src) &&
+            xptr->mtime == sb.st_mtime && xptr->size == sb.st_size) {
+            *digest = strdup(xptr->digest);
+            return PRRTE_SUCCESS;
+        }
+    }
+    for (itm = prrte_list_get_first(&outbound_files);
+         itm != prrte_list_get_end(&outbound_files);
+         itm = prrte_list_get_next(itm)) {
+        optr = (prrte_filem_raw_outbound_t*)itm;
+        for (itm2 = prrte_list_get_first(&optr->xfers);
+             itm2 != prrte_list_get_end(&optr->xfers);
+             itm2 = prrte_list_get_next(itm2)) {
+            xptr = (prrte_filem_raw_xfer_t*)itm2;
+            if (NULL != xptr->digest && 0 == strcmp(path, xptr->src) &&
+                xptr->mtime == sb.st_mtime && xptr->size == sb.st_size) {
+                *digest = strdup(xptr->digest);
+                return PRRTE_SUCCESS;
+            }
+        }
+    }
+
+    if (0 > (fd = open(path, O_RDONLY))) {
+        return PRRTE_ERR_FILE_OPEN_FAILURE;
+    }
+    buf = (unsigned char*)malloc(prrte_filem_raw_chunk_size);
+    if (NULL == buf) {
+        close(fd);
+        return PRRTE_ERR_OUT_OF_RESOURCE;
+    }
+    while (0 != (nbytes = read(fd, buf, prrte_filem_raw_chunk_size))) {
+        if (nbytes < 0) {
+            if (EINTR == errno) {
+                continue;
+            }
+            free(buf);
+            close(fd);
+            return PRRTE_ERR_FILE_READ_FAILURE;
+        }
+        for (n=0; n < nbytes; n++) {
+            hash ^= buf[n];
+            hash *= 1099511628211ULL;
+        }
+        crc = prrte_uicrc_partial(buf, nbytes, crc);
+    }
+    free(buf);
+    close(fd);
+
+    prrte_asprintf(digest, "%lu-%016llx-%08x", (unsigned long)sb.st_size,
+                   (unsigned long long)hash, crc);
+    return PRRTE_SUCCESS;
+}
+
+/* tell the daemons to position a file from the copy they
+ * already hold under the same digest */
+static int send_cached(prrte_filem_raw_xfer_t *xfer)
+{
+    int rc;
+    int32_t nchunk = PRRTE_FILEM_RAW_CACHED;
+    prrte_buffer_t msg;
+    prrte_grpcomm_signature_t *sig;
+
+    PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
+                         "%s filem:raw: daemons hold digest %s - linking file %s",
+                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                         xfer->digest, xfer->file));
+
+    PRRTE_CONSTRUCT(&msg, prrte_buffer_t);
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(&msg, &xfer->file, 1, PRRTE_STRING))) {
+        PRRTE_ERROR_LOG(rc);
+        PRRTE_DESTRUCT(&msg);
+        return rc;
+    }
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(&msg, &nchunk, 1, PRRTE_INT32))) {
+        PRRTE_ERROR_LOG(rc);
+        PRRTE_DESTRUCT(&msg);
+        return rc;
+    }
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(&msg, &xfer->type, 1, PRRTE_INT32))) {
+        PRRTE_ERROR_LOG(rc);
+        PRRTE_DESTRUCT(&msg);
+        return rc;
+    }
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(&msg, &xfer->digest, 1, PRRTE_STRING))) {
+        PRRTE_ERROR_LOG(rc);
+        PRRTE_DESTRUCT(&msg);
+        return rc;
+    }
+
+    sig = PRRTE_NEW(prrte_grpcomm_signature_t);
+    sig->signature = (prrte_process_name_t*)malloc(sizeof(prrte_process_name_t));
+    sig->signature[0].jobid = PRRTE_PROC_MY_NAME->jobid;
+    sig->signature[0].vpid = PRRTE_VPID_WILDCARD;
+    sig->sz = 1;
+    rc = prrte_grpcomm.xcast(sig, PRRTE_RML_TAG_FILEM_BASE, &msg);
+    if (PRRTE_SUCCESS != rc) {
+        PRRTE_ERROR_LOG(rc);
+    }
+    PRRTE_DESTRUCT(&msg);
+    PRRTE_RELEASE(sig);
+    return rc;
+}
+
+/* some daemons didn't hold the contents we told them to
+ * position the file from, so send the file to everyone */
+static int resend_file(prrte_filem_raw_xfer_t *xfer)
+{
+    PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
+                         "%s filem:raw: cached copy of %s missing on some daemons - sending file",
+                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), xfer->file));
+
+    if (0 > (xfer->fd = open(xfer->src, O_RDONLY))) {
+        prrte_output(0, "%s CANNOT ACCESS FILE %s",
+                    PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), xfer->src);
+        return PRRTE_ERR_FILE_OPEN_FAILURE;
+    }
+    xfer->cached = false;
+    xfer->missed = false;
+    xfer->nrecvd = 0;
+    xfer->offset = 0;
+    xfer->nchunk = 0;
+    xfer->nacked = 0;
+    xfer->nackers = prrte_process_info.num_daemons;
+    xfer->pending = true;
+    PRRTE_POST_OBJECT(xfer);
+    prrte_event_active(&xfer->ev, PRRTE_EV_WRITE, 1);
+    return PRRTE_SUCCESS;
 }
 
 static int raw_preposition_files(prrte_job_t *jdata,
@@ -257,7 +516,10 @@ static int raw_preposition_files(prrte_job_t *jdata,
     prrte_filem_raw_outbound_t *outbound, *optr;
     char *cptr, *nxt, *filestring;
     prrte_list_t fsets;
-    bool already_sent;
+    bool already_sent, cached;
+    char *digest;
+    time_t mtime;
+    off_t size;
 
     PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
                          "%s filem:raw: preposition files for job %s",
@@ -427,6 +689,16 @@ static int raw_preposition_files(prrte_job_t *jdata,
                              PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
                              fs->local_target));
 
+        /* identify the contents of the file so we can recognize
+         * copies the daemons already hold. If we can't read it,
+         * then the open below will report the problem */
+        digest = NULL;
+        mtime = 0;
+        size = 0;
+        if (prrte_filem_raw_cache) {
+            (void)file_digest(fs->local_target, &digest, &mtime, &size);
+        }
+
         /* have we already sent this file? */
         already_sent = false;
         for (itm = prrte_list_get_first(&positioned_files);
@@ -434,7 +706,19 @@ static int raw_preposition_files(prrte_job_t *jdata,
              itm = prrte_list_get_next(itm)) {
             xptr = (prrte_filem_raw_xfer_t*)itm;
             if (0 == strcmp(fs->local_target, xptr->src)) {
-                already_sent = true;
+                if (NULL == digest || NULL == xptr->digest ||
+                    0 == strcmp(digest, xptr->digest)) {
+                    already_sent = true;
+                } else {
+                    /* the file was modified since we sent it, so
+                     * forget the stale copy and send it again */
+                    PRRTE_OUTPUT_VERBOSE((3, prrte_filem_base_framework.framework_output,
+                                         "%s filem:raw: file %s has changed - repositioning it",
+                                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), fs->local_target));
+                    prrte_list_remove_item(&positioned_files, itm);
+                    PRRTE_RELEASE(itm);
+                    break;
+                }
             }
         }
         if (already_sent) {
@@ -442,6 +726,9 @@ static int raw_preposition_files(prrte_job_t *jdata,
             PRRTE_OUTPUT_VERBOSE((3, prrte_filem_base_framework.framework_output,
                                  "%s filem:raw: file %s is already in position - ignoring",
                                  PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), fs->local_target));
+            if (NULL != digest) {
+                free(digest);
+            }
             PRRTE_RELEASE(item);
             continue;
         }
@@ -467,14 +754,36 @@ static int raw_preposition_files(prrte_job_t *jdata,
             PRRTE_OUTPUT_VERBOSE((3, prrte_filem_base_framework.framework_output,
                                  "%s filem:raw: file %s is already queued for output - ignoring",
                                  PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), fs->local_target));
+            if (NULL != digest) {
+                free(digest);
+            }
             PRRTE_RELEASE(item);
             continue;
         }
 
+        /* if the daemons already hold these contents under another
+         * name, then they can position the file from their copy */
+        cached = false;
+        if (NULL != digest) {
+            for (itm = prrte_list_get_first(&positioned_files);
+                 itm != prrte_list_get_end(&positioned_files);
+                 itm = prrte_list_get_next(itm)) {
+                xptr = (prrte_filem_raw_xfer_t*)itm;
+                if (NULL != xptr->digest && 0 == strcmp(digest, xptr->digest) &&
+                    PRRTE_SUCCESS == xptr->status) {
+                    cached = true;
+                    break;
+                }
+            }
+        }
+
         /* attempt to open the specified file */
         if (0 > (fd = open(fs->local_target, O_RDONLY))) {
             prrte_output(0, "%s CANNOT ACCESS FILE %s",
                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), fs->local_target);
+            if (NULL != digest) {
+                free(digest);
+            }
             PRRTE_RELEASE(item);
             prrte_list_remove_item(&outbound_files, &outbound->super);
             PRRTE_RELEASE(outbound);
@@ -536,12 +845,32 @@ static int raw_preposition_files(prrte_job_t *jdata,
         xfer->type = fs->target_flag;
         xfer->app_idx = fs->app_idx;
         xfer->outbound = outbound;
+        xfer->fd = fd;
+        xfer->digest = digest;
+        xfer->mtime = mtime;
+        xfer->size = size;
+        xfer->nackers = prrte_process_info.num_daemons;
+        gettimeofday(&xfer->start, NULL);
         prrte_list_append(&outbound->xfers, &xfer->super);
-        prrte_event_set(prrte_event_base, &xfer->ev, fd, PRRTE_EV_READ, send_chunk, xfer);
+        /* we read the file at an offset, so there is nothing to
+         * wait for - send_chunk just reactivates the event until
+         * the file has been sent */
+        prrte_event_set(prrte_event_base, &xfer->ev, -1, PRRTE_EV_WRITE, send_chunk, xfer);
         prrte_event_set_priority(&xfer->ev, PRRTE_MSG_PRI);
+        if (cached && PRRTE_SUCCESS == send_cached(xfer)) {
+            /* nothing to read - the acks from the daemons
+             * will complete the transfer as usual, or tell
+             * us to send the file after all. If we couldn't
+             * send the request, just send the file */
+            xfer->cached = true;
+            close(xfer->fd);
+            xfer->fd = -1;
+            PRRTE_RELEASE(item);
+            continue;
+        }
         xfer->pending = true;
         PRRTE_POST_OBJECT(xfer);
-        prrte_event_add(&xfer->ev, 0);
+        prrte_event_active(&xfer->ev, PRRTE_EV_WRITE, 1);
         PRRTE_RELEASE(item);
     }
     PRRTE_DESTRUCT(&fsets);
@@ -749,52 +1078,12 @@ static int raw_link_local_files(prrte_job_t *jdata,
     return PRRTE_SUCCESS;
 }
 
-static void send_chunk(int fd, short argc, void *cbdata)
+static int xcast_chunk(prrte_filem_raw_xfer_t *rev, int32_t numbytes)
 {
-    prrte_filem_raw_xfer_t *rev = (prrte_filem_raw_xfer_t*)cbdata;
-    unsigned char data[PRRTE_FILEM_RAW_CHUNK_MAX];
-    int32_t numbytes;
     int rc;
     prrte_buffer_t chunk;
     prrte_grpcomm_signature_t *sig;
 
-    PRRTE_ACQUIRE_OBJECT(rev);
-
-    /* flag that event has fired */
-    rev->pending = false;
-
-    /* read up to the fragment size */
-    numbytes = read(fd, data, sizeof(data));
-
-    if (numbytes < 0) {
-        /* either we have a connection error or it was a non-blocking read */
-
-        /* non-blocking, retry */
-        if (EAGAIN == errno || EINTR == errno) {
-            PRRTE_POST_OBJECT(rev);
-            prrte_event_add(&rev->ev, 0);
-            return;
-        }
-
-        PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
-                             "%s filem:raw:read error on file %s",
-                             PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), rev->file));
-
-        /* Un-recoverable error. Allow the code to flow as usual in order to
-         * to send the zero bytes message up the stream, and then close the
-         * file descriptor and delete the event.
-         */
-        numbytes = 0;
-    }
-
-    /* if job termination has been ordered, just ignore the
-     * data and delete the read event
-     */
-    if (prrte_job_term_ordered) {
-        PRRTE_RELEASE(rev);
-        return;
-    }
-
     PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
                          "%s filem:raw:read handler sending chunk %d of %d bytes for file %s",
                          PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
@@ -804,57 +1093,146 @@ static void send_chunk(int fd, short argc, void *cbdata)
     PRRTE_CONSTRUCT(&chunk, prrte_buffer_t);
     if (PRRTE_SUCCESS != (rc = prrte_dss.pack(&chunk, &rev->file, 1, PRRTE_STRING))) {
         PRRTE_ERROR_LOG(rc);
-        close(fd);
-        return;
+        PRRTE_DESTRUCT(&chunk);
+        return rc;
     }
     if (PRRTE_SUCCESS != (rc = prrte_dss.pack(&chunk, &rev->nchunk, 1, PRRTE_INT32))) {
         PRRTE_ERROR_LOG(rc);
-        close(fd);
-        return;
+        PRRTE_DESTRUCT(&chunk);
+        return rc;
     }
-    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(&chunk, data, numbytes, PRRTE_BYTE))) {
+    /* the chunk size is tunable, so tell the recipients how
+     * much data to expect */
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(&chunk, &numbytes, 1, PRRTE_INT32))) {
         PRRTE_ERROR_LOG(rc);
-        close(fd);
-        return;
+        PRRTE_DESTRUCT(&chunk);
+        return rc;
+    }
+    if (0 < numbytes) {
+        if (PRRTE_SUCCESS != (rc = prrte_dss.pack(&chunk, rev->buf, numbytes, PRRTE_BYTE))) {
+            PRRTE_ERROR_LOG(rc);
+            PRRTE_DESTRUCT(&chunk);
+            return rc;
+        }
     }
     /* if it is the first chunk, then add file type and index of the app */
     if (0 == rev->nchunk) {
         if (PRRTE_SUCCESS != (rc = prrte_dss.pack(&chunk, &rev->type, 1, PRRTE_INT32))) {
             PRRTE_ERROR_LOG(rc);
-            close(fd);
-            return;
+            PRRTE_DESTRUCT(&chunk);
+            return rc;
+        }
+        /* the digest lets the daemons reuse their copy later */
+        if (PRRTE_SUCCESS != (rc = prrte_dss.pack(&chunk, &rev->digest, 1, PRRTE_STRING))) {
+            PRRTE_ERROR_LOG(rc);
+            PRRTE_DESTRUCT(&chunk);
+            return rc;
         }
     }
 
-    /* goes to all daemons */
+    /* goes to all daemons - each daemon relays the chunk down the
+     * routing tree as soon as it arrives, so the transfer is
+     * pipelined across the tree */
     sig = PRRTE_NEW(prrte_grpcomm_signature_t);
     sig->signature = (prrte_process_name_t*)malloc(sizeof(prrte_process_name_t));
     sig->signature[0].jobid = PRRTE_PROC_MY_NAME->jobid;
     sig->signature[0].vpid = PRRTE_VPID_WILDCARD;
-    if (PRRTE_SUCCESS != (rc = prrte_grpcomm.xcast(sig, PRRTE_RML_TAG_FILEM_BASE, &chunk))) {
+    sig->sz = 1;
+    rc = prrte_grpcomm.xcast(sig, PRRTE_RML_TAG_FILEM_BASE, &chunk);
+    if (PRRTE_SUCCESS != rc) {
         PRRTE_ERROR_LOG(rc);
-        close(fd);
-        return;
     }
     PRRTE_DESTRUCT(&chunk);
     PRRTE_RELEASE(sig);
-    rev->nchunk++;
+    return rc;
+}
 
-    /* if num_bytes was zero, then we need to terminate the event
-     * and close the file descriptor
+static void send_chunk(int fd, short argc, void *cbdata)
+{
+    prrte_filem_raw_xfer_t *rev = (prrte_filem_raw_xfer_t*)cbdata;
+    ssize_t numbytes;
+
+    PRRTE_ACQUIRE_OBJECT(rev);
+
+    /* flag that event has fired */
+    rev->pending = false;
+
+    /* if job termination has been ordered, just stop
+     * sending the file
      */
-    if (0 == numbytes) {
-        close(fd);
+    if (prrte_job_term_ordered) {
+        close(rev->fd);
+        rev->fd = -1;
         return;
-    } else {
-        /* restart the read event */
+    }
+
+    if (NULL == rev->buf) {
+        rev->buf = (unsigned char*)malloc(prrte_filem_raw_chunk_size);
+        if (NULL == rev->acks) {
+            rev->acks = (prrte_vpid_t*)calloc(prrte_filem_raw_window, sizeof(prrte_vpid_t));
+        }
+        if (NULL == rev->buf || NULL == rev->acks) {
+            PRRTE_ERROR_LOG(PRRTE_ERR_OUT_OF_RESOURCE);
+            close(rev->fd);
+            rev->fd = -1;
+            return;
+        }
+    }
+
+    /* fill the window - chunks leave it as the daemons
+     * acknowledge them, and ack_chunk will restart us */
+    while (rev->nchunk - rev->nacked < prrte_filem_raw_window) {
+        numbytes = pread(rev->fd, rev->buf, prrte_filem_raw_chunk_size, rev->offset);
+        if (numbytes < 0) {
+            /* interrupted - try again on the next pass */
+            if (EAGAIN == errno || EINTR == errno) {
+                break;
+            }
+
+            PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
+                                 "%s filem:raw:read error on file %s",
+                                 PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), rev->file));
+
+            /* Un-recoverable error. Allow the code to flow as usual in order to
+             * to send the zero bytes message up the stream, and then close the
+             * file descriptor.
+             */
+            numbytes = 0;
+        }
+
+        if (PRRTE_SUCCESS != xcast_chunk(rev, (int32_t)numbytes)) {
+            close(rev->fd);
+            rev->fd = -1;
+            return;
+        }
+        rev->nchunk++;
+        rev->offset += numbytes;
+        rev->nbytes += numbytes;
+
+        /* if num_bytes was zero, then we are done with this
+         * file - close the file descriptor
+         */
+        if (0 == numbytes) {
+            close(rev->fd);
+            rev->fd = -1;
+            free(rev->buf);
+            rev->buf = NULL;
+            return;
+        }
+    }
+
+    if (rev->nchunk - rev->nacked < prrte_filem_raw_window) {
+        /* the read was interrupted - try again once the
+         * event loop has serviced other events */
         rev->pending = true;
         PRRTE_POST_OBJECT(rev);
-        prrte_event_add(&rev->ev, 0);
+        prrte_event_active(&rev->ev, PRRTE_EV_WRITE, 1);
     }
 }
 
-static void send_complete(char *file, int status)
+/* report to the HNP - either our delivery of a chunk of the
+ * file, or PRRTE_FILEM_RAW_DONE with the outcome for the file */
+static void send_resp(char *file, int32_t nchunk, int status)
 {
     prrte_buffer_t *buf;
     int rc;
@@ -870,6 +1248,11 @@ static void send_complete(char *file, int status)
         PRRTE_RELEASE(buf);
         return;
     }
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buf, &nchunk, 1, PRRTE_INT32))) {
+        PRRTE_ERROR_LOG(rc);
+        PRRTE_RELEASE(buf);
+        return;
+    }
     if (0 > (rc = prrte_rml.send_buffer_nb(PRRTE_PROC_MY_HNP, buf,
                                           PRRTE_RML_TAG_FILEM_BASE_RESP,
                                           prrte_rml_send_callback, NULL))) {
@@ -878,6 +1261,11 @@ static void send_complete(char *file, int status)
     }
 }
 
+static void send_complete(char *file, int status)
+{
+    send_resp(file, PRRTE_FILEM_RAW_DONE, status);
+}
+
 /* This is a little tricky as the name of the archive doesn't
  * necessarily have anything to do with the paths inside it -
  * so we have to first query the archive to retrieve that info
@@ -948,13 +1336,13 @@ static void recv_files(int status, prrte_process_name_t* sender,
 {
     char *file, *session_dir;
     int32_t nchunk, n, nbytes;
-    unsigned char data[PRRTE_FILEM_RAW_CHUNK_MAX];
+    unsigned char *data = NULL;
     int rc;
     prrte_filem_raw_output_t *output;
     prrte_filem_raw_incoming_t *ptr, *incoming;
     prrte_list_item_t *item;
     int32_t type;
-    char *cptr;
+    char *cptr, *digest = NULL;
 
     /* unpack the data */
     n=1;
@@ -970,18 +1358,43 @@ static void recv_files(int status, prrte_process_name_t* sender,
         free(file);
         return;
     }
+    /* the HNP may tell us to position the file from a copy we
+     * already hold */
+    if (PRRTE_FILEM_RAW_CACHED == nchunk) {
+        recv_cached(file, buffer);
+        free(file);
+        return;
+    }
     /* if the chunk number is < 0, then this is an EOF message */
     if (nchunk < 0) {
         /* just set nbytes to zero so we close the fd */
         nbytes = 0;
     } else {
-        nbytes=PRRTE_FILEM_RAW_CHUNK_MAX;
-        if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, data, &nbytes, PRRTE_BYTE))) {
+        n=1;
+        if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &nbytes, &n, PRRTE_INT32))) {
             PRRTE_ERROR_LOG(rc);
             send_complete(file, rc);
             free(file);
             return;
         }
+        if (0 < nbytes) {
+            /* unpack straight into the storage that will be
+             * handed to the write handler */
+            data = (unsigned char*)malloc(nbytes);
+            if (NULL == data) {
+                PRRTE_ERROR_LOG(PRRTE_ERR_OUT_OF_RESOURCE);
+                send_complete(file, PRRTE_ERR_OUT_OF_RESOURCE);
+                free(file);
+                return;
+            }
+            if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, data, &nbytes, PRRTE_BYTE))) {
+                PRRTE_ERROR_LOG(rc);
+                send_complete(file, rc);
+                free(data);
+                free(file);
+                return;
+            }
+        }
     }
     /* if the chunk is 0, then additional info should be present */
     if (0 == nchunk) {
@@ -989,6 +1402,19 @@ static void recv_files(int status, prrte_process_name_t* sender,
         if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &type, &n, PRRTE_INT32))) {
             PRRTE_ERROR_LOG(rc);
             send_complete(file, rc);
+            if (NULL != data) {
+                free(data);
+            }
+            free(file);
+            return;
+        }
+        n=1;
+        if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &digest, &n, PRRTE_STRING))) {
+            PRRTE_ERROR_LOG(rc);
+            send_complete(file, rc);
+            if (NULL != data) {
+                free(data);
+            }
             free(file);
             return;
         }
@@ -1025,6 +1451,21 @@ static void recv_files(int status, prrte_process_name_t* sender,
     if (0 == nchunk) {
         /* separate out the top-level directory of the target */
         char *tmp;
+        /* if we are receiving a new version of the file, then
+         * discard what we knew about the prior one */
+        incoming->type = type;
+        if (NULL != incoming->digest) {
+            free(incoming->digest);
+        }
+        incoming->digest = digest;
+        if (NULL != incoming->top) {
+            free(incoming->top);
+        }
+        if (NULL != incoming->fullpath) {
+            free(incoming->fullpath);
+        }
+        prrte_argv_free(incoming->link_pts);
+        incoming->link_pts = NULL;
         tmp = strdup(file);
         if (NULL != (cptr = strchr(tmp, '/'))) {
             *cptr = '\0';
@@ -1047,9 +1488,15 @@ static void recv_files(int status, prrte_process_name_t* sender,
             send_complete(file, PRRTE_ERR_FILE_WRITE_FAILURE);
             free(file);
             free(tmp);
+            if (NULL != data) {
+                free(data);
+            }
             PRRTE_RELEASE(incoming);
             return;
         }
+        /* remove any prior version of the file so we don't write
+         * thru a link into a cached copy of other contents */
+        unlink(incoming->fullpath);
         /* open the file descriptor for writing */
         if (PRRTE_FILEM_TYPE_EXE == type) {
             if (0 > (incoming->fd = open(incoming->fullpath, O_RDWR | O_CREAT | O_TRUNC, S_IRWXU))) {
@@ -1059,6 +1506,9 @@ static void recv_files(int status, prrte_process_name_t* sender,
                 send_complete(file, PRRTE_ERR_FILE_WRITE_FAILURE);
                 free(file);
                 free(tmp);
+                if (NULL != data) {
+                    free(data);
+                }
                 return;
             }
         } else {
@@ -1069,33 +1519,50 @@ static void recv_files(int status, prrte_process_name_t* sender,
                 send_complete(file, PRRTE_ERR_FILE_WRITE_FAILURE);
                 free(file);
                 free(tmp);
+                if (NULL != data) {
+                    free(data);
+                }
                 return;
             }
         }
         free(tmp);
+        /* epoll will not watch a regular file, and one is always
+         * writable anyway - so the write handler is activated directly
+         * rather than added */
         prrte_event_set(prrte_event_base, &incoming->ev, incoming->fd,
                        PRRTE_EV_WRITE, write_handler, incoming);
         prrte_event_set_priority(&incoming->ev, PRRTE_MSG_PRI);
+        /* archives can be extracted while the rest of the archive
+         * is still arriving - if we can't start the extractor, then
+         * we will just extract the archive once it is complete */
+        (void)stop_extract(incoming);
+        if (prrte_filem_raw_stream_extract &&
+            (PRRTE_FILEM_TYPE_TAR == type ||
+             PRRTE_FILEM_TYPE_BZIP == type ||
+             PRRTE_FILEM_TYPE_GZIP == type)) {
+            (void)start_extract(incoming);
+        }
     }
     /* create an output object for this data */
     output = PRRTE_NEW(prrte_filem_raw_output_t);
-    if (0 < nbytes) {
-        /* don't copy 0 bytes - we just need to pass
-         * the zero bytes so the fd can be closed
-         * after it writes everything out
-         */
-        memcpy(output->data, data, nbytes);
-    }
+    /* a zero-byte output just tells the write handler to
+     * close the fd after it writes everything out */
+    output->data = data;
     output->numbytes = nbytes;
 
     /* add this data to the write list for this fd */
     prrte_list_append(&incoming->outputs, &output->super);
 
+    /* let the HNP send more of the file */
+    if (0 < nbytes) {
+        send_resp(file, nchunk, PRRTE_SUCCESS);
+    }
+
     if (!incoming->pending) {
         /* add the event */
         incoming->pending = true;
         PRRTE_POST_OBJECT(incoming);
-        prrte_event_add(&incoming->ev, 0);
+        prrte_event_active(&incoming->ev, PRRTE_EV_WRITE, 1);
     }
 
     /* cleanup */
@@ -1103,15 +1570,388 @@ static void recv_files(int status, prrte_process_name_t* sender,
 }
 
 
+/* extract a completely received archive */
+static int extract_archive(prrte_filem_raw_incoming_t *sink)
+{
+    char *dirname, *cmd;
+    char homedir[MAXPATHLEN];
+    int rc;
+
+    if (PRRTE_FILEM_TYPE_TAR == sink->type) {
+        prrte_asprintf(&cmd, "tar xf %s", sink->file);
+    } else if (PRRTE_FILEM_TYPE_BZIP == sink->type) {
+        prrte_asprintf(&cmd, "tar xjf %s", sink->file);
+    } else if (PRRTE_FILEM_TYPE_GZIP == sink->type) {
+        prrte_asprintf(&cmd, "tar xzf %s", sink->file);
+    } else {
+        PRRTE_ERROR_LOG(PRRTE_ERR_BAD_PARAM);
+        return PRRTE_ERR_BAD_PARAM;
+    }
+    if (NULL == getcwd(homedir, sizeof(homedir))) {
+        PRRTE_ERROR_LOG(PRRTE_ERROR);
+        free(cmd);
+        return PRRTE_ERROR;
+    }
+    dirname = prrte_dirname(sink->fullpath);
+    if (0 != chdir(dirname)) {
+        PRRTE_ERROR_LOG(PRRTE_ERROR);
+        free(dirname);
+        free(cmd);
+        return PRRTE_ERROR;
+    }
+    free(dirname);
+    PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
+                         "%s write:handler unarchiving file %s with cmd: %s",
+                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                         sink->file, cmd));
+    rc = system(cmd);
+    free(cmd);
+    if (0 != rc) {
+        PRRTE_ERROR_LOG(PRRTE_ERROR);
+    }
+    if (0 != chdir(homedir)) {
+        PRRTE_ERROR_LOG(PRRTE_ERROR);
+        return PRRTE_ERROR;
+    }
+    return (0 == rc) ? PRRTE_SUCCESS : PRRTE_ERROR;
+}
+
+/* fork a tar process to extract an archive from a pipe so
+ * the archive can be unpacked while it is still arriving */
+static int start_extract(prrte_filem_raw_incoming_t *inbnd)
+{
+    int p[2], flags;
+    char *opt, *dirname;
+    pid_t pid;
+
+    if (PRRTE_FILEM_TYPE_TAR == inbnd->type) {
+        opt = "xf";
+    } else if (PRRTE_FILEM_TYPE_BZIP == inbnd->type) {
+        opt = "xjf";
+    } else if (PRRTE_FILEM_TYPE_GZIP == inbnd->type) {
+        opt = "xzf";
+    } else {
+        return PRRTE_ERR_BAD_PARAM;
+    }
+
+    if (0 != pipe(p)) {
+        return PRRTE_ERR_SYS_LIMITS_PIPES;
+    }
+    dirname = prrte_dirname(inbnd->fullpath);
+    pid = fork();
+    if (pid < 0) {
+        close(p[0]);
+        close(p[1]);
+        free(dirname);
+        return PRRTE_ERR_SYS_LIMITS_CHILDREN;
+    }
+    if (0 == pid) {
+        /* child - read the archive from stdin */
+        close(p[1]);
+        if (0 != chdir(dirname) || 0 > dup2(p[0], 0)) {
+            _exit(1);
+        }
+        close(p[0]);
+        execlp("tar", "tar", opt, "-", NULL);
+        _exit(127);
+    }
+    free(dirname);
+    close(p[0]);
+
+    /* we cannot block the event loop waiting on the
+     * extractor, so write to it in non-blocking mode */
+    if ((flags = fcntl(p[1], F_GETFL, 0)) >= 0) {
+        (void)fcntl(p[1], F_SETFL, flags | O_NONBLOCK);
+    }
+    (void)fcntl(p[1], F_SETFD, FD_CLOEXEC);
+    inbnd->xfd = p[1];
+    inbnd->xpid = pid;
+    prrte_event_set(prrte_event_base, &inbnd->xev, inbnd->xfd,
+                   PRRTE_EV_WRITE, write_handler, inbnd);
+    prrte_event_set_priority(&inbnd->xev, PRRTE_MSG_PRI);
+
+    PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
+                         "%s filem:raw: extracting archive %s as it arrives",
+                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), inbnd->file));
+    return PRRTE_SUCCESS;
+}
+
+/* close the pipe to the extractor and wait for it to finish
+ * whatever it still has to write out */
+static int stop_extract(prrte_filem_raw_incoming_t *inbnd)
+{
+    int status;
+    pid_t rc;
+
+    if (0 <= inbnd->xfd) {
+        prrte_event_del(&inbnd->xev);
+        close(inbnd->xfd);
+        inbnd->xfd = -1;
+    }
+    if (0 >= inbnd->xpid) {
+        return PRRTE_ERR_NOT_FOUND;
+    }
+    do {
+        rc = waitpid(inbnd->xpid, &status, 0);
+    } while (rc < 0 && EINTR == errno);
+    inbnd->xpid = -1;
+    if (rc < 0 || !WIFEXITED(status) || 0 != WEXITSTATUS(status)) {
+        PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
+                             "%s filem:raw: extraction of archive %s failed",
+                             PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), inbnd->file));
+        return PRRTE_ERROR;
+    }
+    return PRRTE_SUCCESS;
+}
+
+/* hand the data to the extractor - returns false if the
+ * pipe is full and we need to wait for it to drain */
+static bool pipe_output(prrte_filem_raw_incoming_t *sink,
+                        prrte_filem_raw_output_t *output)
+{
+    ssize_t n;
+
+    while (output->npiped < output->numbytes) {
+        n = write(sink->xfd, output->data + output->npiped,
+                  output->numbytes - output->npiped);
+        if (n < 0) {
+            if (EINTR == errno) {
+                continue;
+            }
+            if (EAGAIN == errno || EWOULDBLOCK == errno) {
+                return false;
+            }
+            /* the extractor died - we will extract the
+             * archive from the file once it arrives */
+            PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
+                                 "%s filem:raw: extractor for %s failed: %s",
+                                 PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                                 sink->file, strerror(errno)));
+            (void)stop_extract(sink);
+            return true;
+        }
+        output->npiped += n;
+    }
+    return true;
+}
+
+/* the file is in place - unpack it if required, identify the
+ * points we will link to, and tell the HNP we are done */
+static void finish_incoming(prrte_filem_raw_incoming_t *sink)
+{
+    int rc;
+
+    if (PRRTE_FILEM_TYPE_FILE == sink->type ||
+        PRRTE_FILEM_TYPE_EXE == sink->type) {
+        /* just link to the top as this will be the
+         * name we will want in each proc's session dir
+         */
+        prrte_argv_append_nosize(&sink->link_pts, sink->top);
+        send_complete(sink->file, PRRTE_SUCCESS);
+    } else {
+        /* if the archive was extracted as it arrived, then we only
+         * have to wait for the extractor to finish - otherwise (or
+         * if that failed), extract it now */
+        if (0 >= sink->xpid || PRRTE_SUCCESS != stop_extract(sink)) {
+            if (PRRTE_SUCCESS != (rc = extract_archive(sink))) {
+                send_complete(sink->file, PRRTE_ERR_FILE_WRITE_FAILURE);
+                return;
+            }
+        }
+        /* setup the link points */
+        if (PRRTE_SUCCESS != (rc = link_archive(sink))) {
+            PRRTE_ERROR_LOG(rc);
+            send_complete(sink->file, PRRTE_ERR_FILE_WRITE_FAILURE);
+        } else {
+            send_complete(sink->file, PRRTE_SUCCESS);
+        }
+    }
+}
+
+/* copy the contents of src into a new file dst */
+static int copy_file(const char *src, const char *dst)
+{
+    char buf[4096];
+    ssize_t nread, nwritten, off;
+    struct stat st;
+    int in, out, rc = PRRTE_SUCCESS;
+
+    if (0 > (in = open(src, O_RDONLY))) {
+        return PRRTE_ERR_NOT_FOUND;
+    }
+    if (0 != fstat(in, &st)) {
+        close(in);
+        return PRRTE_ERR_NOT_FOUND;
+    }
+    if (0 > (out = open(dst, O_WRONLY | O_CREAT | O_TRUNC, st.st_mode & 07777))) {
+        close(in);
+        return PRRTE_ERR_FILE_WRITE_FAILURE;
+    }
+    while (0 != (nread = read(in, buf, sizeof(buf)))) {
+        if (0 > nread) {
+            if (EINTR == errno) {
+                continue;
+            }
+            rc = PRRTE_ERR_FILE_READ_FAILURE;
+            break;
+        }
+        for (off=0; off < nread; off += nwritten) {
+            if (0 > (nwritten = write(out, buf + off, nread - off))) {
+                if (EINTR != errno) {
+                    rc = PRRTE_ERR_FILE_WRITE_FAILURE;
+                    break;
+                }
+                nwritten = 0;
+            }
+        }
+        if (PRRTE_SUCCESS != rc) {
+            break;
+        }
+    }
+    close(in);
+    if (0 != close(out) && PRRTE_SUCCESS == rc) {
+        rc = PRRTE_ERR_FILE_WRITE_FAILURE;
+    }
+    if (PRRTE_SUCCESS != rc) {
+        unlink(dst);
+    }
+    return rc;
+}
+
+/* position a file by linking to a copy of the same contents
+ * that we already hold under another name */
+static void recv_cached(char *file, prrte_buffer_t *buffer)
+{
+    int32_t type, n;
+    char *digest, *tmp, *cptr;
+    int rc;
+    prrte_list_item_t *item;
+    prrte_filem_raw_incoming_t *ptr, *cache, *incoming;
+
+    n=1;
+    if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &type, &n, PRRTE_INT32))) {
+        PRRTE_ERROR_LOG(rc);
+        send_complete(file, rc);
+        return;
+    }
+    n=1;
+    if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &digest, &n, PRRTE_STRING))) {
+        PRRTE_ERROR_LOG(rc);
+        send_complete(file, rc);
+        return;
+    }
+
+    /* find our copy of these contents, and any prior
+     * version of this file */
+    cache = NULL;
+    incoming = NULL;
+    for (item = prrte_list_get_first(&incoming_files);
+         item != prrte_list_get_end(&incoming_files);
+         item = prrte_list_get_next(item)) {
+        ptr = (prrte_filem_raw_incoming_t*)item;
+        if (NULL == cache && NULL != ptr->digest && 0 > ptr->fd &&
+            NULL != ptr->fullpath && 0 == strcmp(digest, ptr->digest)) {
+            cache = ptr;
+        }
+        if (0 == strcmp(file, ptr->file)) {
+            incoming = ptr;
+        }
+    }
+    if (cache == incoming && 0 != access(cache->fullpath, R_OK)) {
+        /* it was in place, but has since been removed */
+        free(cache->digest);
+        cache->digest = NULL;
+        cache = NULL;
+    }
+    if (NULL == cache) {
+        /* we don't have it - the HNP will have to send it */
+        PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
+                             "%s filem:raw: no cached copy of file %s",
+                             PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), file));
+        send_complete(file, PRRTE_ERR_NOT_FOUND);
+        free(digest);
+        return;
+    }
+    if (cache == incoming) {
+        /* already in place */
+        free(digest);
+        send_complete(file, PRRTE_SUCCESS);
+        return;
+    }
+
+    PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
+                         "%s filem:raw: positioning file %s from cached copy %s",
+                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), file, cache->fullpath));
+
+    if (NULL == incoming) {
+        incoming = PRRTE_NEW(prrte_filem_raw_incoming_t);
+        incoming->file = strdup(file);
+        prrte_list_append(&incoming_files, &incoming->super);
+    } else {
+        if (NULL != incoming->digest) {
+            free(incoming->digest);
+        }
+        if (NULL != incoming->top) {
+            free(incoming->top);
+        }
+        if (NULL != incoming->fullpath) {
+            free(incoming->fullpath);
+        }
+        prrte_argv_free(incoming->link_pts);
+        incoming->link_pts = NULL;
+    }
+    incoming->type = type;
+    incoming->digest = digest;
+    tmp = strdup(file);
+    if (NULL != (cptr = strchr(tmp, '/'))) {
+        *cptr = '\0';
+    }
+    incoming->top = tmp;
+    incoming->fullpath = prrte_os_path(false, filem_session_dir(), file, NULL);
+
+    tmp = prrte_dirname(incoming->fullpath);
+    if (PRRTE_SUCCESS != (rc = prrte_os_dirpath_create(tmp, S_IRWXU))) {
+        PRRTE_ERROR_LOG(rc);
+        free(tmp);
+        send_complete(file, PRRTE_ERR_FILE_WRITE_FAILURE);
+        return;
+    }
+    free(tmp);
+
+    /* the cached copy belongs to another job and may be removed
+     * along with it, so the new file must not depend on it. Prefer
+     * a hard link, and copy the contents if we can't link */
+    unlink(incoming->fullpath);
+    if (0 != link(cache->fullpath, incoming->fullpath) &&
+        PRRTE_SUCCESS != (rc = copy_file(cache->fullpath, incoming->fullpath))) {
+        if (PRRTE_ERR_NOT_FOUND == rc) {
+            /* our copy is gone - forget it and let the HNP
+             * send us the file */
+            PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
+                                 "%s filem:raw: cached copy %s of file %s is gone",
+                                 PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), cache->fullpath, file));
+            free(cache->digest);
+            cache->digest = NULL;
+        } else {
+            prrte_output(0, "%s CANNOT CREATE FILE %s",
+                        PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                        incoming->fullpath);
+        }
+        free(incoming->digest);
+        incoming->digest = NULL;
+        send_complete(file, rc);
+        return;
+    }
+
+    finish_incoming(incoming);
+}
+
 static void write_handler(int fd, short event, void *cbdata)
 {
     prrte_filem_raw_incoming_t *sink = (prrte_filem_raw_incoming_t*)cbdata;
     prrte_list_item_t *item;
     prrte_filem_raw_output_t *output;
     int num_written;
-    char *dirname, *cmd;
-    char homedir[MAXPATHLEN];
-    int rc;
 
     PRRTE_ACQUIRE_OBJECT(sink);
 
@@ -1134,64 +1974,19 @@ static void write_handler(int fd, short event, void *cbdata)
             /* close the file descriptor */
             close(sink->fd);
             sink->fd = -1;
-            if (PRRTE_FILEM_TYPE_FILE == sink->type ||
-                PRRTE_FILEM_TYPE_EXE == sink->type) {
-                /* just link to the top as this will be the
-                 * name we will want in each proc's session dir
-                 */
-                prrte_argv_append_nosize(&sink->link_pts, sink->top);
-                send_complete(sink->file, PRRTE_SUCCESS);
-            } else {
-                /* unarchive the file */
-                if (PRRTE_FILEM_TYPE_TAR == sink->type) {
-                    prrte_asprintf(&cmd, "tar xf %s", sink->file);
-                } else if (PRRTE_FILEM_TYPE_BZIP == sink->type) {
-                    prrte_asprintf(&cmd, "tar xjf %s", sink->file);
-                } else if (PRRTE_FILEM_TYPE_GZIP == sink->type) {
-                    prrte_asprintf(&cmd, "tar xzf %s", sink->file);
-                } else {
-                    PRRTE_ERROR_LOG(PRRTE_ERR_BAD_PARAM);
-                    send_complete(sink->file, PRRTE_ERR_FILE_WRITE_FAILURE);
-                    return;
-                }
-                if (NULL == getcwd(homedir, sizeof(homedir))) {
-                    PRRTE_ERROR_LOG(PRRTE_ERROR);
-                    send_complete(sink->file, PRRTE_ERR_FILE_WRITE_FAILURE);
-                    return;
-                }
-                dirname = prrte_dirname(sink->fullpath);
-                if (0 != chdir(dirname)) {
-                    PRRTE_ERROR_LOG(PRRTE_ERROR);
-                    send_complete(sink->file, PRRTE_ERR_FILE_WRITE_FAILURE);
-                    return;
-                }
-                PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
-                                     "%s write:handler unarchiving file %s with cmd: %s",
-                                     PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
-                                     sink->file, cmd));
-                if (0 != system(cmd)) {
-                    PRRTE_ERROR_LOG(PRRTE_ERROR);
-                    send_complete(sink->file, PRRTE_ERR_FILE_WRITE_FAILURE);
-                    return;
-                }
-                if (0 != chdir(homedir)) {
-                    PRRTE_ERROR_LOG(PRRTE_ERROR);
-                    send_complete(sink->file, PRRTE_ERR_FILE_WRITE_FAILURE);
-                    return;
-                }
-                free(dirname);
-                free(cmd);
-                /* setup the link points */
-                if (PRRTE_SUCCESS != (rc = link_archive(sink))) {
-                    PRRTE_ERROR_LOG(rc);
-                    send_complete(sink->file, PRRTE_ERR_FILE_WRITE_FAILURE);
-                } else {
-                    send_complete(sink->file, PRRTE_SUCCESS);
-                }
-            }
+            finish_incoming(sink);
+            return;
+        }
+        if (0 <= sink->xfd && !pipe_output(sink, output)) {
+            /* wait for the extractor to catch up */
+            prrte_list_prepend(&sink->outputs, item);
+            sink->pending = true;
+            PRRTE_POST_OBJECT(sink);
+            prrte_event_add(&sink->xev, 0);
             return;
         }
-        num_written = write(sink->fd, output->data, output->numbytes);
+        num_written = write(sink->fd, output->data + output->nwritten,
+                            output->numbytes - output->nwritten);
         PRRTE_OUTPUT_VERBOSE((1, prrte_filem_base_framework.framework_output,
                              "%s write:handler wrote %d bytes to file %s",
                              PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
@@ -1200,12 +1995,10 @@ static void write_handler(int fd, short event, void *cbdata)
             if (EAGAIN == errno || EINTR == errno) {
                 /* push this item back on the front of the list */
                 prrte_list_prepend(&sink->outputs, item);
-                /* leave the write event running so it will call us again
-                 * when the fd is ready.
-                 */
+                /* try again on the next pass of the event loop */
                 sink->pending = true;
                 PRRTE_POST_OBJECT(sink);
-                prrte_event_add(&sink->ev, 0);
+                prrte_event_active(&sink->ev, PRRTE_EV_WRITE, 1);
                 return;
             }
             /* otherwise, something bad happened so all we can do is abort
@@ -1220,17 +2013,15 @@ static void write_handler(int fd, short event, void *cbdata)
             send_complete(sink->file, PRRTE_ERR_FILE_WRITE_FAILURE);
             PRRTE_RELEASE(sink);
             return;
-        } else if (num_written < output->numbytes) {
-            /* incomplete write - adjust data to avoid duplicate output */
-            memmove(output->data, &output->data[num_written], output->numbytes - num_written);
+        } else if (num_written < output->numbytes - output->nwritten) {
+            /* incomplete write - track what was written to avoid duplicate output */
+            output->nwritten += num_written;
             /* push this item back on the front of the list */
             prrte_list_prepend(&sink->outputs, item);
-            /* leave the write event running so it will call us again
-             * when the fd is ready
-             */
+            /* write the rest on the next pass of the event loop */
             sink->pending = true;
             PRRTE_POST_OBJECT(sink);
-            prrte_event_add(&sink->ev, 0);
+            prrte_event_active(&sink->ev, PRRTE_EV_WRITE, 1);
             return;
         }
         PRRTE_RELEASE(output);
@@ -1247,6 +2038,18 @@ static void xfer_construct(prrte_filem_raw_xfer_t *ptr)
     ptr->nchunk = 0;
     ptr->status = PRRTE_SUCCESS;
     ptr->nrecvd = 0;
+    ptr->fd = -1;
+    ptr->offset = 0;
+    ptr->buf = NULL;
+    ptr->nacked = 0;
+    ptr->nackers = 0;
+    ptr->acks = NULL;
+    ptr->cached = false;
+    ptr->missed = false;
+    ptr->nbytes = 0;
+    ptr->digest = NULL;
+    ptr->mtime = 0;
+    ptr->size = 0;
 }
 static void xfer_destruct(prrte_filem_raw_xfer_t *ptr)
 {
@@ -1259,6 +2062,18 @@ static void xfer_destruct(prrte_filem_raw_xfer_t *ptr)
     if (NULL != ptr->file) {
         free(ptr->file);
     }
+    if (0 <= ptr->fd) {
+        close(ptr->fd);
+    }
+    if (NULL != ptr->buf) {
+        free(ptr->buf);
+    }
+    if (NULL != ptr->acks) {
+        free(ptr->acks);
+    }
+    if (NULL != ptr->digest) {
+        free(ptr->digest);
+    }
 }
 PRRTE_CLASS_INSTANCE(prrte_filem_raw_xfer_t,
                    prrte_list_item_t,
@@ -1293,6 +2108,9 @@ static void in_construct(prrte_filem_raw_incoming_t *ptr)
     ptr->top = NULL;
     ptr->fullpath = NULL;
     ptr->link_pts = NULL;
+    ptr->digest = NULL;
+    ptr->xfd = -1;
+    ptr->xpid = -1;
     PRRTE_CONSTRUCT(&ptr->outputs, prrte_list_t);
 }
 static void in_destruct(prrte_filem_raw_incoming_t *ptr)
@@ -1305,6 +2123,7 @@ static void in_destruct(prrte_filem_raw_incoming_t *ptr)
     if (0 <= ptr->fd) {
         close(ptr->fd);
     }
+    (void)stop_extract(ptr);
     if (NULL != ptr->file) {
         free(ptr->file);
     }
@@ -1315,6 +2134,9 @@ static void in_destruct(prrte_filem_raw_incoming_t *ptr)
         free(ptr->fullpath);
     }
     prrte_argv_free(ptr->link_pts);
+    if (NULL != ptr->digest) {
+        free(ptr->digest);
+    }
     while (NULL != (item = prrte_list_remove_first(&ptr->outputs))) {
         PRRTE_RELEASE(item);
     }
@@ -1327,7 +2149,16 @@ PRRTE_CLASS_INSTANCE(prrte_filem_raw_incoming_t,
 static void output_construct(prrte_filem_raw_output_t *ptr)
 {
     ptr->numbytes = 0;
+    ptr->nwritten = 0;
+    ptr->npiped = 0;
+    ptr->data = NULL;
+}
+static void output_destruct(prrte_filem_raw_output_t *ptr)
+{
+    if (NULL != ptr->data) {
+        free(ptr->data);
+    }
 }
 PRRTE_CLASS_INSTANCE(prrte_filem_raw_output_t,
                    prrte_list_item_t,
-                   output_construct, NULL);
+                   output_construct, output_destruct);
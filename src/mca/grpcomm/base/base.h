@@ -72,6 +72,11 @@ PRRTE_CLASS_DECLARATION(prrte_grpcomm_base_active_t);
 typedef struct {
     prrte_list_t actives;
     prrte_list_t ongoing;
+    /* index of ongoing trackers by signature digest */
+    prrte_hash_table_t coll_index;
+    /* number of ongoing trackers whose digest collided
+     * with one already in the index */
+    size_t ncollisions;
     prrte_hash_table_t sig_table;
     char *transports;
     size_t context_id;
@@ -90,6 +95,8 @@ PRRTE_EXPORT int prrte_grpcomm_API_allgather(prrte_grpcomm_signature_t *sig,
                                              void *cbdata);
 
 PRRTE_EXPORT prrte_grpcomm_coll_t* prrte_grpcomm_base_get_tracker(prrte_grpcomm_signature_t *sig, bool create);
+PRRTE_EXPORT void prrte_grpcomm_base_remove_tracker(prrte_grpcomm_coll_t *coll);
+PRRTE_EXPORT uint64_t prrte_grpcomm_base_sig_hash(prrte_grpcomm_signature_t *sig);
 PRRTE_EXPORT void prrte_grpcomm_base_mark_distance_recv(prrte_grpcomm_coll_t *coll, uint32_t distance);
 PRRTE_EXPORT unsigned int prrte_grpcomm_base_check_distance_recv(prrte_grpcomm_coll_t *coll, uint32_t distance);
 
@@ -89,6 +89,7 @@ static int prrte_grpcomm_base_close(void)
     }
     PRRTE_LIST_DESTRUCT(&prrte_grpcomm_base.actives);
     PRRTE_LIST_DESTRUCT(&prrte_grpcomm_base.ongoing);
+    PRRTE_DESTRUCT(&prrte_grpcomm_base.coll_index);
     for (void *_nptr=NULL;                                   \
          PRRTE_SUCCESS == prrte_hash_table_get_next_key_ptr(&prrte_grpcomm_base.sig_table, &key, &size, (void **)&seq_number, _nptr, &_nptr);) {
         free(seq_number);
@@ -106,6 +107,9 @@ static int prrte_grpcomm_base_open(prrte_mca_base_open_flag_t flags)
 {
     PRRTE_CONSTRUCT(&prrte_grpcomm_base.actives, prrte_list_t);
     PRRTE_CONSTRUCT(&prrte_grpcomm_base.ongoing, prrte_list_t);
+    PRRTE_CONSTRUCT(&prrte_grpcomm_base.coll_index, prrte_hash_table_t);
+    prrte_hash_table_init(&prrte_grpcomm_base.coll_index, 128);
+    prrte_grpcomm_base.ncollisions = 0;
     PRRTE_CONSTRUCT(&prrte_grpcomm_base.sig_table, prrte_hash_table_t);
     prrte_hash_table_init(&prrte_grpcomm_base.sig_table, 128);
 
@@ -139,6 +143,7 @@ PRRTE_CLASS_INSTANCE(prrte_grpcomm_signature_t,
 static void ccon(prrte_grpcomm_coll_t *p)
 {
     p->sig = NULL;
+    p->sighash = 0;
     PRRTE_CONSTRUCT(&p->bucket, prrte_buffer_t);
     PRRTE_CONSTRUCT(&p->distance_mask_recv, prrte_bitmap_t);
     p->dmns = NULL;
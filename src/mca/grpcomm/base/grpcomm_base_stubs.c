@@ -227,32 +227,71 @@ int prrte_grpcomm_API_allgather(prrte_grpcomm_signature_t *sig,
     return PRRTE_SUCCESS;
 }
 
+/* compute a 64-bit FNV-1a digest of a signature. A NULL
+ * signature hashes to the offset basis */
+uint64_t prrte_grpcomm_base_sig_hash(prrte_grpcomm_signature_t *sig)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    const uint8_t *ptr;
+    size_t n, len;
+
+    if (NULL == sig->signature) {
+        return hash;
+    }
+    ptr = (const uint8_t*)sig->signature;
+    len = sig->sz * sizeof(prrte_process_name_t);
+    for (n=0; n < len; n++) {
+        hash ^= ptr[n];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static bool sig_match(prrte_grpcomm_signature_t *sig, prrte_grpcomm_coll_t *coll)
+{
+    if (NULL == sig->signature || NULL == coll->sig->signature) {
+        /* only one collective can operate at a time
+         * across every process in the system */
+        return (sig->signature == coll->sig->signature);
+    }
+    return (PRRTE_EQUAL == prrte_dss.compare(sig, coll->sig, PRRTE_SIGNATURE));
+}
+
 prrte_grpcomm_coll_t* prrte_grpcomm_base_get_tracker(prrte_grpcomm_signature_t *sig, bool create)
 {
     prrte_grpcomm_coll_t *coll;
+    void *ptr;
     int rc;
     prrte_namelist_t *nm;
     prrte_list_t children;
     size_t n;
-
-    /* search the existing tracker list to see if this already exists */
-    PRRTE_LIST_FOREACH(coll, &prrte_grpcomm_base.ongoing, prrte_grpcomm_coll_t) {
-        if (NULL == sig->signature) {
-            if (NULL == coll->sig->signature) {
-                /* only one collective can operate at a time
-                 * across every process in the system */
-                return coll;
-            }
-            /* if only one is NULL, then we can't possibly match */
-            break;
-        }
-        if (PRRTE_EQUAL == (rc = prrte_dss.compare(sig, coll->sig, PRRTE_SIGNATURE))) {
+    uint64_t hash;
+
+    /* look the signature up in the index - we only need a
+     * full comparison against the tracker stored there */
+    hash = prrte_grpcomm_base_sig_hash(sig);
+    if (PRRTE_SUCCESS == prrte_hash_table_get_value_uint64(&prrte_grpcomm_base.coll_index,
+                                                           hash, &ptr)) {
+        coll = (prrte_grpcomm_coll_t*)ptr;
+        if (sig_match(sig, coll)) {
             PRRTE_OUTPUT_VERBOSE((1, prrte_grpcomm_base_framework.framework_output,
                                  "%s grpcomm:base:returning existing collective",
                                  PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME)));
             return coll;
         }
     }
+    /* trackers whose digest collided with an indexed one are
+     * only on the ongoing list, so search it if there are any */
+    if (0 < prrte_grpcomm_base.ncollisions) {
+        PRRTE_LIST_FOREACH(coll, &prrte_grpcomm_base.ongoing, prrte_grpcomm_coll_t) {
+            if (hash == coll->sighash && sig_match(sig, coll)) {
+                PRRTE_OUTPUT_VERBOSE((1, prrte_grpcomm_base_framework.framework_output,
+                                     "%s grpcomm:base:returning existing collective",
+                                     PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME)));
+                return coll;
+            }
+        }
+    }
     /* if we get here, then this is a new collective - so create
      * the tracker for it */
     if (!create) {
@@ -264,6 +303,7 @@ prrte_grpcomm_coll_t* prrte_grpcomm_base_get_tracker(prrte_grpcomm_signature_t *
     }
     coll = PRRTE_NEW(prrte_grpcomm_coll_t);
     prrte_dss.copy((void **)&coll->sig, (void *)sig, PRRTE_SIGNATURE);
+    coll->sighash = hash;
 
     if (1 < prrte_output_get_verbosity(prrte_grpcomm_base_framework.framework_output)) {
         char *tmp=NULL;
@@ -274,6 +314,13 @@ prrte_grpcomm_coll_t* prrte_grpcomm_base_get_tracker(prrte_grpcomm_signature_t *
     }
 
     prrte_list_append(&prrte_grpcomm_base.ongoing, &coll->super);
+    if (PRRTE_SUCCESS == prrte_hash_table_get_value_uint64(&prrte_grpcomm_base.coll_index,
+                                                           hash, &ptr)) {
+        /* digest collision - leave this one out of the index */
+        prrte_grpcomm_base.ncollisions++;
+    } else {
+        prrte_hash_table_set_value_uint64(&prrte_grpcomm_base.coll_index, hash, coll);
+    }
 
     /* now get the daemons involved */
     if (PRRTE_SUCCESS != (rc = create_dmns(sig, &coll->dmns, &coll->ndmns))) {
@@ -310,6 +357,20 @@ prrte_grpcomm_coll_t* prrte_grpcomm_base_get_tracker(prrte_grpcomm_signature_t *
     return coll;
 }
 
+void prrte_grpcomm_base_remove_tracker(prrte_grpcomm_coll_t *coll)
+{
+    void *ptr;
+
+    prrte_list_remove_item(&prrte_grpcomm_base.ongoing, &coll->super);
+    if (PRRTE_SUCCESS == prrte_hash_table_get_value_uint64(&prrte_grpcomm_base.coll_index,
+                                                           coll->sighash, &ptr) &&
+        ptr == (void*)coll) {
+        prrte_hash_table_remove_value_uint64(&prrte_grpcomm_base.coll_index, coll->sighash);
+    } else {
+        prrte_grpcomm_base.ncollisions--;
+    }
+}
+
 static int create_dmns(prrte_grpcomm_signature_t *sig,
                        prrte_vpid_t **dmns, size_t *ndmns)
 {
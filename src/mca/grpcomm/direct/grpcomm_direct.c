@@ -297,9 +297,8 @@ static void xcast_recv(int status, prrte_process_name_t* sender,
     prrte_list_item_t *item;
     prrte_namelist_t *nm;
     int ret, cnt;
-    prrte_buffer_t *relay=NULL, *rly;
+    prrte_buffer_t *rly, *data;
     prrte_daemon_cmd_flag_t command = PRRTE_DAEMON_NULL_CMD;
-    prrte_buffer_t datbuf, *data;
     int8_t flag;
     prrte_job_t *jdata;
     prrte_proc_t *rec;
@@ -308,6 +307,8 @@ static void xcast_recv(int status, prrte_process_name_t* sender,
     prrte_rml_tag_t tag;
     size_t inlen, cmplen;
     uint8_t *packed_data, *cmpdata;
+    void *payload;
+    int32_t nbytes;
 
     PRRTE_OUTPUT_VERBOSE((1, prrte_grpcomm_base_framework.framework_output,
                          "%s grpcomm:direct:xcast:recv: with %d bytes",
@@ -315,19 +316,22 @@ static void xcast_recv(int status, prrte_process_name_t* sender,
                          (int)buffer->bytes_used));
 
     /* we need a passthru buffer to send to our children - we leave it
-     * as compressed data */
+     * as compressed data. Nothing has been unpacked yet, so we can
+     * simply take ownership of the received bytes. The resulting
+     * object is shared by every relay send and, if the payload
+     * wasn't compressed, by our own local delivery as well */
     rly = PRRTE_NEW(prrte_buffer_t);
-    prrte_dss.copy_payload(rly, buffer);
-    PRRTE_CONSTRUCT(&datbuf, prrte_buffer_t);
+    prrte_dss.unload(buffer, &payload, &nbytes);
+    prrte_dss.load(rly, payload, nbytes);
+    data = NULL;
     /* setup the relay list */
     PRRTE_CONSTRUCT(&coll, prrte_list_t);
 
     /* unpack the flag to see if this payload is compressed */
     cnt=1;
-    if (PRRTE_SUCCESS != (ret = prrte_dss.unpack(buffer, &flag, &cnt, PRRTE_INT8))) {
+    if (PRRTE_SUCCESS != (ret = prrte_dss.unpack(rly, &flag, &cnt, PRRTE_INT8))) {
         PRRTE_ERROR_LOG(ret);
         PRRTE_FORCED_TERMINATE(ret);
-        PRRTE_DESTRUCT(&datbuf);
         PRRTE_DESTRUCT(&coll);
         PRRTE_RELEASE(rly);
         return;
@@ -335,20 +339,18 @@ static void xcast_recv(int status, prrte_process_name_t* sender,
     if (flag) {
         /* unpack the data size */
         cnt=1;
-        if (PRRTE_SUCCESS != (ret = prrte_dss.unpack(buffer, &inlen, &cnt, PRRTE_SIZE))) {
+        if (PRRTE_SUCCESS != (ret = prrte_dss.unpack(rly, &inlen, &cnt, PRRTE_SIZE))) {
             PRRTE_ERROR_LOG(ret);
             PRRTE_FORCED_TERMINATE(ret);
-            PRRTE_DESTRUCT(&datbuf);
             PRRTE_DESTRUCT(&coll);
             PRRTE_RELEASE(rly);
             return;
         }
         /* unpack the unpacked data size */
         cnt=1;
-        if (PRRTE_SUCCESS != (ret = prrte_dss.unpack(buffer, &cmplen, &cnt, PRRTE_SIZE))) {
+        if (PRRTE_SUCCESS != (ret = prrte_dss.unpack(rly, &cmplen, &cnt, PRRTE_SIZE))) {
             PRRTE_ERROR_LOG(ret);
             PRRTE_FORCED_TERMINATE(ret);
-            PRRTE_DESTRUCT(&datbuf);
             PRRTE_DESTRUCT(&coll);
             PRRTE_RELEASE(rly);
             return;
@@ -357,11 +359,10 @@ static void xcast_recv(int status, prrte_process_name_t* sender,
         packed_data = (uint8_t*)malloc(inlen);
         /* unpack the data blob */
         cnt = inlen;
-        if (PRRTE_SUCCESS != (ret = prrte_dss.unpack(buffer, packed_data, &cnt, PRRTE_UINT8))) {
+        if (PRRTE_SUCCESS != (ret = prrte_dss.unpack(rly, packed_data, &cnt, PRRTE_UINT8))) {
             PRRTE_ERROR_LOG(ret);
             free(packed_data);
             PRRTE_FORCED_TERMINATE(ret);
-            PRRTE_DESTRUCT(&datbuf);
             PRRTE_DESTRUCT(&coll);
             PRRTE_RELEASE(rly);
             return;
@@ -370,21 +371,21 @@ static void xcast_recv(int status, prrte_process_name_t* sender,
         if (prrte_compress.decompress_block(&cmpdata, cmplen,
                                        packed_data, inlen)) {
             /* the data has been uncompressed */
-            prrte_dss.load(&datbuf, cmpdata, cmplen);
-            data = &datbuf;
-        } else {
-            data = buffer;
+            data = PRRTE_NEW(prrte_buffer_t);
+            prrte_dss.load(data, cmpdata, cmplen);
         }
         free(packed_data);
-    } else {
-        data = buffer;
+    }
+    if (NULL == data) {
+        data = rly;
+        PRRTE_RETAIN(data);
     }
 
     /* get the signature that we do not need */
     cnt=1;
     if (PRRTE_SUCCESS != (ret = prrte_dss.unpack(data, &sig, &cnt, PRRTE_SIGNATURE))) {
         PRRTE_ERROR_LOG(ret);
-        PRRTE_DESTRUCT(&datbuf);
+        PRRTE_RELEASE(data);
         PRRTE_DESTRUCT(&coll);
         PRRTE_RELEASE(rly);
         PRRTE_FORCED_TERMINATE(ret);
@@ -396,16 +397,14 @@ static void xcast_recv(int status, prrte_process_name_t* sender,
     cnt=1;
     if (PRRTE_SUCCESS != (ret = prrte_dss.unpack(data, &tag, &cnt, PRRTE_RML_TAG))) {
         PRRTE_ERROR_LOG(ret);
-        PRRTE_DESTRUCT(&datbuf);
+        PRRTE_RELEASE(data);
         PRRTE_DESTRUCT(&coll);
         PRRTE_RELEASE(rly);
         PRRTE_FORCED_TERMINATE(ret);
         return;
     }
 
-    /* copy the msg for relay to ourselves */
-    relay = PRRTE_NEW(prrte_buffer_t);
-    prrte_dss.copy_payload(relay, data);
+    /* the remainder of data is now the msg for relay to ourselves */
 
     if (!prrte_do_not_launch) {
         /* get the list of next recipients from the routed module */
@@ -472,20 +471,15 @@ static void xcast_recv(int status, prrte_process_name_t* sender,
     PRRTE_LIST_DESTRUCT(&coll);
     PRRTE_RELEASE(rly);  // retain accounting
 
-    /* now pass the relay buffer to myself for processing - don't
+    /* now pass the remaining data to myself for processing - don't
      * inject it into the RML system via send as that will compete
      * with the relay messages down in the OOB. Instead, pass it
-     * directly to the RML message processor */
+     * directly to the RML message processor. The buffer is handed
+     * over by reference, positioned at the start of the payload */
     if (PRRTE_DAEMON_DVM_NIDMAP_CMD != command) {
-        PRRTE_RML_POST_MESSAGE(PRRTE_PROC_MY_NAME, tag, 1,
-                              relay->base_ptr, relay->bytes_used);
-        relay->base_ptr = NULL;
-        relay->bytes_used = 0;
-    }
-    if (NULL != relay) {
-        PRRTE_RELEASE(relay);
+        PRRTE_RML_POST_BUFFER(PRRTE_PROC_MY_NAME, tag, 1, data);
     }
-    PRRTE_DESTRUCT(&datbuf);
+    PRRTE_RELEASE(data);
 }
 
 static void barrier_release(int status, prrte_process_name_t* sender,
@@ -534,7 +528,7 @@ static void barrier_release(int status, prrte_process_name_t* sender,
     if (NULL != coll->cbfunc) {
         coll->cbfunc(ret, buffer, coll->cbdata);
     }
-    prrte_list_remove_item(&prrte_grpcomm_base.ongoing, &coll->super);
+    prrte_grpcomm_base_remove_tracker(coll);
     PRRTE_RELEASE(coll);
     PRRTE_RELEASE(sig);
 }
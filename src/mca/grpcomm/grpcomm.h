@@ -71,6 +71,8 @@ typedef struct {
     prrte_list_item_t super;
     /* collective's signature */
     prrte_grpcomm_signature_t *sig;
+    /* digest of the signature used to index the tracker */
+    uint64_t sighash;
     /* collection bucket */
     prrte_buffer_t bucket;
     /* participating daemons */
@@ -0,0 +1,477 @@
+/* -*- Mode: C; c-basic-offset:4 ; -*- */
+/*
+ * Copyright (c) 2020      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Recursive-doubling allgather between daemons.
+ *
+ * The participating daemons are ordered by vpid and assigned a rank.
+ * Let pof2 be the largest power of two not exceeding the number of
+ * participants. Each step of the algorithm is identified by an index
+ * that is carried in the message and used to mark the distance_mask_recv
+ * bitmap and the buffers array of the collective tracker:
+ *
+ *   index 0         - "fold-in": a rank r >= pof2 sends its contribution
+ *                     to rank r - pof2 before the exchange begins
+ *   index 1..log2   - rank r < pof2 exchanges everything collected so
+ *                     far with rank r ^ 2^(index-1)
+ *   index log2+1    - "release": rank r < (n - pof2) returns the
+ *                     complete result to rank r + pof2
+ *
+ * Each daemon therefore sends and receives at most log2(n)+1 messages
+ * for the collective, and no daemon (including the HNP) is required to
+ * aggregate and relay the contributions of all the others.
+ */
+
+#include "prrte_config.h"
+#include "constants.h"
+#include "types.h"
+
+#include <string.h>
+
+#include "src/dss/dss.h"
+#include "src/class/prrte_list.h"
+
+#include "src/mca/errmgr/errmgr.h"
+#include "src/mca/rml/base/base.h"
+#include "src/util/name_fns.h"
+#include "src/util/proc_info.h"
+
+#include "src/mca/grpcomm/base/base.h"
+#include "grpcomm_rcd.h"
+
+
+/* Static API's */
+static int init(void);
+static void finalize(void);
+static int allgather(prrte_grpcomm_coll_t *coll,
+                     prrte_buffer_t *buf, int mode);
+
+/* Module def */
+prrte_grpcomm_base_module_t prrte_grpcomm_rcd_module = {
+    init,
+    finalize,
+    NULL,
+    allgather
+};
+
+/* internal functions */
+static void rcd_allgather_recv(int status, prrte_process_name_t* sender,
+                               prrte_buffer_t* buffer, prrte_rml_tag_t tag,
+                               void* cbdata);
+static int rcd_setup_coll(prrte_grpcomm_coll_t *coll);
+static void rcd_process_data(prrte_grpcomm_coll_t *coll);
+static int rcd_send(prrte_grpcomm_coll_t *coll, size_t rank, uint32_t step);
+static void rcd_finalize_coll(prrte_grpcomm_coll_t *coll, int ret);
+static void rcd_store(prrte_grpcomm_coll_t *coll, uint32_t step,
+                      prrte_buffer_t *buffer);
+
+/* messages that arrive for the next instance of a collective
+ * whose current instance has not yet completed locally */
+typedef struct {
+    prrte_list_item_t super;
+    prrte_grpcomm_signature_t *sig;
+    uint32_t step;
+    prrte_buffer_t *buf;
+} rcd_pending_t;
+static void pcon(rcd_pending_t *p)
+{
+    p->sig = NULL;
+    p->step = 0;
+    p->buf = NULL;
+}
+static void pdes(rcd_pending_t *p)
+{
+    if (NULL != p->sig) {
+        PRRTE_RELEASE(p->sig);
+    }
+    if (NULL != p->buf) {
+        PRRTE_RELEASE(p->buf);
+    }
+}
+static PRRTE_CLASS_INSTANCE(rcd_pending_t,
+                            prrte_list_item_t,
+                            pcon, pdes);
+
+/* internal variables */
+static prrte_list_t pending;
+
+/* compute the number of participants rounded down to a power
+ * of two, and return the number of steps in the collective -
+ * one for the fold-in plus one per exchange */
+static size_t rcd_nsteps(prrte_grpcomm_coll_t *coll, size_t *pof2)
+{
+    size_t p, nsteps;
+
+    p = 1;
+    nsteps = 1;
+    while (p * 2 <= coll->ndmns) {
+        p *= 2;
+        ++nsteps;
+    }
+    if (NULL != pof2) {
+        *pof2 = p;
+    }
+    return nsteps;
+}
+
+/**
+ * Initialize the module
+ */
+static int init(void)
+{
+    PRRTE_CONSTRUCT(&pending, prrte_list_t);
+
+    /* post the receive */
+    prrte_rml.recv_buffer_nb(PRRTE_NAME_WILDCARD,
+                            PRRTE_RML_TAG_ALLGATHER_RCD,
+                            PRRTE_RML_PERSISTENT,
+                            rcd_allgather_recv, NULL);
+
+    return PRRTE_SUCCESS;
+}
+
+/**
+ * Finalize the module
+ */
+static void finalize(void)
+{
+    prrte_rml.recv_cancel(PRRTE_NAME_WILDCARD, PRRTE_RML_TAG_ALLGATHER_RCD);
+    PRRTE_LIST_DESTRUCT(&pending);
+    return;
+}
+
+static int allgather(prrte_grpcomm_coll_t *coll,
+                     prrte_buffer_t *buf, int mode)
+{
+    int rc;
+    size_t pof2;
+
+    PRRTE_OUTPUT_VERBOSE((1, prrte_grpcomm_base_framework.framework_output,
+                         "%s grpcomm:rcd: allgather",
+                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME)));
+
+    /* assigning a context id requires a single authority, so
+     * leave those to the direct component. The mode is part of
+     * the request and is the same on every participant, so all
+     * of them will make the same choice. We must not decline
+     * for any reason that depends on our local state - our
+     * peers would run the collective here while we wait for
+     * them on the direct component's tag */
+    if (0 != mode) {
+        return PRRTE_ERR_TAKE_NEXT_OPTION;
+    }
+
+    /* record that we contributed and seed the
+     * collection with our own data */
+    coll->nreported = 1;
+    prrte_dss.copy_payload(&coll->bucket, buf);
+
+    if (0 == coll->ndmns) {
+        /* the HNP is asked to participate before a job map
+         * exists - it is then the only participant, as every
+         * other daemon fails to create the tracker */
+        rcd_finalize_coll(coll, PRRTE_SUCCESS);
+        return PRRTE_SUCCESS;
+    }
+
+    /* the base functions pushed us into the event library
+     * before calling us, so we can safely access global data
+     * at this point */
+    if (PRRTE_SUCCESS != (rc = rcd_setup_coll(coll))) {
+        PRRTE_ERROR_LOG(rc);
+        rcd_finalize_coll(coll, rc);
+        return PRRTE_SUCCESS;
+    }
+
+    rcd_nsteps(coll, &pof2);
+    if (coll->my_rank >= pof2) {
+        /* fold our contribution into our partner and
+         * wait for the result to come back */
+        return rcd_send(coll, coll->my_rank - pof2, 0);
+    }
+    if (coll->my_rank >= coll->ndmns - pof2) {
+        /* nobody will be folding into us */
+        prrte_grpcomm_base_mark_distance_recv(coll, 0);
+    }
+    rcd_process_data(coll);
+    return PRRTE_SUCCESS;
+}
+
+static int rank_cmp(const void *a, const void *b)
+{
+    prrte_vpid_t va = *(const prrte_vpid_t*)a;
+    prrte_vpid_t vb = *(const prrte_vpid_t*)b;
+
+    return (va < vb) ? -1 : ((va > vb) ? 1 : 0);
+}
+
+/* compute our rank in the collective and allocate the step buffers.
+ * This may be called either when we contribute or when a peer's
+ * message arrives first, so it must only do the work once */
+static int rcd_setup_coll(prrte_grpcomm_coll_t *coll)
+{
+    size_t n, nsteps;
+
+    if (NULL != coll->buffers) {
+        return PRRTE_SUCCESS;
+    }
+
+    if (NULL == coll->dmns) {
+        /* all daemons are participating */
+        coll->my_rank = PRRTE_PROC_MY_NAME->vpid;
+    } else {
+        /* the array may have been assembled in a different order
+         * on each daemon, so put it in a canonical order first */
+        qsort(coll->dmns, coll->ndmns, sizeof(prrte_vpid_t), rank_cmp);
+        for (n=0; n < coll->ndmns; n++) {
+            if (coll->dmns[n] == PRRTE_PROC_MY_NAME->vpid) {
+                break;
+            }
+        }
+        if (coll->ndmns == n) {
+            /* we aren't a participant */
+            return PRRTE_ERR_NOT_FOUND;
+        }
+        coll->my_rank = n;
+    }
+
+    /* one slot for the fold-in plus one per exchange */
+    nsteps = rcd_nsteps(coll, NULL);
+    coll->buffers = (prrte_buffer_t**)calloc(nsteps, sizeof(prrte_buffer_t*));
+    if (NULL == coll->buffers) {
+        return PRRTE_ERR_OUT_OF_RESOURCE;
+    }
+    prrte_bitmap_init(&coll->distance_mask_recv, nsteps);
+    return PRRTE_SUCCESS;
+}
+
+static int rcd_send(prrte_grpcomm_coll_t *coll, size_t rank, uint32_t step)
+{
+    prrte_buffer_t *send_buf;
+    prrte_process_name_t peer;
+    int rc;
+
+    peer.jobid = PRRTE_PROC_MY_NAME->jobid;
+    if (NULL == coll->dmns) {
+        peer.vpid = rank;
+    } else {
+        peer.vpid = coll->dmns[rank];
+    }
+
+    send_buf = PRRTE_NEW(prrte_buffer_t);
+
+    /* pack the signature */
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(send_buf, &coll->sig, 1, PRRTE_SIGNATURE))) {
+        PRRTE_ERROR_LOG(rc);
+        PRRTE_RELEASE(send_buf);
+        return rc;
+    }
+    /* pack the step */
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(send_buf, &step, 1, PRRTE_UINT32))) {
+        PRRTE_ERROR_LOG(rc);
+        PRRTE_RELEASE(send_buf);
+        return rc;
+    }
+    /* pass along everything we have collected so far */
+    if (PRRTE_SUCCESS != (rc = prrte_dss.copy_payload(send_buf, &coll->bucket))) {
+        PRRTE_ERROR_LOG(rc);
+        PRRTE_RELEASE(send_buf);
+        return rc;
+    }
+
+    PRRTE_OUTPUT_VERBOSE((5, prrte_grpcomm_base_framework.framework_output,
+                         "%s grpcomm:rcd: sending step %u with %d bytes to %s",
+                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), step,
+                         (int)send_buf->bytes_used, PRRTE_NAME_PRINT(&peer)));
+
+    if (0 > (rc = prrte_rml.send_buffer_nb(&peer, send_buf,
+                                          PRRTE_RML_TAG_ALLGATHER_RCD,
+                                          prrte_rml_send_callback, NULL))) {
+        PRRTE_ERROR_LOG(rc);
+        PRRTE_RELEASE(send_buf);
+        return rc;
+    }
+    return PRRTE_SUCCESS;
+}
+
+/* consume whatever steps are complete, sending our accumulated
+ * data to the next partner as each step finishes */
+static void rcd_process_data(prrte_grpcomm_coll_t *coll)
+{
+    size_t pof2, nsteps;
+    uint32_t step;
+    int rc;
+
+    nsteps = rcd_nsteps(coll, &pof2);
+
+    /* nreported is one beyond the step we are waiting on */
+    while (0 < coll->nreported) {
+        step = coll->nreported - 1;
+        if (!prrte_grpcomm_base_check_distance_recv(coll, step)) {
+            return;
+        }
+        if (NULL != coll->buffers[step]) {
+            prrte_dss.copy_payload(&coll->bucket, coll->buffers[step]);
+            PRRTE_RELEASE(coll->buffers[step]);
+            coll->buffers[step] = NULL;
+        }
+        coll->nreported++;
+        if (++step == nsteps) {
+            break;
+        }
+        if (PRRTE_SUCCESS != (rc = rcd_send(coll, coll->my_rank ^ (1 << (step-1)), step))) {
+            rcd_finalize_coll(coll, rc);
+            return;
+        }
+    }
+
+    /* we are done - if someone folded into us, then
+     * return the result to them */
+    if (coll->my_rank < coll->ndmns - pof2) {
+        if (PRRTE_SUCCESS != (rc = rcd_send(coll, coll->my_rank + pof2, nsteps))) {
+            rcd_finalize_coll(coll, rc);
+            return;
+        }
+    }
+    rcd_finalize_coll(coll, PRRTE_SUCCESS);
+}
+
+static void rcd_store(prrte_grpcomm_coll_t *coll, uint32_t step,
+                      prrte_buffer_t *buffer)
+{
+    prrte_buffer_t *data;
+
+    data = PRRTE_NEW(prrte_buffer_t);
+    prrte_dss.copy_payload(data, buffer);
+    coll->buffers[step] = data;
+    prrte_grpcomm_base_mark_distance_recv(coll, step);
+}
+
+static void rcd_allgather_recv(int status, prrte_process_name_t* sender,
+                               prrte_buffer_t* buffer, prrte_rml_tag_t tag,
+                               void* cbdata)
+{
+    int32_t cnt;
+    int rc;
+    uint32_t step;
+    size_t nsteps;
+    prrte_grpcomm_signature_t *sig;
+    prrte_grpcomm_coll_t *coll;
+    rcd_pending_t *pd;
+
+    PRRTE_OUTPUT_VERBOSE((5, prrte_grpcomm_base_framework.framework_output,
+                         "%s grpcomm:rcd: recvd from %s",
+                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                         PRRTE_NAME_PRINT(sender)));
+
+    /* unpack the signature */
+    cnt = 1;
+    if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &sig, &cnt, PRRTE_SIGNATURE))) {
+        PRRTE_ERROR_LOG(rc);
+        return;
+    }
+
+    /* unpack the step */
+    cnt = 1;
+    if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &step, &cnt, PRRTE_UINT32))) {
+        PRRTE_ERROR_LOG(rc);
+        PRRTE_RELEASE(sig);
+        return;
+    }
+
+    /* check for the tracker and create it if not found - a
+     * peer may get here before we have contributed */
+    if (NULL == (coll = prrte_grpcomm_base_get_tracker(sig, true))) {
+        PRRTE_ERROR_LOG(PRRTE_ERR_NOT_FOUND);
+        PRRTE_RELEASE(sig);
+        return;
+    }
+    if (PRRTE_SUCCESS != (rc = rcd_setup_coll(coll))) {
+        PRRTE_ERROR_LOG(rc);
+        PRRTE_RELEASE(sig);
+        return;
+    }
+
+    nsteps = rcd_nsteps(coll, NULL);
+
+    if (nsteps == step) {
+        /* this is the final result returned by the daemon
+         * we folded into - replace our bucket with it */
+        PRRTE_DESTRUCT(&coll->bucket);
+        PRRTE_CONSTRUCT(&coll->bucket, prrte_buffer_t);
+        prrte_dss.copy_payload(&coll->bucket, buffer);
+        rcd_finalize_coll(coll, PRRTE_SUCCESS);
+        PRRTE_RELEASE(sig);
+        return;
+    }
+    if (nsteps < step) {
+        PRRTE_ERROR_LOG(PRRTE_ERR_BAD_PARAM);
+        PRRTE_RELEASE(sig);
+        return;
+    }
+
+    if (prrte_grpcomm_base_check_distance_recv(coll, step)) {
+        /* the sender has already moved on to the next instance
+         * of this collective - hold the data until we are done
+         * with the current one */
+        pd = PRRTE_NEW(rcd_pending_t);
+        pd->sig = sig;
+        pd->step = step;
+        pd->buf = PRRTE_NEW(prrte_buffer_t);
+        prrte_dss.copy_payload(pd->buf, buffer);
+        prrte_list_append(&pending, &pd->super);
+        return;
+    }
+
+    rcd_store(coll, step, buffer);
+    rcd_process_data(coll);
+    PRRTE_RELEASE(sig);
+}
+
+static void rcd_finalize_coll(prrte_grpcomm_coll_t *coll, int ret)
+{
+    prrte_grpcomm_signature_t *sig;
+    prrte_grpcomm_coll_t *next;
+    rcd_pending_t *pd, *pdnext;
+
+    PRRTE_OUTPUT_VERBOSE((1, prrte_grpcomm_base_framework.framework_output,
+                         "%s grpcomm:rcd: allgather complete with status %s",
+                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                         PRRTE_ERROR_NAME(ret)));
+
+    /* execute the callback */
+    if (NULL != coll->cbfunc) {
+        coll->cbfunc(ret, &coll->bucket, coll->cbdata);
+    }
+    prrte_grpcomm_base_remove_tracker(coll);
+    PRRTE_RETAIN(coll->sig);
+    sig = coll->sig;
+    PRRTE_RELEASE(coll);
+
+    /* transfer anything that arrived early for the next
+     * instance of this collective into a new tracker */
+    next = NULL;
+    PRRTE_LIST_FOREACH_SAFE(pd, pdnext, &pending, rcd_pending_t) {
+        if (PRRTE_EQUAL != prrte_dss.compare(sig, pd->sig, PRRTE_SIGNATURE)) {
+            continue;
+        }
+        if (NULL == next) {
+            if (NULL == (next = prrte_grpcomm_base_get_tracker(sig, true)) ||
+                PRRTE_SUCCESS != rcd_setup_coll(next)) {
+                PRRTE_ERROR_LOG(PRRTE_ERR_NOT_FOUND);
+                break;
+            }
+        }
+        prrte_list_remove_item(&pending, &pd->super);
+        rcd_store(next, pd->step, pd->buf);
+        PRRTE_RELEASE(pd);
+    }
+    PRRTE_RELEASE(sig);
+}
@@ -0,0 +1,30 @@
+/* -*- C -*-
+ *
+ * Copyright (c) 2020      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ */
+#ifndef GRPCOMM_RCD_H
+#define GRPCOMM_RCD_H
+
+#include "prrte_config.h"
+
+
+#include "src/mca/grpcomm/grpcomm.h"
+
+BEGIN_C_DECLS
+
+/*
+ * Grpcomm interfaces
+ */
+
+PRRTE_MODULE_EXPORT extern prrte_grpcomm_base_component_t prrte_grpcomm_rcd_component;
+extern prrte_grpcomm_base_module_t prrte_grpcomm_rcd_module;
+
+END_C_DECLS
+
+#endif
@@ -0,0 +1,84 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2020      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "prrte_config.h"
+#include "constants.h"
+
+#include "src/mca/mca.h"
+#include "src/runtime/prrte_globals.h"
+#include "src/mca/base/prrte_mca_base_var.h"
+
+#include "src/util/proc_info.h"
+
+#include "grpcomm_rcd.h"
+
+static int my_priority;
+static int rcd_open(void);
+static int rcd_close(void);
+static int rcd_query(prrte_mca_base_module_t **module, int *priority);
+static int rcd_register(void);
+
+/*
+ * Struct of function pointers that need to be initialized
+ */
+prrte_grpcomm_base_component_t prrte_grpcomm_rcd_component = {
+    .base_version = {
+        PRRTE_GRPCOMM_BASE_VERSION_3_0_0,
+
+        .mca_component_name = "rcd",
+        PRRTE_MCA_BASE_MAKE_VERSION(component, PRRTE_MAJOR_VERSION, PRRTE_MINOR_VERSION,
+                                    PRRTE_RELEASE_VERSION),
+        .mca_open_component = rcd_open,
+        .mca_close_component = rcd_close,
+        .mca_query_component = rcd_query,
+        .mca_register_component_params = rcd_register,
+    },
+    .base_data = {
+        /* The component is checkpoint ready */
+        PRRTE_MCA_BASE_METADATA_PARAM_CHECKPOINT
+    },
+};
+
+static int rcd_register(void)
+{
+    prrte_mca_base_component_t *c = &prrte_grpcomm_rcd_component.base_version;
+
+    /* we must sit above the direct component so we get first
+     * crack at each allgather - anything we cannot handle
+     * (e.g., requests for a context id) falls thru to direct
+     */
+    my_priority = 90;
+    (void) prrte_mca_base_component_var_register(c, "priority",
+                                           "Priority of the grpcomm rcd component",
+                                           PRRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           PRRTE_INFO_LVL_9,
+                                           PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                           &my_priority);
+    return PRRTE_SUCCESS;
+}
+
+/* Open the component */
+static int rcd_open(void)
+{
+    return PRRTE_SUCCESS;
+}
+
+static int rcd_close(void)
+{
+    return PRRTE_SUCCESS;
+}
+
+static int rcd_query(prrte_mca_base_module_t **module, int *priority)
+{
+    /* we are always available */
+    *priority = my_priority;
+    *module = (prrte_mca_base_module_t *)&prrte_grpcomm_rcd_module;
+    return PRRTE_SUCCESS;
+}
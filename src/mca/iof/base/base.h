@@ -82,8 +82,9 @@ PRRTE_EXPORT PRRTE_CLASS_DECLARATION(prrte_iof_job_t);
  * Maximum size of single msg
  */
 #define PRRTE_IOF_BASE_MSG_MAX           4096
+#define PRRTE_IOF_BASE_READ_MAX         65536
 #define PRRTE_IOF_BASE_TAG_MAX             50
-#define PRRTE_IOF_BASE_TAGGED_OUT_MAX    8192
+#define PRRTE_IOF_BASE_IOV_MAX            128
 #define PRRTE_IOF_MAX_INPUT_BUFFERS        50
 
 typedef struct {
@@ -120,6 +121,11 @@ typedef struct {
     bool active;
     bool always_readable;
     prrte_iof_sink_t *sink;
+    /* read buffer - the read size adapts to the
+     * amount of data the proc is producing */
+    unsigned char *data;
+    int32_t size;
+    int32_t nalloc;
 } prrte_iof_read_event_t;
 PRRTE_EXPORT PRRTE_CLASS_DECLARATION(prrte_iof_read_event_t);
 
@@ -136,8 +142,19 @@ PRRTE_EXPORT PRRTE_CLASS_DECLARATION(prrte_iof_proc_t);
 
 typedef struct {
     prrte_list_item_t super;
-    char data[PRRTE_IOF_BASE_TAGGED_OUT_MAX];
+    /* our copy of the data */
+    char *data;
+    /* number of bytes remaining to be written */
     int numbytes;
+    /* the segments to be written - pieces of the data interleaved
+     * with any tags, so tagging the output doesn't require
+     * building a reformatted copy of it */
+    struct iovec *iov;
+    int niov;
+    int curiov;
+    struct iovec iov1;
+    /* storage for the start and end tags */
+    char *tags;
 } prrte_iof_write_output_t;
 PRRTE_EXPORT PRRTE_CLASS_DECLARATION(prrte_iof_write_output_t);
 
@@ -147,6 +164,7 @@ struct prrte_iof_base_t {
     prrte_iof_sink_t         *iof_write_stdout;
     prrte_iof_sink_t         *iof_write_stderr;
     bool                    redirect_app_stderr_to_stdout;
+    int                     read_max;
 };
 typedef struct prrte_iof_base_t prrte_iof_base_t;
 
@@ -276,6 +294,8 @@ PRRTE_EXPORT int prrte_iof_base_write_output(const prrte_process_name_t *name, p
                                              const unsigned char *data, int numbytes,
                                              prrte_iof_write_event_t *channel);
 PRRTE_EXPORT void prrte_iof_base_static_dump_output(prrte_iof_read_event_t *rev);
+PRRTE_EXPORT int32_t prrte_iof_base_read(prrte_iof_read_event_t *rev);
+PRRTE_EXPORT int prrte_iof_base_dump_outputs(prrte_iof_write_event_t *wev);
 PRRTE_EXPORT void prrte_iof_base_write_handler(int fd, short event, void *cbdata);
 
 END_C_DECLS
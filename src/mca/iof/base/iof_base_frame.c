@@ -81,6 +81,18 @@ static int prrte_iof_base_register(prrte_mca_base_register_flag_t flags)
                                        PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
                                        &prrte_iof_base.redirect_app_stderr_to_stdout);
 
+    /* largest single read from a proc's output */
+    prrte_iof_base.read_max = PRRTE_IOF_BASE_READ_MAX;
+    (void) prrte_mca_base_var_register("prrte", "iof", "base", "read_max",
+                                       "Maximum number of bytes read from a process output stream at one time - the read size grows to this limit while the process keeps the stream full (default: 65536)",
+                                       PRRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                       PRRTE_INFO_LVL_9,
+                                       PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                       &prrte_iof_base.read_max);
+    if (prrte_iof_base.read_max < PRRTE_IOF_BASE_MSG_MAX) {
+        prrte_iof_base.read_max = PRRTE_IOF_BASE_MSG_MAX;
+    }
+
     return PRRTE_SUCCESS;
 }
 
@@ -237,6 +249,9 @@ static void prrte_iof_base_read_event_construct(prrte_iof_read_event_t* rev)
     rev->sink = NULL;
     rev->tv.tv_sec = 0;
     rev->tv.tv_usec = 0;
+    rev->data = NULL;
+    rev->size = 0;
+    rev->nalloc = 0;
 }
 static void prrte_iof_base_read_event_destruct(prrte_iof_read_event_t* rev)
 {
@@ -256,6 +271,9 @@ static void prrte_iof_base_read_event_destruct(prrte_iof_read_event_t* rev)
     if (NULL != rev->sink) {
         PRRTE_RELEASE(rev->sink);
     }
+    if (NULL != rev->data) {
+        free(rev->data);
+    }
     if (NULL != proct) {
         PRRTE_RELEASE(proct);
     }
@@ -303,6 +321,28 @@ PRRTE_CLASS_INSTANCE(prrte_iof_write_event_t,
                    prrte_iof_base_write_event_construct,
                    prrte_iof_base_write_event_destruct);
 
+static void prrte_iof_base_write_output_construct(prrte_iof_write_output_t *output)
+{
+    output->data = NULL;
+    output->numbytes = 0;
+    output->iov = &output->iov1;
+    output->niov = 0;
+    output->curiov = 0;
+    output->tags = NULL;
+}
+static void prrte_iof_base_write_output_destruct(prrte_iof_write_output_t *output)
+{
+    if (NULL != output->data) {
+        free(output->data);
+    }
+    if (&output->iov1 != output->iov && NULL != output->iov) {
+        free(output->iov);
+    }
+    if (NULL != output->tags) {
+        free(output->tags);
+    }
+}
 PRRTE_CLASS_INSTANCE(prrte_iof_write_output_t,
                    prrte_list_item_t,
-                   NULL, NULL);
+                   prrte_iof_base_write_output_construct,
+                   prrte_iof_base_write_output_destruct);
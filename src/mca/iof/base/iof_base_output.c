@@ -46,15 +46,27 @@
 
 #include "src/mca/iof/base/base.h"
 
+/* append a segment to the list of bytes to be written */
+static void add_iov(prrte_iof_write_output_t *output, const void *base, size_t len)
+{
+    if (0 == len) {
+        return;
+    }
+    output->iov[output->niov].iov_base = (IOVBASE_TYPE*)base;
+    output->iov[output->niov].iov_len = len;
+    output->niov++;
+    output->numbytes += len;
+}
+
 int prrte_iof_base_write_output(const prrte_process_name_t *name, prrte_iof_tag_t stream,
                                const unsigned char *data, int numbytes,
                                prrte_iof_write_event_t *channel)
 {
     char starttag[PRRTE_IOF_BASE_TAG_MAX], endtag[PRRTE_IOF_BASE_TAG_MAX], *suffix;
     prrte_iof_write_output_t *output;
-    int i, j, k, starttaglen, endtaglen, num_buffered;
-    bool endtagged;
+    int i, j, k, starttaglen, endtaglen, nlines, num_buffered;
     char qprint[10];
+    char *line, *nl, *end;
 
     PRRTE_OUTPUT_VERBOSE((1, prrte_iof_base_framework.framework_output,
                          "%s write:output setting up to write %d bytes to %s for %s on fd %d",
@@ -68,16 +80,8 @@ int prrte_iof_base_write_output(const prrte_process_name_t *name, prrte_iof_tag_
 
     /* write output data to the corresponding tag */
     if (PRRTE_IOF_STDIN & stream) {
-        /* copy over the data to be written */
-        if (0 < numbytes) {
-            /* don't copy 0 bytes - we just need to pass
-             * the zero bytes so the fd can be closed
-             * after it writes everything out
-             */
-            memcpy(output->data, data, numbytes);
-        }
-        output->numbytes = numbytes;
-        goto process;
+        /* input is never tagged */
+        goto copy;
     } else if (PRRTE_IOF_STDOUT & stream) {
         /* write the bytes to stdout */
         suffix = "stdout";
@@ -92,6 +96,7 @@ int prrte_iof_base_write_output(const prrte_process_name_t *name, prrte_iof_tag_
         PRRTE_ERROR_LOG(PRRTE_ERR_VALUE_OUT_OF_BOUNDS);
         PRRTE_OUTPUT_VERBOSE((1, prrte_iof_base_framework.framework_output,
                              "%s stream %0x", PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), stream));
+        PRRTE_RELEASE(output);
         return PRRTE_ERR_VALUE_OUT_OF_BOUNDS;
     }
 
@@ -136,6 +141,7 @@ int prrte_iof_base_write_output(const prrte_process_name_t *name, prrte_iof_tag_
         goto construct;
     }
 
+  copy:
     /* if we get here, then the data is not to be tagged - just copy it
      * and move on to processing
      */
@@ -144,112 +150,116 @@ int prrte_iof_base_write_output(const prrte_process_name_t *name, prrte_iof_tag_
          * the zero bytes so the fd can be closed
          * after it writes everything out
          */
+        output->data = (char*)malloc(numbytes);
+        if (NULL == output->data) {
+            PRRTE_RELEASE(output);
+            return PRRTE_ERR_OUT_OF_RESOURCE;
+        }
         memcpy(output->data, data, numbytes);
+        add_iov(output, output->data, numbytes);
     }
-    output->numbytes = numbytes;
     goto process;
 
   construct:
+    if (0 == numbytes) {
+        /* nothing to tag */
+        PRRTE_RELEASE(output);
+        return prrte_list_get_size(&channel->outputs);
+    }
     starttaglen = strlen(starttag);
     endtaglen = strlen(endtag);
-    endtagged = false;
-    /* start with the tag */
-    for (j=0, k=0; j < starttaglen && k < PRRTE_IOF_BASE_TAGGED_OUT_MAX; j++) {
-        output->data[k++] = starttag[j];
+    /* count the lines so we know how much room we need */
+    nlines = 1;
+    for (i=0; i < numbytes; i++) {
+        if ('\n' == data[i]) {
+            nlines++;
+        }
     }
-    /* cycle through the data looking for <cr>
-     * and replace those with the tag
-     */
-    for (i=0; i < numbytes && k < PRRTE_IOF_BASE_TAGGED_OUT_MAX; i++) {
-        if (prrte_xml_output) {
+
+    if (prrte_xml_output) {
+        /* the data has to be escaped, so we cannot write it out
+         * as-is - build the tagged output in a single buffer that
+         * is large enough to hold the worst case */
+        output->data = (char*)malloc(7 * numbytes + nlines * (starttaglen + endtaglen + 1) + 1);
+        if (NULL == output->data) {
+            PRRTE_RELEASE(output);
+            return PRRTE_ERR_OUT_OF_RESOURCE;
+        }
+        /* start with the tag */
+        memcpy(output->data, starttag, starttaglen);
+        k = starttaglen;
+        for (i=0; i < numbytes; i++) {
             if ('&' == data[i]) {
-                if (k+5 >= PRRTE_IOF_BASE_TAGGED_OUT_MAX) {
-                    PRRTE_ERROR_LOG(PRRTE_ERR_OUT_OF_RESOURCE);
-                    goto process;
-                }
-                snprintf(qprint, 10, "&amp;");
-                for (j=0; j < (int)strlen(qprint) && k < PRRTE_IOF_BASE_TAGGED_OUT_MAX; j++) {
-                    output->data[k++] = qprint[j];
-                }
+                memcpy(&output->data[k], "&amp;", 5);
+                k += 5;
             } else if ('<' == data[i]) {
-                if (k+4 >= PRRTE_IOF_BASE_TAGGED_OUT_MAX) {
-                    PRRTE_ERROR_LOG(PRRTE_ERR_OUT_OF_RESOURCE);
-                    goto process;
-                }
-                snprintf(qprint, 10, "&lt;");
-                for (j=0; j < (int)strlen(qprint) && k < PRRTE_IOF_BASE_TAGGED_OUT_MAX; j++) {
-                    output->data[k++] = qprint[j];
-                }
+                memcpy(&output->data[k], "&lt;", 4);
+                k += 4;
             } else if ('>' == data[i]) {
-                if (k+4 >= PRRTE_IOF_BASE_TAGGED_OUT_MAX) {
-                    PRRTE_ERROR_LOG(PRRTE_ERR_OUT_OF_RESOURCE);
-                    goto process;
-                }
-                snprintf(qprint, 10, "&gt;");
-                for (j=0; j < (int)strlen(qprint) && k < PRRTE_IOF_BASE_TAGGED_OUT_MAX; j++) {
-                    output->data[k++] = qprint[j];
-                }
+                memcpy(&output->data[k], "&gt;", 4);
+                k += 4;
             } else if (data[i] < 32 || data[i] > 127) {
                 /* this is a non-printable character, so escape it too */
-                if (k+7 >= PRRTE_IOF_BASE_TAGGED_OUT_MAX) {
-                    PRRTE_ERROR_LOG(PRRTE_ERR_OUT_OF_RESOURCE);
-                    goto process;
-                }
-                snprintf(qprint, 10, "&#%03d;", (int)data[i]);
-                for (j=0; j < (int)strlen(qprint) && k < PRRTE_IOF_BASE_TAGGED_OUT_MAX; j++) {
-                    output->data[k++] = qprint[j];
-                }
+                j = snprintf(qprint, 10, "&#%03d;", (int)data[i]);
+                memcpy(&output->data[k], qprint, j);
+                k += j;
                 /* if this was a \n, then we also need to break the line with the end tag */
-                if ('\n' == data[i] && (k+endtaglen+1) < PRRTE_IOF_BASE_TAGGED_OUT_MAX) {
-                    /* we need to break the line with the end tag */
-                    for (j=0; j < endtaglen && k < PRRTE_IOF_BASE_TAGGED_OUT_MAX-1; j++) {
-                        output->data[k++] = endtag[j];
-                    }
-                    /* move the <cr> over */
+                if ('\n' == data[i]) {
+                    memcpy(&output->data[k], endtag, endtaglen);
+                    k += endtaglen;
                     output->data[k++] = '\n';
                     /* if this isn't the end of the data buffer, add a new start tag */
-                    if (i < numbytes-1 && (k+starttaglen) < PRRTE_IOF_BASE_TAGGED_OUT_MAX) {
-                        for (j=0; j < starttaglen && k < PRRTE_IOF_BASE_TAGGED_OUT_MAX; j++) {
-                            output->data[k++] = starttag[j];
-                            endtagged = false;
-                        }
-                    } else {
-                        endtagged = true;
-                    }
-                }
-            } else {
-                output->data[k++] = data[i];
-            }
-        } else {
-            if ('\n' == data[i]) {
-                /* we need to break the line with the end tag */
-                for (j=0; j < endtaglen && k < PRRTE_IOF_BASE_TAGGED_OUT_MAX-1; j++) {
-                    output->data[k++] = endtag[j];
-                }
-                /* move the <cr> over */
-                output->data[k++] = '\n';
-                /* if this isn't the end of the data buffer, add a new start tag */
-                if (i < numbytes-1) {
-                    for (j=0; j < starttaglen && k < PRRTE_IOF_BASE_TAGGED_OUT_MAX; j++) {
-                        output->data[k++] = starttag[j];
-                        endtagged = false;
+                    if (i < numbytes-1) {
+                        memcpy(&output->data[k], starttag, starttaglen);
+                        k += starttaglen;
                     }
-                } else {
-                    endtagged = true;
                 }
             } else {
                 output->data[k++] = data[i];
             }
         }
+        if ('\n' != data[numbytes-1]) {
+            /* need to add an endtag */
+            memcpy(&output->data[k], endtag, endtaglen);
+            k += endtaglen;
+        }
+        add_iov(output, output->data, k);
+        goto process;
     }
-    if (!endtagged && k < PRRTE_IOF_BASE_TAGGED_OUT_MAX) {
-        /* need to add an endtag */
-        for (j=0; j < endtaglen && k < PRRTE_IOF_BASE_TAGGED_OUT_MAX-1; j++) {
-            output->data[k++] = endtag[j];
+
+    /* copy the data once and interleave the tags with its lines
+     * when we write it out, rather than building a tagged copy */
+    output->data = (char*)malloc(numbytes);
+    output->tags = (char*)malloc(starttaglen + endtaglen + 2);
+    output->iov = (struct iovec*)malloc(4 * nlines * sizeof(struct iovec));
+    if (NULL == output->data || NULL == output->tags || NULL == output->iov) {
+        PRRTE_RELEASE(output);
+        return PRRTE_ERR_OUT_OF_RESOURCE;
+    }
+    memcpy(output->data, data, numbytes);
+    memcpy(output->tags, starttag, starttaglen + 1);
+    memcpy(output->tags + starttaglen + 1, endtag, endtaglen + 1);
+    line = output->data;
+    end = output->data + numbytes;
+    while (line < end) {
+        add_iov(output, output->tags, starttaglen);
+        nl = memchr(line, '\n', end - line);
+        if (NULL == nl) {
+            /* need to add an endtag */
+            add_iov(output, line, end - line);
+            add_iov(output, output->tags + starttaglen + 1, endtaglen);
+            break;
+        }
+        if (0 == endtaglen) {
+            add_iov(output, line, nl - line + 1);
+        } else {
+            /* we need to break the line with the end tag */
+            add_iov(output, line, nl - line);
+            add_iov(output, output->tags + starttaglen + 1, endtaglen);
+            add_iov(output, nl, 1);
         }
-        output->data[k] = '\n';
+        line = nl + 1;
     }
-    output->numbytes = k;
 
   process:
     /* add this data to the write list for this fd */
@@ -270,28 +280,75 @@ int prrte_iof_base_write_output(const prrte_process_name_t *name, prrte_iof_tag_
     return num_buffered;
 }
 
-void prrte_iof_base_static_dump_output(prrte_iof_read_event_t *rev)
+/* read from a proc's output stream. The read size starts at a single
+ * message and doubles each time a read fills the buffer, up to the
+ * read_max limit. It shrinks again once the proc goes quiet. Input
+ * is always read a message at a time as the receiving side cannot
+ * take more than that */
+int32_t prrte_iof_base_read(prrte_iof_read_event_t *rev)
+{
+    int32_t numbytes, max;
+    unsigned char *tmp;
+
+    max = (PRRTE_IOF_STDIN & rev->tag) ? PRRTE_IOF_BASE_MSG_MAX : prrte_iof_base.read_max;
+    if (0 == rev->size) {
+        rev->size = PRRTE_IOF_BASE_MSG_MAX;
+    }
+    if (rev->nalloc < rev->size) {
+        tmp = (unsigned char*)realloc(rev->data, rev->size);
+        if (NULL == tmp) {
+            errno = ENOMEM;
+            return -1;
+        }
+        rev->data = tmp;
+        rev->nalloc = rev->size;
+    }
+
+    numbytes = read(rev->fd, rev->data, rev->size);
+
+    if (numbytes == rev->size && rev->size < max) {
+        /* the proc is keeping the pipe full - read more next time */
+        rev->size *= 2;
+        if (max < rev->size) {
+            rev->size = max;
+        }
+    } else if (0 < numbytes && numbytes < rev->size / 4 &&
+               PRRTE_IOF_BASE_MSG_MAX < rev->size) {
+        rev->size /= 2;
+    }
+    return numbytes;
+}
+
+/* make one last attempt to write out anything pending on the
+ * channel, dropping whatever cannot be written */
+int prrte_iof_base_dump_outputs(prrte_iof_write_event_t *wev)
 {
-    bool dump;
+    bool dump = false;
     int num_written;
-    prrte_iof_write_event_t *wev;
     prrte_iof_write_output_t *output;
 
+    while (NULL != (output = (prrte_iof_write_output_t*)prrte_list_remove_first(&wev->outputs))) {
+        if (!dump && 0 < output->numbytes) {
+            num_written = writev(wev->fd, &output->iov[output->curiov],
+                                 output->niov - output->curiov);
+            if (num_written < output->numbytes) {
+                /* don't retry - just cleanout the list and dump it */
+                dump = true;
+            }
+        }
+        PRRTE_RELEASE(output);
+    }
+    return PRRTE_SUCCESS;
+}
+
+void prrte_iof_base_static_dump_output(prrte_iof_read_event_t *rev)
+{
+    prrte_iof_write_event_t *wev;
+
     if (NULL != rev->sink) {
         wev = rev->sink->wev;
         if (NULL != wev && !prrte_list_is_empty(&wev->outputs)) {
-            dump = false;
-            /* make one last attempt to write this out */
-            while (NULL != (output = (prrte_iof_write_output_t*)prrte_list_remove_first(&wev->outputs))) {
-                if (!dump) {
-                    num_written = write(wev->fd, output->data, output->numbytes);
-                    if (num_written < output->numbytes) {
-                        /* don't retry - just cleanout the list and dump it */
-                        dump = true;
-                    }
-                }
-                PRRTE_RELEASE(output);
-            }
+            prrte_iof_base_dump_outputs(wev);
         }
     }
 }
@@ -300,9 +357,10 @@ void prrte_iof_base_write_handler(int _fd, short event, void *cbdata)
 {
     prrte_iof_sink_t *sink = (prrte_iof_sink_t*)cbdata;
     prrte_iof_write_event_t *wev = sink->wev;
-    prrte_list_item_t *item;
     prrte_iof_write_output_t *output;
-    int num_written, total_written = 0;
+    struct iovec iov[PRRTE_IOF_BASE_IOV_MAX];
+    int i, n, nbytes, written, num_written, total_written = 0;
+    size_t len;
 
     PRRTE_ACQUIRE_OBJECT(sink);
 
@@ -311,18 +369,34 @@ void prrte_iof_base_write_handler(int _fd, short event, void *cbdata)
                          PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
                          wev->fd));
 
-    while (NULL != (item = prrte_list_remove_first(&wev->outputs))) {
-        output = (prrte_iof_write_output_t*)item;
-        if (0 == output->numbytes) {
+    while (!prrte_list_is_empty(&wev->outputs)) {
+        /* gather as much of the pending output as we can
+         * into a single write */
+        n = 0;
+        nbytes = 0;
+        PRRTE_LIST_FOREACH(output, &wev->outputs, prrte_iof_write_output_t) {
+            if (0 == output->numbytes) {
+                /* we are to close the stream after this */
+                break;
+            }
+            for (i=output->curiov; i < output->niov && n < PRRTE_IOF_BASE_IOV_MAX; i++) {
+                iov[n++] = output->iov[i];
+                nbytes += output->iov[i].iov_len;
+            }
+            if (PRRTE_IOF_BASE_IOV_MAX == n) {
+                break;
+            }
+        }
+        if (0 == n) {
             /* indicates we are to close this stream */
+            output = (prrte_iof_write_output_t*)prrte_list_remove_first(&wev->outputs);
+            PRRTE_RELEASE(output);
             PRRTE_RELEASE(sink);
             return;
         }
-        num_written = write(wev->fd, output->data, output->numbytes);
+        num_written = writev(wev->fd, iov, n);
         if (num_written < 0) {
             if (EAGAIN == errno || EINTR == errno) {
-                /* push this item back on the front of the list */
-                prrte_list_prepend(&wev->outputs, item);
                 /* if the list is getting too large, abort */
                 if (prrte_iof_base.output_limit < prrte_list_get_size(&wev->outputs)) {
                     prrte_output(0, "IO Forwarding is running too far behind - something is blocking us from writing");
@@ -337,16 +411,36 @@ void prrte_iof_base_write_handler(int _fd, short event, void *cbdata)
             /* otherwise, something bad happened so all we can do is abort
              * this attempt
              */
+            output = (prrte_iof_write_output_t*)prrte_list_remove_first(&wev->outputs);
             PRRTE_RELEASE(output);
             goto ABORT;
-        } else if (num_written < output->numbytes) {
-            /* incomplete write - adjust data to avoid duplicate output */
-            memmove(output->data, &output->data[num_written], output->numbytes - num_written);
-            /* adjust the number of bytes remaining to be written */
-            output->numbytes -= num_written;
-            /* push this item back on the front of the list */
-            prrte_list_prepend(&wev->outputs, item);
-            /* if the list is getting too large, abort */
+        }
+        written = num_written;
+        total_written += written;
+
+        /* release everything that was completely written, and
+         * adjust the data of anything that was only partially
+         * written to avoid duplicate output */
+        while (0 < num_written) {
+            output = (prrte_iof_write_output_t*)prrte_list_get_first(&wev->outputs);
+            len = output->iov[output->curiov].iov_len;
+            if ((size_t)num_written < len) {
+                output->iov[output->curiov].iov_base = (IOVBASE_TYPE*)((char*)output->iov[output->curiov].iov_base + num_written);
+                output->iov[output->curiov].iov_len -= num_written;
+                output->numbytes -= num_written;
+                break;
+            }
+            num_written -= len;
+            output->numbytes -= len;
+            output->curiov++;
+            if (output->curiov == output->niov) {
+                prrte_list_remove_first(&wev->outputs);
+                PRRTE_RELEASE(output);
+            }
+        }
+
+        if (written < nbytes) {
+            /* incomplete write - if the list is getting too large, abort */
             if (prrte_iof_base.output_limit < prrte_list_get_size(&wev->outputs)) {
                 prrte_output(0, "IO Forwarding is running too far behind - something is blocking us from writing");
                 PRRTE_FORCED_TERMINATE(PRRTE_ERROR_DEFAULT_EXIT_CODE);
@@ -357,9 +451,7 @@ void prrte_iof_base_write_handler(int _fd, short event, void *cbdata)
              */
             goto NEXT_CALL;
         }
-        PRRTE_RELEASE(output);
 
-        total_written += num_written;
         if(wev->always_writable && (PRRTE_IOF_SINK_BLOCKSIZE <= total_written)){
             /* If this is a regular file it will never tell us it will block
              * Write no more than PRRTE_IOF_REGULARF_BLOCK at a time allowing
@@ -442,42 +442,18 @@ static int finalize(void)
 {
     prrte_iof_write_event_t *wev;
     prrte_iof_proc_t *proct;
-    bool dump;
-    prrte_iof_write_output_t *output;
-    int num_written;
 
-    /* check if anything is still trying to be written out */
+    /* check if anything is still trying to be written out - make
+     * one last attempt to write it */
     wev = prrte_iof_base.iof_write_stdout->wev;
     if (!prrte_list_is_empty(&wev->outputs)) {
-        dump = false;
-        /* make one last attempt to write this out */
-        while (NULL != (output = (prrte_iof_write_output_t*)prrte_list_remove_first(&wev->outputs))) {
-            if (!dump) {
-                num_written = write(wev->fd, output->data, output->numbytes);
-                if (num_written < output->numbytes) {
-                    /* don't retry - just cleanout the list and dump it */
-                    dump = true;
-                }
-            }
-            PRRTE_RELEASE(output);
-        }
+        prrte_iof_base_dump_outputs(wev);
     }
     if (!prrte_xml_output) {
         /* we only opened stderr channel if we are NOT doing xml output */
         wev = prrte_iof_base.iof_write_stderr->wev;
         if (!prrte_list_is_empty(&wev->outputs)) {
-            dump = false;
-            /* make one last attempt to write this out */
-            while (NULL != (output = (prrte_iof_write_output_t*)prrte_list_remove_first(&wev->outputs))) {
-                if (!dump) {
-                    num_written = write(wev->fd, output->data, output->numbytes);
-                    if (num_written < output->numbytes) {
-                        /* don't retry - just cleanout the list and dump it */
-                        dump = true;
-                    }
-                }
-                PRRTE_RELEASE(output);
-            }
+            prrte_iof_base_dump_outputs(wev);
         }
     }
 
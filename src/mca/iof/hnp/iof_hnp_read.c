@@ -110,7 +110,7 @@ static void lkcbfunc(pmix_status_t status, void *cbdata)
 void prrte_iof_hnp_read_local_handler(int fd, short event, void *cbdata)
 {
     prrte_iof_read_event_t *rev = (prrte_iof_read_event_t*)cbdata;
-    unsigned char data[PRRTE_IOF_BASE_MSG_MAX];
+    unsigned char *data;
     int32_t numbytes;
     prrte_iof_proc_t *proct = (prrte_iof_proc_t*)rev->proc;
     int rc;
@@ -125,9 +125,9 @@ void prrte_iof_hnp_read_local_handler(int fd, short event, void *cbdata)
      */
     fd = rev->fd;
 
-    /* read up to the fragment size */
-    memset(data, 0, PRRTE_IOF_BASE_MSG_MAX);
-    numbytes = read(fd, data, sizeof(data));
+    /* read up to the current read size */
+    numbytes = prrte_iof_base_read(rev);
+    data = rev->data;
 
     if (NULL == proct) {
         /* this is an error - nothing we can do */
@@ -62,14 +62,150 @@ static void lkcbfunc(pmix_status_t status, void *cbdata)
     PRRTE_PMIX_WAKEUP_THREAD(lk);
 }
 
+/* output forwarded by a daemon - pass it to any tools that
+ * want a copy and write it out */
+static void deliver_output(prrte_buffer_t *buffer, prrte_iof_tag_t stream,
+                           prrte_process_name_t *origin)
+{
+    unsigned char sdata[PRRTE_IOF_BASE_MSG_MAX], *data = sdata;
+    int32_t count, numbytes;
+    prrte_iof_sink_t *sink;
+    int rc;
+    bool exclusive;
+    prrte_iof_proc_t *proct;
+    prrte_ns_cmp_bitmask_t mask=PRRTE_NS_CMP_ALL | PRRTE_NS_CMP_WILD;
+
+    /* get the number of bytes that were sent */
+    count = 1;
+    if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &numbytes, &count, PRRTE_INT32))) {
+        PRRTE_ERROR_LOG(rc);
+        return;
+    }
+    /* most output is small, so only go to the heap for large reads */
+    if (PRRTE_IOF_BASE_MSG_MAX < numbytes) {
+        data = (unsigned char*)malloc(numbytes);
+        if (NULL == data) {
+            PRRTE_ERROR_LOG(PRRTE_ERR_OUT_OF_RESOURCE);
+            return;
+        }
+    }
+    if (0 < numbytes) {
+        count = numbytes;
+        if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, data, &count, PRRTE_BYTE))) {
+            PRRTE_ERROR_LOG(rc);
+            goto CLEAN_RETURN;
+        }
+    }
+
+    PRRTE_OUTPUT_VERBOSE((1, prrte_iof_base_framework.framework_output,
+                         "%s unpacked %d bytes from remote proc %s",
+                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), numbytes,
+                         PRRTE_NAME_PRINT(origin)));
+
+    /* do we already have this process in our list? */
+    PRRTE_LIST_FOREACH(proct, &prrte_iof_hnp_component.procs, prrte_iof_proc_t) {
+        if (PRRTE_EQUAL == prrte_util_compare_name_fields(mask, &proct->name, origin)) {
+            /* found it */
+            goto NSTEP;
+        }
+    }
+    /* if we get here, then we don't yet have this proc in our list */
+    proct = PRRTE_NEW(prrte_iof_proc_t);
+    proct->name.jobid = origin->jobid;
+    proct->name.vpid = origin->vpid;
+    prrte_list_append(&prrte_iof_hnp_component.procs, &proct->super);
+
+  NSTEP:
+    /* cycle through the endpoints to see if someone else wants a copy */
+    exclusive = false;
+    if (NULL != proct->subscribers) {
+        PRRTE_LIST_FOREACH(sink, proct->subscribers, prrte_iof_sink_t) {
+            /* if the target isn't set, then this sink is for another purpose - ignore it */
+            if (PRRTE_JOBID_INVALID == sink->daemon.jobid) {
+                continue;
+            }
+            if ((stream & sink->tag) &&
+                sink->name.jobid == origin->jobid &&
+                (PRRTE_VPID_WILDCARD == sink->name.vpid ||
+                 PRRTE_VPID_WILDCARD == origin->vpid ||
+                 sink->name.vpid == origin->vpid)) {
+                /* send the data to the tool */
+                    /* don't pass along zero byte blobs */
+                if (0 < numbytes) {
+                    PRRTE_OUTPUT_VERBOSE((1, prrte_iof_base_framework.framework_output,
+                                         "%s sending data from proc %s of size %d via PMIx to tool %s",
+                                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                                         PRRTE_NAME_PRINT(origin), (int)numbytes,
+                                         PRRTE_NAME_PRINT(&sink->daemon)));
+                    pmix_proc_t source;
+                    pmix_byte_object_t bo;
+                    pmix_iof_channel_t pchan;
+                    prrte_pmix_lock_t lock;
+                    pmix_status_t prc;
+                    PRRTE_PMIX_CONVERT_NAME(rc, &source, origin);
+                    if (PRRTE_SUCCESS != rc) {
+                        PRRTE_ERROR_LOG(rc);
+                    }
+                    pchan = 0;
+                    if (PRRTE_IOF_STDIN & stream) {
+                        pchan |= PMIX_FWD_STDIN_CHANNEL;
+                    }
+                    if (PRRTE_IOF_STDOUT & stream) {
+                        pchan |= PMIX_FWD_STDOUT_CHANNEL;
+                    }
+                    if (PRRTE_IOF_STDERR & stream) {
+                        pchan |= PMIX_FWD_STDERR_CHANNEL;
+                    }
+                    if (PRRTE_IOF_STDDIAG & stream) {
+                        pchan |= PMIX_FWD_STDDIAG_CHANNEL;
+                    }
+                    /* setup the byte object */
+                    PMIX_BYTE_OBJECT_CONSTRUCT(&bo);
+                    bo.bytes = (char*)data;
+                    bo.size = numbytes;
+                    PRRTE_PMIX_CONSTRUCT_LOCK(&lock);
+                    prc = PMIx_server_IOF_deliver(&source, pchan, &bo, NULL, 0, lkcbfunc, (void*)&lock);
+                    if (PMIX_SUCCESS != prc) {
+                        PMIX_ERROR_LOG(prc);
+                    } else {
+                        /* wait for completion */
+                        PRRTE_PMIX_WAIT_THREAD(&lock);
+                    }
+                    PRRTE_PMIX_DESTRUCT_LOCK(&lock);
+                }
+                if (sink->exclusive) {
+                    exclusive = true;
+                }
+            }
+        }
+    }
+    /* if the user doesn't want a copy written to the screen, then we are done */
+    if (!proct->copy) {
+        goto CLEAN_RETURN;
+    }
+
+    /* output this to our local output unless one of the sinks was exclusive */
+    if (!exclusive) {
+        if (PRRTE_IOF_STDOUT & stream || prrte_xml_output) {
+            prrte_iof_base_write_output(origin, stream, data, numbytes, prrte_iof_base.iof_write_stdout->wev);
+        } else {
+            prrte_iof_base_write_output(origin, stream, data, numbytes, prrte_iof_base.iof_write_stderr->wev);
+        }
+    }
+
+ CLEAN_RETURN:
+    if (data != sdata) {
+        free(data);
+    }
+}
+
 void prrte_iof_hnp_recv(int status, prrte_process_name_t* sender,
                        prrte_buffer_t* buffer, prrte_rml_tag_t tag,
                        void* cbdata)
 {
     prrte_process_name_t origin, requestor;
-    unsigned char data[PRRTE_IOF_BASE_MSG_MAX];
     prrte_iof_tag_t stream;
-    int32_t count, numbytes;
+    int32_t count, n, nout;
     prrte_iof_sink_t *sink, *next;
     int rc;
     bool exclusive;
@@ -88,6 +224,29 @@ void prrte_iof_hnp_recv(int status, prrte_process_name_t* sender,
         goto CLEAN_RETURN;
     }
 
+    if (PRRTE_IOF_BATCH & stream) {
+        /* output from several of the daemon's procs */
+        count = 1;
+        if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &nout, &count, PRRTE_INT32))) {
+            PRRTE_ERROR_LOG(rc);
+            goto CLEAN_RETURN;
+        }
+        for (n=0; n < nout; n++) {
+            count = 1;
+            if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &stream, &count, PRRTE_IOF_TAG))) {
+                PRRTE_ERROR_LOG(rc);
+                goto CLEAN_RETURN;
+            }
+            count = 1;
+            if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &origin, &count, PRRTE_NAME))) {
+                PRRTE_ERROR_LOG(rc);
+                goto CLEAN_RETURN;
+            }
+            deliver_output(buffer, stream, &origin);
+        }
+        goto CLEAN_RETURN;
+    }
+
     if (PRRTE_IOF_XON & stream) {
         /* re-start the stdin read event */
         if (NULL != prrte_iof_hnp_component.stdinev &&
@@ -218,109 +377,8 @@ void prrte_iof_hnp_recv(int status, prrte_process_name_t* sender,
         goto CLEAN_RETURN;
     }
 
-    /* this must have come from a daemon forwarding output - unpack the data */
-    numbytes=PRRTE_IOF_BASE_MSG_MAX;
-    if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, data, &numbytes, PRRTE_BYTE))) {
-        PRRTE_ERROR_LOG(rc);
-        goto CLEAN_RETURN;
-    }
-    /* numbytes will contain the actual #bytes that were sent */
-
-    PRRTE_OUTPUT_VERBOSE((1, prrte_iof_base_framework.framework_output,
-                         "%s unpacked %d bytes from remote proc %s",
-                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), numbytes,
-                         PRRTE_NAME_PRINT(&origin)));
-
-    /* do we already have this process in our list? */
-    PRRTE_LIST_FOREACH(proct, &prrte_iof_hnp_component.procs, prrte_iof_proc_t) {
-        if (PRRTE_EQUAL == prrte_util_compare_name_fields(mask, &proct->name, &origin)) {
-            /* found it */
-            goto NSTEP;
-        }
-    }
-    /* if we get here, then we don't yet have this proc in our list */
-    proct = PRRTE_NEW(prrte_iof_proc_t);
-    proct->name.jobid = origin.jobid;
-    proct->name.vpid = origin.vpid;
-    prrte_list_append(&prrte_iof_hnp_component.procs, &proct->super);
-
-  NSTEP:
-    /* cycle through the endpoints to see if someone else wants a copy */
-    exclusive = false;
-    if (NULL != proct->subscribers) {
-        PRRTE_LIST_FOREACH(sink, proct->subscribers, prrte_iof_sink_t) {
-            /* if the target isn't set, then this sink is for another purpose - ignore it */
-            if (PRRTE_JOBID_INVALID == sink->daemon.jobid) {
-                continue;
-            }
-            if ((stream & sink->tag) &&
-                sink->name.jobid == origin.jobid &&
-                (PRRTE_VPID_WILDCARD == sink->name.vpid ||
-                 PRRTE_VPID_WILDCARD == origin.vpid ||
-                 sink->name.vpid == origin.vpid)) {
-                /* send the data to the tool */
-                    /* don't pass along zero byte blobs */
-                if (0 < numbytes) {
-                    PRRTE_OUTPUT_VERBOSE((1, prrte_iof_base_framework.framework_output,
-                                         "%s sending data from proc %s of size %d via PMIx to tool %s",
-                                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
-                                         PRRTE_NAME_PRINT(&origin), (int)numbytes,
-                                         PRRTE_NAME_PRINT(&sink->daemon)));
-                    pmix_proc_t source;
-                    pmix_byte_object_t bo;
-                    pmix_iof_channel_t pchan;
-                    prrte_pmix_lock_t lock;
-                    pmix_status_t prc;
-                    PRRTE_PMIX_CONVERT_NAME(rc, &source, &origin);
-                    if (PRRTE_SUCCESS != rc) {
-                        PRRTE_ERROR_LOG(rc);
-                    }
-                    pchan = 0;
-                    if (PRRTE_IOF_STDIN & stream) {
-                        pchan |= PMIX_FWD_STDIN_CHANNEL;
-                    }
-                    if (PRRTE_IOF_STDOUT & stream) {
-                        pchan |= PMIX_FWD_STDOUT_CHANNEL;
-                    }
-                    if (PRRTE_IOF_STDERR & stream) {
-                        pchan |= PMIX_FWD_STDERR_CHANNEL;
-                    }
-                    if (PRRTE_IOF_STDDIAG & stream) {
-                        pchan |= PMIX_FWD_STDDIAG_CHANNEL;
-                    }
-                    /* setup the byte object */
-                    PMIX_BYTE_OBJECT_CONSTRUCT(&bo);
-                    bo.bytes = (char*)data;
-                    bo.size = numbytes;
-                    PRRTE_PMIX_CONSTRUCT_LOCK(&lock);
-                    prc = PMIx_server_IOF_deliver(&source, pchan, &bo, NULL, 0, lkcbfunc, (void*)&lock);
-                    if (PMIX_SUCCESS != prc) {
-                        PMIX_ERROR_LOG(prc);
-                    } else {
-                        /* wait for completion */
-                        PRRTE_PMIX_WAIT_THREAD(&lock);
-                    }
-                    PRRTE_PMIX_DESTRUCT_LOCK(&lock);
-                }
-                if (sink->exclusive) {
-                    exclusive = true;
-                }
-            }
-        }
-    }
-    /* if the user doesn't want a copy written to the screen, then we are done */
-    if (!proct->copy) {
-        return;
-    }
-
-    /* output this to our local output unless one of the sinks was exclusive */
-    if (!exclusive) {
-        if (PRRTE_IOF_STDOUT & stream || prrte_xml_output) {
-            prrte_iof_base_write_output(&origin, stream, data, numbytes, prrte_iof_base.iof_write_stdout->wev);
-        } else {
-            prrte_iof_base_write_output(&origin, stream, data, numbytes, prrte_iof_base.iof_write_stderr->wev);
-        }
-    }
+    /* this must have come from a daemon forwarding output */
+    deliver_output(buffer, stream, &origin);
 
  CLEAN_RETURN:
     return;
@@ -42,6 +42,8 @@ typedef uint16_t prrte_iof_tag_t;
 #define PRRTE_IOF_STDOUTALL  0x000e
 #define PRRTE_IOF_STDALL     0x000f
 #define PRRTE_IOF_EXCLUSIVE  0x0100
+/* output from multiple procs in one message */
+#define PRRTE_IOF_BATCH      0x0200
 
 /* flow control flags */
 #define PRRTE_IOF_XON        0x1000
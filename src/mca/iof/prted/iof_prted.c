@@ -115,6 +115,13 @@ static int init(void)
     /* setup the local global variables */
     PRRTE_CONSTRUCT(&prrte_iof_prted_component.procs, prrte_list_t);
     prrte_iof_prted_component.xoff = false;
+    prrte_iof_prted_component.batch = NULL;
+    prrte_iof_prted_component.nbatch = 0;
+    prrte_iof_prted_component.batch_pending = false;
+    prrte_iof_prted_component.batch_ev = prrte_event_alloc();
+    prrte_event_evtimer_set(prrte_event_base, prrte_iof_prted_component.batch_ev,
+                           prrte_iof_prted_batch_timeout, NULL);
+    prrte_event_set_priority(prrte_iof_prted_component.batch_ev, PRRTE_MSG_PRI);
 
     return PRRTE_SUCCESS;
 }
@@ -337,6 +344,10 @@ static int finalize(void)
     }
     PRRTE_DESTRUCT(&prrte_iof_prted_component.procs);
 
+    /* forward anything we were still holding */
+    prrte_iof_prted_flush();
+    prrte_event_free(prrte_iof_prted_component.batch_ev);
+
     /* Cancel the RML receive */
     prrte_rml.recv_cancel(PRRTE_NAME_WILDCARD, PRRTE_RML_TAG_IOF_PROXY);
     return PRRTE_SUCCESS;
@@ -452,6 +463,7 @@ static int prted_output(const prrte_process_name_t* peer,
                         const char *msg)
 {
     prrte_buffer_t *buf;
+    int32_t numbytes = strlen(msg) + 1;
     int rc;
 
     /* prep the buffer */
@@ -471,9 +483,16 @@ static int prted_output(const prrte_process_name_t* peer,
         return rc;
     }
 
+    /* the HNP reads the size before the data, just as it
+     * does for output we read from the procs */
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buf, &numbytes, 1, PRRTE_INT32))) {
+        PRRTE_ERROR_LOG(rc);
+        return rc;
+    }
+
     /* pack the data - for compatibility, we have to pack this as PRRTE_BYTE,
      * so ensure we include the NULL string terminator */
-    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buf, msg, strlen(msg)+1, PRRTE_BYTE))) {
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buf, msg, numbytes, PRRTE_BYTE))) {
         PRRTE_ERROR_LOG(rc);
         return rc;
     }
@@ -481,7 +500,7 @@ static int prted_output(const prrte_process_name_t* peer,
     /* start non-blocking RML call to forward received data */
     PRRTE_OUTPUT_VERBOSE((1, prrte_iof_base_framework.framework_output,
                          "%s iof:prted:output sending %d bytes to HNP",
-                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), (int)strlen(msg)+1));
+                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), (int)numbytes));
 
     prrte_rml.send_buffer_nb(PRRTE_PROC_MY_HNP, buf, PRRTE_RML_TAG_IOF_HNP,
                             prrte_rml_send_callback, NULL);
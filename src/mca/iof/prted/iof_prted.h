@@ -53,6 +53,7 @@
 
 #include "src/class/prrte_list.h"
 
+#include "src/event/event-internal.h"
 #include "src/mca/rml/rml_types.h"
 #include "src/dss/dss.h"
 #include "src/mca/iof/iof.h"
@@ -66,6 +67,13 @@ struct prrte_iof_prted_component_t {
     prrte_iof_base_component_t super;
     prrte_list_t procs;
     bool xoff;
+    /* aggregation of output from the local procs */
+    int aggregate_bytes;
+    int aggregate_window;
+    prrte_buffer_t *batch;
+    int32_t nbatch;
+    prrte_event_t *batch_ev;
+    bool batch_pending;
 };
 typedef struct prrte_iof_prted_component_t prrte_iof_prted_component_t;
 
@@ -78,6 +86,8 @@ void prrte_iof_prted_recv(int status, prrte_process_name_t* sender,
 
 void prrte_iof_prted_read_handler(int fd, short event, void *data);
 void prrte_iof_prted_send_xonxoff(prrte_iof_tag_t tag);
+void prrte_iof_prted_flush(void);
+void prrte_iof_prted_batch_timeout(int fd, short event, void *cbdata);
 
 END_C_DECLS
 
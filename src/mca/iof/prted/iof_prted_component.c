@@ -37,6 +37,7 @@
 static int prrte_iof_prted_open(void);
 static int prrte_iof_prted_close(void);
 static int prrte_iof_prted_query(prrte_mca_base_module_t **module, int *priority);
+static int prrte_iof_prted_register(void);
 
 
 /*
@@ -59,6 +60,7 @@ prrte_iof_prted_component_t prrte_iof_prted_component = {
             .mca_open_component = prrte_iof_prted_open,
             .mca_close_component = prrte_iof_prted_close,
             .mca_query_component = prrte_iof_prted_query,
+            .mca_register_component_params = prrte_iof_prted_register,
         },
         .iof_data = {
             /* The component is checkpoint ready */
@@ -67,6 +69,32 @@ prrte_iof_prted_component_t prrte_iof_prted_component = {
     }
 };
 
+static int prrte_iof_prted_register(void)
+{
+    prrte_mca_base_component_t *c = &prrte_iof_prted_component.super.iof_version;
+
+    prrte_iof_prted_component.aggregate_bytes = 65536;
+    (void) prrte_mca_base_component_var_register(c, "aggregate_bytes",
+                                           "Number of bytes of output from the local procs to collect before forwarding them to the HNP in a single message (0 = forward each read as it occurs)",
+                                           PRRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           PRRTE_INFO_LVL_9,
+                                           PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                           &prrte_iof_prted_component.aggregate_bytes);
+
+    prrte_iof_prted_component.aggregate_window = 1000;
+    (void) prrte_mca_base_component_var_register(c, "aggregate_window",
+                                           "Maximum time (in microseconds) to hold collected output before forwarding it to the HNP",
+                                           PRRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           PRRTE_INFO_LVL_9,
+                                           PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                           &prrte_iof_prted_component.aggregate_window);
+    if (prrte_iof_prted_component.aggregate_window < 0) {
+        prrte_iof_prted_component.aggregate_window = 0;
+    }
+
+    return PRRTE_SUCCESS;
+}
+
 /**
   * component open/close/init function
   */
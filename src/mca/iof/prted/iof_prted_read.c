@@ -44,10 +44,135 @@
 
 #include "iof_prted.h"
 
+static int pack_output(prrte_buffer_t *buf, prrte_iof_tag_t tag,
+                       prrte_process_name_t *name,
+                       unsigned char *data, int32_t numbytes)
+{
+    int rc;
+
+    /* pack the stream first - we do this so that flow control messages can
+     * consist solely of the tag
+     */
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buf, &tag, 1, PRRTE_IOF_TAG))) {
+        PRRTE_ERROR_LOG(rc);
+        return rc;
+    }
+
+    /* pack name of process that gave us this data */
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buf, name, 1, PRRTE_NAME))) {
+        PRRTE_ERROR_LOG(rc);
+        return rc;
+    }
+
+    /* the read size varies, so tell the HNP how much is coming */
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buf, &numbytes, 1, PRRTE_INT32))) {
+        PRRTE_ERROR_LOG(rc);
+        return rc;
+    }
+
+    /* pack the data - only pack the #bytes we read! */
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buf, data, numbytes, PRRTE_BYTE))) {
+        PRRTE_ERROR_LOG(rc);
+        return rc;
+    }
+    return PRRTE_SUCCESS;
+}
+
+/* forward everything we have collected to the HNP in one message */
+void prrte_iof_prted_flush(void)
+{
+    prrte_iof_prted_component_t *c = &prrte_iof_prted_component;
+    prrte_iof_tag_t tag = PRRTE_IOF_BATCH;
+    prrte_buffer_t *buf;
+    int rc;
+
+    if (c->batch_pending) {
+        prrte_event_evtimer_del(c->batch_ev);
+        c->batch_pending = false;
+    }
+    if (NULL == c->batch) {
+        return;
+    }
+    if (0 == c->nbatch) {
+        PRRTE_RELEASE(c->batch);
+        c->batch = NULL;
+        return;
+    }
+
+    buf = PRRTE_NEW(prrte_buffer_t);
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buf, &tag, 1, PRRTE_IOF_TAG))) {
+        PRRTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buf, &c->nbatch, 1, PRRTE_INT32))) {
+        PRRTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    if (PRRTE_SUCCESS != (rc = prrte_dss.copy_payload(buf, c->batch))) {
+        PRRTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+
+    PRRTE_OUTPUT_VERBOSE((1, prrte_iof_base_framework.framework_output,
+                         "%s iof:prted sending %d outputs (%d bytes) to HNP",
+                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                         c->nbatch, (int)c->batch->bytes_used));
+
+    if (0 > (rc = prrte_rml.send_buffer_nb(PRRTE_PROC_MY_HNP, buf, PRRTE_RML_TAG_IOF_HNP,
+                                          prrte_rml_send_callback, NULL))) {
+        PRRTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    buf = NULL;
+
+  cleanup:
+    if (NULL != buf) {
+        PRRTE_RELEASE(buf);
+    }
+    PRRTE_RELEASE(c->batch);
+    c->batch = NULL;
+    c->nbatch = 0;
+}
+
+void prrte_iof_prted_batch_timeout(int fd, short event, void *cbdata)
+{
+    prrte_iof_prted_component.batch_pending = false;
+    prrte_iof_prted_flush();
+}
+
+/* add the output to the collection from our local procs - it is
+ * forwarded once enough has been collected or the window expires */
+static void batch_output(prrte_iof_tag_t tag, prrte_process_name_t *name,
+                         unsigned char *data, int32_t numbytes)
+{
+    prrte_iof_prted_component_t *c = &prrte_iof_prted_component;
+    struct timeval tv;
+
+    if (NULL == c->batch) {
+        c->batch = PRRTE_NEW(prrte_buffer_t);
+    }
+    if (PRRTE_SUCCESS != pack_output(c->batch, tag, name, data, numbytes)) {
+        return;
+    }
+    c->nbatch++;
+
+    if (c->aggregate_bytes <= (int)c->batch->bytes_used ||
+        0 == c->aggregate_window) {
+        prrte_iof_prted_flush();
+        return;
+    }
+    if (!c->batch_pending) {
+        tv.tv_sec = c->aggregate_window / 1000000;
+        tv.tv_usec = c->aggregate_window % 1000000;
+        c->batch_pending = true;
+        prrte_event_evtimer_add(c->batch_ev, &tv);
+    }
+}
+
 void prrte_iof_prted_read_handler(int fd, short event, void *cbdata)
 {
     prrte_iof_read_event_t *rev = (prrte_iof_read_event_t*)cbdata;
-    unsigned char data[PRRTE_IOF_BASE_MSG_MAX];
+    unsigned char *data;
     prrte_buffer_t *buf=NULL;
     int rc;
     int32_t numbytes;
@@ -60,8 +185,9 @@ void prrte_iof_prted_read_handler(int fd, short event, void *cbdata)
      */
     fd = rev->fd;
 
-    /* read up to the fragment size */
-    numbytes = read(fd, data, sizeof(data));
+    /* read up to the current read size */
+    numbytes = prrte_iof_base_read(rev);
+    data = rev->data;
 
     if (NULL == proct) {
         /* nothing we can do */
@@ -103,26 +229,17 @@ void prrte_iof_prted_read_handler(int fd, short event, void *cbdata)
         return;
     }
 
-    /* prep the buffer */
-    buf = PRRTE_NEW(prrte_buffer_t);
-
-    /* pack the stream first - we do this so that flow control messages can
-     * consist solely of the tag
-     */
-    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buf, &rev->tag, 1, PRRTE_IOF_TAG))) {
-        PRRTE_ERROR_LOG(rc);
-        goto CLEAN_RETURN;
-    }
-
-    /* pack name of process that gave us this data */
-    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buf, &proct->name, 1, PRRTE_NAME))) {
-        PRRTE_ERROR_LOG(rc);
-        goto CLEAN_RETURN;
+    if (0 < prrte_iof_prted_component.aggregate_bytes) {
+        /* collect it with the output from our other procs */
+        batch_output(rev->tag, &proct->name, data, numbytes);
+        /* re-add the event */
+        PRRTE_IOF_READ_ACTIVATE(rev);
+        return;
     }
 
-    /* pack the data - only pack the #bytes we read! */
-    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buf, &data, numbytes, PRRTE_BYTE))) {
-        PRRTE_ERROR_LOG(rc);
+    /* prep the buffer */
+    buf = PRRTE_NEW(prrte_buffer_t);
+    if (PRRTE_SUCCESS != (rc = pack_output(buf, rev->tag, &proct->name, data, numbytes))) {
         goto CLEAN_RETURN;
     }
 
@@ -140,6 +257,9 @@ void prrte_iof_prted_read_handler(int fd, short event, void *cbdata)
     return;
 
  CLEAN_RETURN:
+    /* ensure the HNP gets everything this proc output before
+     * it hears that the proc is done */
+    prrte_iof_prted_flush();
     /* must be an error, or zero bytes were read indicating that the
      * proc terminated this IOF channel - either way, release the
      * corresponding event. This deletes the read event and closes
@@ -889,23 +889,16 @@ static int compute_num_procs_alive(prrte_jobid_t job)
     return num_procs_alive;
 }
 
-void prrte_odls_base_spawn_proc(int fd, short sd, void *cbdata)
+/* build the environment shared by all procs of this app */
+static prrte_odls_env_template_t* build_env_template(prrte_app_context_t *app)
 {
-    prrte_odls_spawn_caddy_t *cd = (prrte_odls_spawn_caddy_t*)cbdata;
-    prrte_job_t *jobdat = cd->jdata;
-    prrte_app_context_t *app = cd->app;
-    prrte_proc_t *child = cd->child;
-    int rc, i;
-    bool found;
-    prrte_proc_state_t state;
-    pmix_proc_t pproc;
-    pmix_status_t ret;
+    prrte_odls_env_template_t *tmpl;
     char *ptr;
+    size_t len;
+    int i;
 
-    PRRTE_ACQUIRE_OBJECT(cd);
-
-    /* thread-protect common values */
-    cd->env = prrte_argv_copy(prrte_launch_environ);
+    tmpl = PRRTE_NEW(prrte_odls_env_template_t);
+    tmpl->env = prrte_argv_copy(prrte_launch_environ);
     if (NULL != app->env) {
         for (i=0; NULL != app->env[i]; i++) {
             /* find the '=' sign.
@@ -916,21 +909,104 @@ void prrte_odls_base_spawn_proc(int fd, short sd, void *cbdata)
             ptr = strchr(tmp, '=');
             *ptr = '\0';
             ++ptr;
-            prrte_setenv(tmp, ptr, true, &cd->env);
+            prrte_setenv(tmp, ptr, true, &tmpl->env);
             free(tmp);
         }
     }
 
+    /* index the names so the per-proc values can find
+     * what they replace without scanning the list */
+    tmpl->nenv = prrte_argv_count(tmpl->env);
+    prrte_hash_table_init(&tmpl->index, 2 * tmpl->nenv + 1);
+    for (i=0; i < tmpl->nenv; i++) {
+        if (NULL == (ptr = strchr(tmpl->env[i], '='))) {
+            len = strlen(tmpl->env[i]);
+        } else {
+            len = ptr - tmpl->env[i];
+        }
+        prrte_hash_table_set_value_ptr(&tmpl->index, tmpl->env[i], len,
+                                       (void*)(uintptr_t)(i + 1));
+    }
+    return tmpl;
+}
+
+/* assemble the environment of a proc from the app's template
+ * and the values specific to this proc. The overlay strings
+ * are moved into the result and the overlay array is freed */
+static int apply_env_overlay(prrte_odls_env_template_t *tmpl,
+                             char **overlay, char ***env)
+{
+    char **result, *ptr;
+    void *val;
+    size_t len;
+    int i, n, noverlay;
+
+    noverlay = prrte_argv_count(overlay);
+    result = (char**)calloc(tmpl->nenv + noverlay + 1, sizeof(char*));
+    if (NULL == result) {
+        prrte_argv_free(overlay);
+        return PRRTE_ERR_OUT_OF_RESOURCE;
+    }
+
+    /* put each proc-specific value in the slot of the
+     * template entry it replaces, if any */
+    n = tmpl->nenv;
+    for (i=0; i < noverlay; i++) {
+        if (NULL == (ptr = strchr(overlay[i], '='))) {
+            len = strlen(overlay[i]);
+        } else {
+            len = ptr - overlay[i];
+        }
+        if (PRRTE_SUCCESS == prrte_hash_table_get_value_ptr(&tmpl->index, overlay[i],
+                                                            len, &val)) {
+            result[(uintptr_t)val - 1] = overlay[i];
+        } else {
+            result[n++] = overlay[i];
+        }
+    }
+    if (NULL != overlay) {
+        free(overlay);
+    }
+
+    /* everything else comes from the template */
+    for (i=0; i < tmpl->nenv; i++) {
+        if (NULL == result[i]) {
+            result[i] = strdup(tmpl->env[i]);
+        }
+    }
+
+    *env = result;
+    return PRRTE_SUCCESS;
+}
+
+void prrte_odls_base_spawn_proc(int fd, short sd, void *cbdata)
+{
+    prrte_odls_spawn_caddy_t *cd = (prrte_odls_spawn_caddy_t*)cbdata;
+    prrte_job_t *jobdat = cd->jdata;
+    prrte_app_context_t *app = cd->app;
+    prrte_proc_t *child = cd->child;
+    int rc, i;
+    bool found;
+    prrte_proc_state_t state;
+    pmix_proc_t pproc;
+    pmix_status_t ret;
+    char **overlay = NULL;
+
+    PRRTE_ACQUIRE_OBJECT(cd);
+
     /* ensure we clear any prior info regarding state or exit status in
      * case this is a restart
      */
     child->exit_code = 0;
     PRRTE_FLAG_UNSET(child, PRRTE_PROC_FLAG_WAITPID);
 
-    /* setup the pmix environment */
+    /* setup the pmix environment - the values it provides are
+     * specific to this proc, so collect them in the overlay that
+     * goes on top of the app's shared environment */
     PMIX_LOAD_PROCID(&pproc, child->job->nspace, child->name.vpid);
-    if (PMIX_SUCCESS != (ret = PMIx_server_setup_fork(&pproc, &cd->env))) {
+    if (PMIX_SUCCESS != (ret = PMIx_server_setup_fork(&pproc, &overlay))) {
         PMIX_ERROR_LOG(ret);
+        prrte_argv_free(overlay);
         rc = PRRTE_ERROR;
         state = PRRTE_PROC_STATE_FAILED_TO_LAUNCH;
         goto errorout;
@@ -953,7 +1029,13 @@ void prrte_odls_base_spawn_proc(int fd, short sd, void *cbdata)
     /* setup the rest of the environment with the proc-specific items - these
      * will be overwritten for each child
      */
-    if (PRRTE_SUCCESS != (rc = prrte_schizo.setup_child(jobdat, child, app, &cd->env))) {
+    if (PRRTE_SUCCESS != (rc = prrte_schizo.setup_child(jobdat, child, app, &overlay))) {
+        PRRTE_ERROR_LOG(rc);
+        prrte_argv_free(overlay);
+        state = PRRTE_PROC_STATE_FAILED_TO_LAUNCH;
+        goto errorout;
+    }
+    if (PRRTE_SUCCESS != (rc = apply_env_overlay(cd->envtmp, overlay, &cd->env))) {
         PRRTE_ERROR_LOG(rc);
         state = PRRTE_PROC_STATE_FAILED_TO_LAUNCH;
         goto errorout;
@@ -1073,6 +1155,7 @@ void prrte_odls_base_default_launch_local(int fd, short sd, void *cbdata)
     char **argvptr;
     char *pathenv = NULL, *mpiexec_pathenv = NULL;
     char *full_search;
+    prrte_odls_env_template_t *envtmp = NULL;
 
     PRRTE_ACQUIRE_OBJECT(caddy);
 
@@ -1397,10 +1480,18 @@ void prrte_odls_base_default_launch_local(int fd, short sd, void *cbdata)
             PRRTE_FLAG_SET(child, PRRTE_PROC_FLAG_ALIVE);
             prrte_wait_cb(child, prrte_odls_base_default_wait_local_proc, evb, NULL);
 
+            /* the environment common to all procs of this app
+             * only needs to be built once */
+            if (NULL == envtmp) {
+                envtmp = build_env_template(app);
+            }
+
             /* dispatch this child to the next available launch thread */
             cd = PRRTE_NEW(prrte_odls_spawn_caddy_t);
             cd->jdata = jobdat;
             cd->app = app;
+            PRRTE_RETAIN(envtmp);
+            cd->envtmp = envtmp;
             cd->wdir = strdup(app->cwd);
             cd->child = child;
             cd->fork_local = fork_local;
@@ -1443,9 +1534,16 @@ void prrte_odls_base_default_launch_local(int fd, short sd, void *cbdata)
             prrte_event_active(&cd->ev, PRRTE_EV_WRITE, 1);
 
         }
+        if (NULL != envtmp) {
+            PRRTE_RELEASE(envtmp);
+            envtmp = NULL;
+        }
     }
 
   GETOUT:
+    if (NULL != envtmp) {
+        PRRTE_RELEASE(envtmp);
+    }
 
   ERROR_OUT:
     /* ensure we reset our working directory back to our default location  */
@@ -2097,6 +2195,7 @@ int prrte_odls_base_default_restart_proc(prrte_proc_t *child,
     }
     cd->jdata = jobdat;
     cd->app = app;
+    cd->envtmp = build_env_template(app);
     cd->child = child;
     cd->fork_local = fork_local;
     /* setup any IOF */
@@ -333,6 +333,23 @@ PRRTE_CLASS_INSTANCE(prrte_odls_launch_local_t,
                    launch_local_const,
                    launch_local_dest);
 
+static void etcon(prrte_odls_env_template_t *p)
+{
+    p->env = NULL;
+    p->nenv = 0;
+    PRRTE_CONSTRUCT(&p->index, prrte_hash_table_t);
+}
+static void etdes(prrte_odls_env_template_t *p)
+{
+    if (NULL != p->env) {
+        prrte_argv_free(p->env);
+    }
+    PRRTE_DESTRUCT(&p->index);
+}
+PRRTE_CLASS_INSTANCE(prrte_odls_env_template_t,
+                   prrte_object_t,
+                   etcon, etdes);
+
 static void sccon(prrte_odls_spawn_caddy_t *p)
 {
     memset(&p->opts, 0, sizeof(prrte_iof_base_io_conf_t));
@@ -340,6 +357,7 @@ static void sccon(prrte_odls_spawn_caddy_t *p)
     p->wdir = NULL;
     p->argv = NULL;
     p->env = NULL;
+    p->envtmp = NULL;
 }
 static void scdes(prrte_odls_spawn_caddy_t *p)
 {
@@ -355,6 +373,9 @@ static void scdes(prrte_odls_spawn_caddy_t *p)
     if (NULL != p->env) {
         prrte_argv_free(p->env);
     }
+    if (NULL != p->envtmp) {
+        PRRTE_RELEASE(p->envtmp);
+    }
 }
 PRRTE_CLASS_INSTANCE(prrte_odls_spawn_caddy_t,
                    prrte_object_t,
@@ -37,6 +37,7 @@
 #include "src/class/prrte_list.h"
 #include "src/class/prrte_pointer_array.h"
 #include "src/class/prrte_bitmap.h"
+#include "src/class/prrte_hash_table.h"
 #include "src/dss/dss_types.h"
 
 #include "src/mca/iof/base/iof_base_setup.h"
@@ -91,6 +92,19 @@ PRRTE_EXPORT void prrte_odls_base_spawn_proc(int fd, short sd, void *cbdata);
 /* define a function that will fork a local proc */
 typedef int (*prrte_odls_base_fork_local_proc_fn_t)(void *cd);
 
+/* define an object holding the environment shared by all
+ * procs of an app on this node - it is built once when the
+ * app is launched and then only read by the launch threads,
+ * so each child just adds its own proc-specific values */
+typedef struct {
+    prrte_object_t super;
+    char **env;
+    int nenv;
+    /* name of each envar -> (its position in env) + 1 */
+    prrte_hash_table_t index;
+} prrte_odls_env_template_t;
+PRRTE_CLASS_DECLARATION(prrte_odls_env_template_t);
+
 /* define an object for fork/exec the local proc */
 typedef struct {
     prrte_object_t super;
@@ -99,6 +113,7 @@ typedef struct {
     char *wdir;
     char **argv;
     char **env;
+    prrte_odls_env_template_t *envtmp;
     prrte_job_t *jdata;
     prrte_app_context_t *app;
     prrte_proc_t *child;
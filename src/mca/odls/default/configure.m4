@@ -28,6 +28,9 @@ AC_DEFUN([MCA_prrte_odls_default_CONFIG],[
 
     AC_CHECK_FUNC([fork], [odls_default_happy="yes"], [odls_default_happy="no"])
 
+    # clone lets us start procs without copying the daemon's page tables
+    AC_CHECK_FUNCS([clone])
+
     AS_IF([test "$odls_default_happy" = "yes"], [$1], [$2])
 
 ])dnl
@@ -33,6 +33,19 @@
 
 BEGIN_C_DECLS
 
+/* can we start procs with clone(CLONE_VM|CLONE_VFORK)? */
+#if defined(__linux__) && defined(HAVE_CLONE) && defined(HAVE_SYS_MMAN_H)
+#define PRRTE_ODLS_DEFAULT_HAVE_VFORK 1
+#else
+#define PRRTE_ODLS_DEFAULT_HAVE_VFORK 0
+#endif
+
+/* stack for the vfork'd child to run do_child on */
+#define PRRTE_ODLS_DEFAULT_VFORK_STACK (512 * 1024)
+
+/* start procs with vfork instead of fork where we can */
+extern bool prrte_odls_default_use_vfork;
+
 /*
  * Module open / close
  */
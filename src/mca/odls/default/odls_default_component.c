@@ -39,11 +39,16 @@
 
 #include "src/mca/mca.h"
 #include "src/mca/base/base.h"
+#include "src/util/fd.h"
 
 #include "src/mca/odls/odls.h"
 #include "src/mca/odls/base/odls_private.h"
 #include "src/mca/odls/default/odls_default.h"
 
+static int odls_default_register(void);
+
+bool prrte_odls_default_use_vfork = false;
+
 /*
  * Instantiate the public struct with all of our public information
  * and pointers to our public functions in it
@@ -63,6 +68,7 @@ prrte_odls_base_component_t prrte_odls_default_component = {
         .mca_open_component = prrte_odls_default_component_open,
         .mca_close_component = prrte_odls_default_component_close,
         .mca_query_component = prrte_odls_default_component_query,
+        .mca_register_component_params = odls_default_register,
     },
     .base_data = {
         /* The component is checkpoint ready */
@@ -72,8 +78,34 @@ prrte_odls_base_component_t prrte_odls_default_component = {
 
 
 
+static int odls_default_register(void)
+{
+    prrte_mca_base_component_t *c = &prrte_odls_default_component.version;
+
+    prrte_odls_default_use_vfork = false;
+    (void) prrte_mca_base_component_var_register(c, "use_vfork",
+                                                 "Start local procs with vfork (via clone) instead of fork where supported, "
+                                                 "avoiding a copy of the daemon's page tables for every launch. The child "
+                                                 "still binds itself and sets up its IOF before the exec, which can allocate "
+                                                 "from the daemon's heap while the daemon's other threads are running - only "
+                                                 "enable this if launch time matters more than that risk [default: false]",
+                                                 PRRTE_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                                 PRRTE_INFO_LVL_9,
+                                                 PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                                 &prrte_odls_default_use_vfork);
+    return PRRTE_SUCCESS;
+}
+
 int prrte_odls_default_component_open(void)
 {
+#if PRRTE_ODLS_DEFAULT_HAVE_VFORK
+    /* a vfork'd child can't fall back to scanning /proc for
+     * the fds it has to close, so stick with fork unless the
+     * kernel gives us close_range */
+    if (prrte_odls_default_use_vfork && !prrte_fd_have_close_range()) {
+        prrte_odls_default_use_vfork = false;
+    }
+#endif
     return PRRTE_SUCCESS;
 }
 
@@ -112,7 +112,9 @@
 #ifdef HAVE_SYS_PTRACE_H
 #include <sys/ptrace.h>
 #endif
-
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
 #include "src/hwloc/hwloc-internal.h"
 #include "src/hwloc/hwloc-internal.h"
 #include "src/class/prrte_pointer_array.h"
@@ -137,6 +139,10 @@
 #include "src/mca/odls/default/odls_default.h"
 #include "src/prted/pmix/pmix_server.h"
 
+#if PRRTE_ODLS_DEFAULT_HAVE_VFORK
+#include <sched.h>
+#endif
+
 /*
  * Module functions (function pointers used in a struct)
  */
@@ -293,7 +299,9 @@ static void send_error_show_help(int fd, int exit_status,
     write_help_msg(fd, &msg, file, topic, ap);
     va_end(ap);
 
-    exit(exit_status);
+    /* use _exit so a vfork'd child doesn't run our atexit
+     * handlers or flush our stdio buffers */
+    _exit(exit_status);
 }
 
 static int do_child(prrte_odls_spawn_caddy_t *cd, int write_fd)
@@ -356,12 +364,6 @@ static int do_child(prrte_odls_spawn_caddy_t *cd, int write_fd)
        the parent. */
     prrte_close_open_file_descriptors(write_fd);
 
-    if (cd->argv == NULL) {
-        cd->argv = malloc(sizeof(char*)*2);
-        cd->argv[0] = strdup(cd->app->app);
-        cd->argv[1] = NULL;
-    }
-
     /* Set signal handlers back to the default.  Do this close to
        the exev() because the event library may (and likely will)
        reset them.  If we don't do this, the event library may
@@ -418,19 +420,19 @@ static int do_child(prrte_odls_spawn_caddy_t *cd, int write_fd)
     /* If we get here, an error has occurred. */
     (void) getcwd(dir, sizeof(dir));
     struct stat stats;
-    char* msg;
+    /* don't allocate - we may be sharing the daemon's heap */
+    char msg[MAXPATHLEN + 64];
     /* If errno is ENOENT, that indicates either cd->cmd does not exist, or
      * cd->cmd is a script, but has a bad interpreter specified. */
     if (ENOENT == errno && 0 == stat(cd->app->app, &stats)) {
-        asprintf(&msg, "%s has a bad interpreter on the first line.",
+        snprintf(msg, sizeof(msg), "%s has a bad interpreter on the first line.",
                  cd->app->app);
     } else {
-        msg = strdup(strerror(errno));
+        snprintf(msg, sizeof(msg), "%s", strerror(errno));
     }
     send_error_show_help(write_fd, 1,
                          "help-prrte-odls-default.txt", "execve error",
                          prrte_process_info.nodename, dir, cd->app->app, msg);
-    free(msg);
 }
 
 
@@ -605,6 +607,55 @@ static int do_parent(prrte_odls_spawn_caddy_t *cd, int read_fd)
 }
 
 
+#if PRRTE_ODLS_DEFAULT_HAVE_VFORK
+typedef struct {
+    prrte_odls_spawn_caddy_t *cd;
+    int *p;
+} vfork_caddy_t;
+
+static int vfork_child(void *arg)
+{
+    vfork_caddy_t *vc = (vfork_caddy_t*)arg;
+
+    close(vc->p[0]);
+    do_child(vc->cd, vc->p[1]);
+    /* Does not return */
+}
+
+/* Start the child with clone(CLONE_VM|CLONE_VFORK) - this is what
+ * posix_spawn does under the covers, but we need to run do_child
+ * before the exec so we can't use posix_spawn itself. The child
+ * borrows our address space until it execs (or _exits), so we
+ * don't pay for copying the page tables of a large daemon. We
+ * are suspended until then, and all signals are blocked in the
+ * meantime so none of our handlers can run on the child's stack */
+static pid_t vfork_local_proc(prrte_odls_spawn_caddy_t *cd, int *p)
+{
+    vfork_caddy_t vc;
+    sigset_t sigs, oldsigs;
+    char *stack;
+    pid_t pid;
+
+    stack = mmap(NULL, PRRTE_ODLS_DEFAULT_VFORK_STACK, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+    if (MAP_FAILED == stack) {
+        return -1;
+    }
+    vc.cd = cd;
+    vc.p = p;
+
+    sigfillset(&sigs);
+    pthread_sigmask(SIG_SETMASK, &sigs, &oldsigs);
+    /* the stack grows down */
+    pid = clone(vfork_child, stack + PRRTE_ODLS_DEFAULT_VFORK_STACK,
+                CLONE_VM | CLONE_VFORK | SIGCHLD, &vc);
+    pthread_sigmask(SIG_SETMASK, &oldsigs, NULL);
+
+    munmap(stack, PRRTE_ODLS_DEFAULT_VFORK_STACK);
+    return pid;
+}
+#endif
+
 /**
  *  Fork/exec the specified processes
  */
@@ -615,6 +666,14 @@ static int odls_default_fork_local_proc(void *cdptr)
     pid_t pid;
     prrte_proc_t *child = cd->child;
 
+    /* do any allocations the child would otherwise need
+     * to do before the exec */
+    if (NULL == cd->argv) {
+        cd->argv = malloc(sizeof(char*)*2);
+        cd->argv[0] = strdup(cd->app->app);
+        cd->argv[1] = NULL;
+    }
+
     /* A pipe is used to communicate between the parent and child to
        indicate whether the exec ultimately succeeded or failed.  The
        child sets the pipe to be close-on-exec; the child only ever
@@ -633,13 +692,30 @@ static int odls_default_fork_local_proc(void *cdptr)
     }
 
     /* Fork off the child */
-    pid = fork();
+#if PRRTE_ODLS_DEFAULT_HAVE_VFORK
+    /* stop-on-exec has the child trace itself, so leave that
+     * to a real fork */
+    if (prrte_odls_default_use_vfork &&
+        !prrte_get_attribute(&cd->jdata->attributes, PRRTE_JOB_STOP_ON_EXEC, NULL, PRRTE_BOOL)) {
+        pid = vfork_local_proc(cd, p);
+    } else
+#endif
+    {
+        pid = fork();
+        if (pid == 0) {
+            close(p[0]);
+            do_child(cd, p[1]);
+            /* Does not return */
+        }
+    }
     if (NULL != child) {
         child->pid = pid;
     }
 
     if (pid < 0) {
         PRRTE_ERROR_LOG(PRRTE_ERR_SYS_LIMITS_CHILDREN);
+        close(p[0]);
+        close(p[1]);
         if (NULL != child) {
             child->state = PRRTE_PROC_STATE_FAILED_TO_START;
             child->exit_code = PRRTE_ERR_SYS_LIMITS_CHILDREN;
@@ -647,12 +723,6 @@ static int odls_default_fork_local_proc(void *cdptr)
         return PRRTE_ERR_SYS_LIMITS_CHILDREN;
     }
 
-    if (pid == 0) {
-        close(p[0]);
-        do_child(cd, p[1]);
-        /* Does not return */
-    }
-
     close(p[1]);
     return do_parent(cd, p[0]);
 }
@@ -43,6 +43,13 @@ BEGIN_C_DECLS
 #define OOB_TCP_DEBUG_FAIL      2
 #define OOB_TCP_DEBUG_CONNECT   7
 
+/* upper limit on the number of msgs coalesced into a single writev -
+ * each msg needs at most two iovec entries */
+#define MCA_OOB_TCP_MAX_SEND_BATCH  64
+
+/* number of idle receive slabs kept for reuse */
+#define MCA_OOB_TCP_MAX_FREE_SLABS  32
+
 /* forward declare a couple of structures */
 struct prrte_oob_tcp_module_t;
 struct prrte_oob_tcp_msg_error_t;
@@ -54,8 +54,12 @@
 #include <netdb.h>
 #endif
 #include <ctype.h>
+#include <limits.h>
 #include <sys/socket.h>
 #include <arpa/inet.h>
+#ifdef HAVE_SYS_UIO_H
+#include <sys/uio.h>
+#endif
 
 #include "src/util/show_help.h"
 #include "src/util/error.h"
@@ -156,6 +160,7 @@ static int tcp_component_open(void)
     prrte_oob_tcp_component.ipv6conns = NULL;
     prrte_oob_tcp_component.ipv6ports = NULL;
     prrte_oob_tcp_component.if_masks = NULL;
+    prrte_oob_tcp_component.rtd_ids = NULL;
 
     /* if_include and if_exclude need to be mutually exclusive */
     if (PRRTE_SUCCESS !=
@@ -171,6 +176,9 @@ static int tcp_component_open(void)
         return PRRTE_ERR_NOT_AVAILABLE;
     }
     PRRTE_CONSTRUCT(&prrte_oob_tcp_component.local_ifs, prrte_list_t);
+    PRRTE_CONSTRUCT(&prrte_oob_tcp_component.slabs, prrte_list_t);
+    PRRTE_CONSTRUCT(&prrte_oob_tcp_component.send_pool, prrte_list_t);
+    PRRTE_CONSTRUCT(&prrte_oob_tcp_component.recv_pool, prrte_list_t);
     return PRRTE_SUCCESS;
 }
 
@@ -180,6 +188,9 @@ static int tcp_component_open(void)
 static int tcp_component_close(void)
 {
     PRRTE_LIST_DESTRUCT(&prrte_oob_tcp_component.local_ifs);
+    PRRTE_LIST_DESTRUCT(&prrte_oob_tcp_component.slabs);
+    PRRTE_LIST_DESTRUCT(&prrte_oob_tcp_component.send_pool);
+    PRRTE_LIST_DESTRUCT(&prrte_oob_tcp_component.recv_pool);
     PRRTE_DESTRUCT(&prrte_oob_tcp_component.peers);
 
     if (NULL != prrte_oob_tcp_component.ipv4conns) {
@@ -200,6 +211,9 @@ static int tcp_component_close(void)
     if (NULL != prrte_oob_tcp_component.if_masks) {
         prrte_argv_free(prrte_oob_tcp_component.if_masks);
     }
+    if (NULL != prrte_oob_tcp_component.rtd_ids) {
+        prrte_argv_free(prrte_oob_tcp_component.rtd_ids);
+    }
 
     return PRRTE_SUCCESS;
 }
@@ -455,6 +469,49 @@ static int tcp_component_register(void)
                                           PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
                                           &prrte_oob_tcp_component.max_recon_attempts);
 
+    prrte_oob_tcp_component.max_send_batch = 32;
+    (void)prrte_mca_base_component_var_register(component, "max_send_batch",
+                                          "Max number of queued messages to a peer that can be coalesced into a single writev (1 => send one message at a time)",
+                                          PRRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                          PRRTE_INFO_LVL_5,
+                                          PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                          &prrte_oob_tcp_component.max_send_batch);
+    if (MCA_OOB_TCP_MAX_SEND_BATCH < prrte_oob_tcp_component.max_send_batch) {
+        prrte_oob_tcp_component.max_send_batch = MCA_OOB_TCP_MAX_SEND_BATCH;
+    }
+#if defined(IOV_MAX)
+    if (IOV_MAX < 2 * prrte_oob_tcp_component.max_send_batch) {
+        prrte_oob_tcp_component.max_send_batch = IOV_MAX / 2;
+    }
+#endif
+
+    prrte_oob_tcp_component.compact_hdr = true;
+    (void)prrte_mca_base_component_var_register(component, "compact_hdr",
+                                          "Offer to use the compact, variable-length message header on new connections - peers that do not support it continue to use the legacy header",
+                                          PRRTE_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                          PRRTE_INFO_LVL_5,
+                                          PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                          &prrte_oob_tcp_component.compact_hdr);
+
+    prrte_oob_tcp_component.recv_slab_size = 0;
+    (void)prrte_mca_base_component_var_register(component, "recv_slab_size",
+                                          "Size (in bytes) of the pooled buffers that socket reads land in, allowing several msgs to be parsed out of a single read (0 => read each msg header and body directly)",
+                                          PRRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                          PRRTE_INFO_LVL_5,
+                                          PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                          &prrte_oob_tcp_component.recv_slab_size);
+    if (prrte_oob_tcp_component.recv_slab_size < 0) {
+        prrte_oob_tcp_component.recv_slab_size = 0;
+    }
+
+    prrte_oob_tcp_component.msg_pool_size = 1024;
+    (void)prrte_mca_base_component_var_register(component, "msg_pool_size",
+                                          "Max number of idle send and recv msg objects kept for reuse (0 => construct a new object for every msg)",
+                                          PRRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                          PRRTE_INFO_LVL_5,
+                                          PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                          &prrte_oob_tcp_component.msg_pool_size);
+
     return PRRTE_SUCCESS;
 }
 
@@ -669,6 +726,34 @@ static void component_shutdown(void)
                         "%s TCP SHUTDOWN",
                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME));
 
+    if (0 < prrte_oob_tcp_component.num_writev) {
+        prrte_output_verbose(2, prrte_oob_base_framework.framework_output,
+                            "%s TCP SENT %lu MSGS IN %lu WRITEV CALLS (%.2f MSGS/CALL)",
+                            PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                            (unsigned long)prrte_oob_tcp_component.num_writev_msgs,
+                            (unsigned long)prrte_oob_tcp_component.num_writev,
+                            (double)prrte_oob_tcp_component.num_writev_msgs /
+                            (double)prrte_oob_tcp_component.num_writev);
+    }
+    if (0 < prrte_oob_tcp_component.num_chdr_msgs) {
+        prrte_output_verbose(2, prrte_oob_base_framework.framework_output,
+                            "%s TCP SENT %lu MSGS WITH COMPACT HDR (%.2f BYTES/HDR VS %lu)",
+                            PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                            (unsigned long)prrte_oob_tcp_component.num_chdr_msgs,
+                            (double)prrte_oob_tcp_component.num_chdr_bytes /
+                            (double)prrte_oob_tcp_component.num_chdr_msgs,
+                            (unsigned long)sizeof(prrte_oob_tcp_hdr_t));
+    }
+    if (0 < prrte_oob_tcp_component.num_slab_reads) {
+        prrte_output_verbose(2, prrte_oob_base_framework.framework_output,
+                            "%s TCP RECVD %lu MSGS USING %lu SLAB READS (%.2f MSGS/READ)",
+                            PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                            (unsigned long)prrte_oob_tcp_component.num_slab_msgs,
+                            (unsigned long)prrte_oob_tcp_component.num_slab_reads,
+                            (double)prrte_oob_tcp_component.num_slab_msgs /
+                            (double)prrte_oob_tcp_component.num_slab_reads);
+    }
+
     if (PRRTE_PROC_IS_MASTER && prrte_oob_tcp_component.listen_thread_active) {
         prrte_oob_tcp_component.listen_thread_active = false;
         /* tell the thread to exit */
@@ -1335,12 +1420,21 @@ static void peer_cons(prrte_oob_tcp_peer_t *peer)
     peer->send_ev_active = false;
     peer->recv_ev_active = false;
     peer->timer_ev_active = false;
+    peer->compact_hdr = false;
+    peer->rtd_ids = NULL;
+    peer->slab = NULL;
 }
 static void peer_des(prrte_oob_tcp_peer_t *peer)
 {
     if (NULL != peer->auth_method) {
         free(peer->auth_method);
     }
+    if (NULL != peer->rtd_ids) {
+        prrte_argv_free(peer->rtd_ids);
+    }
+    if (NULL != peer->slab) {
+        PRRTE_RELEASE(peer->slab);
+    }
     if (peer->send_ev_active) {
         prrte_event_del(&peer->send_event);
     }
@@ -89,6 +89,28 @@ typedef struct {
     int                keepalive_intvl;        /**< time between keepalives, in seconds */
     int                retry_delay;            /**< time to wait before retrying connection */
     int                max_recon_attempts;     /**< maximum number of times to attempt connect before giving up (-1 for never) */
+
+    /* send batching support */
+    int                max_send_batch;         /**< max number of queued msgs to coalesce into one writev */
+    uint64_t           num_writev;             /**< number of writev calls issued by the send handler */
+    uint64_t           num_writev_msgs;        /**< number of msgs carried by those writev calls */
+
+    /* compact header support */
+    bool               compact_hdr;            /**< advertise/use the compact msg header */
+    char**             rtd_ids;                /**< routed components we advertise, in id order */
+    uint64_t           num_chdr_msgs;          /**< number of msgs sent with a compact header */
+    uint64_t           num_chdr_bytes;         /**< bytes of compact header those msgs carried */
+
+    /* slab receive support */
+    int                recv_slab_size;         /**< size of receive slabs (0 => read each msg directly) */
+    prrte_list_t       slabs;                  /**< idle receive slabs */
+    uint64_t           num_slab_reads;         /**< number of reads into a slab */
+    uint64_t           num_slab_msgs;          /**< number of msgs recvd while slabs were in use */
+
+    /* send/recv object pools */
+    int                msg_pool_size;          /**< max number of idle objects kept in each pool */
+    prrte_list_t       send_pool;              /**< idle prrte_oob_tcp_send_t objects */
+    prrte_list_t       recv_pool;              /**< idle prrte_oob_tcp_recv_t objects */
 } prrte_oob_tcp_component_t;
 
 PRRTE_MODULE_EXPORT extern prrte_oob_tcp_component_t prrte_oob_tcp_component;
@@ -57,9 +57,11 @@
 #include "types.h"
 #include "prrte_stdint.h"
 #include "src/mca/prtebacktrace/prtebacktrace.h"
+#include "src/mca/base/base.h"
 #include "src/mca/base/prrte_mca_base_var.h"
 #include "src/util/output.h"
 #include "src/util/net.h"
+#include "src/util/argv.h"
 #include "src/util/fd.h"
 #include "src/util/error.h"
 #include "src/util/show_help.h"
@@ -74,6 +76,7 @@
 #include "src/mca/errmgr/errmgr.h"
 #include "src/mca/ess/ess.h"
 #include "src/mca/routed/routed.h"
+#include "src/mca/routed/base/base.h"
 #include "src/runtime/prrte_wait.h"
 #include "src/mca/prteif/prteif.h"
 #include "src/mca/prtereachable/base/base.h"
@@ -511,15 +514,34 @@ out:
     }
 }
 
+/* return the comma-delimited list of routed components whose
+ * position in the list defines the id used for them in the
+ * compact header - the list is computed once and then cached
+ */
+static char* tcp_rtd_ids(void)
+{
+    prrte_mca_base_component_list_item_t *cli;
+
+    if (NULL == prrte_oob_tcp_component.rtd_ids) {
+        PRRTE_LIST_FOREACH(cli, &prrte_routed_base_framework.framework_components,
+                           prrte_mca_base_component_list_item_t) {
+            prrte_argv_append_nosize(&prrte_oob_tcp_component.rtd_ids,
+                                     cli->cli_component->mca_component_name);
+        }
+    }
+    return prrte_argv_join(prrte_oob_tcp_component.rtd_ids, ',');
+}
+
 /* send a handshake that includes our process identifier, our
  * version string, and a security token to ensure we are talking
  * to another OMPI process
  */
 static int tcp_peer_send_connect_ack(prrte_oob_tcp_peer_t* peer)
 {
-    char *msg;
+    char *msg, *rtd = NULL;
     prrte_oob_tcp_hdr_t hdr;
     uint16_t ack_flag = htons(1);
+    uint8_t chdr_version = MCA_OOB_TCP_CHDR_V1;
     size_t sdsize, offset = 0;
 
     prrte_output_verbose(OOB_TCP_DEBUG_CONNECT, prrte_oob_base_framework.framework_output,
@@ -535,12 +557,22 @@ static int tcp_peer_send_connect_ack(prrte_oob_tcp_peer_t* peer)
 
     /* payload size */
     sdsize = sizeof(ack_flag) + strlen(prrte_version_string) + 1;
+    if (prrte_oob_tcp_component.compact_hdr) {
+        /* offer the compact header along with the routed components
+         * it can refer to by id - peers that predate it stop reading
+         * at the end of the version string */
+        rtd = tcp_rtd_ids();
+        sdsize += sizeof(chdr_version) + strlen(rtd) + 1;
+    }
     hdr.nbytes = sdsize;
     MCA_OOB_TCP_HDR_HTON(&hdr);
 
     /* create a space for our message */
     sdsize += sizeof(hdr);
     if (NULL == (msg = (char*)malloc(sdsize))) {
+        if (NULL != rtd) {
+            free(rtd);
+        }
         return PRRTE_ERR_OUT_OF_RESOURCE;
     }
     memset(msg, 0, sdsize);
@@ -552,6 +584,13 @@ static int tcp_peer_send_connect_ack(prrte_oob_tcp_peer_t* peer)
     offset += sizeof(ack_flag);
     memcpy(msg + offset, prrte_version_string, strlen(prrte_version_string) + 1);
     offset += strlen(prrte_version_string)+1;
+    if (NULL != rtd) {
+        memcpy(msg + offset, &chdr_version, sizeof(chdr_version));
+        offset += sizeof(chdr_version);
+        memcpy(msg + offset, rtd, strlen(rtd) + 1);
+        offset += strlen(rtd) + 1;
+        free(rtd);
+    }
 
     /* send it */
     if (PRRTE_SUCCESS != tcp_peer_send_blocking(peer->sd, msg, sdsize)) {
@@ -1033,12 +1072,27 @@ int prrte_oob_tcp_peer_recv_connect_ack(prrte_oob_tcp_peer_t* pr,
         free(msg);
         return PRRTE_ERR_CONNECTION_REFUSED;
     }
+
+    /* the compact header is only used if we both offered it */
+    peer->compact_hdr = false;
+    if (NULL != peer->rtd_ids) {
+        prrte_argv_free(peer->rtd_ids);
+        peer->rtd_ids = NULL;
+    }
+    if (prrte_oob_tcp_component.compact_hdr &&
+        offset + 1 < hdr.nbytes &&
+        MCA_OOB_TCP_CHDR_V1 == (uint8_t)msg[offset] &&
+        '\0' == msg[hdr.nbytes - 1]) {
+        peer->compact_hdr = true;
+        peer->rtd_ids = prrte_argv_split(msg + offset + 1, ',');
+    }
     free(msg);
 
     prrte_output_verbose(OOB_TCP_DEBUG_CONNECT, prrte_oob_base_framework.framework_output,
-                        "%s connect-ack version from %s matches ours",
+                        "%s connect-ack version from %s matches ours - %s header",
                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
-                        PRRTE_NAME_PRINT(&peer->name));
+                        PRRTE_NAME_PRINT(&peer->name),
+                        peer->compact_hdr ? "compact" : "legacy");
 
     /* if the requestor wanted the header returned, then they
      * will complete their processing
@@ -1112,6 +1166,12 @@ void prrte_oob_tcp_peer_close(prrte_oob_tcp_peer_t *peer)
     close(peer->sd);
     peer->sd = -1;
 
+    /* anything left unparsed belonged to the old connection */
+    if (NULL != peer->slab) {
+        PRRTE_RELEASE(peer->slab);
+        peer->slab = NULL;
+    }
+
     /* if we were CONNECTING, then we need to mark the address as
      * failed and cycle back to try the next address */
     if (MCA_OOB_TCP_CONNECTING == peer->state) {
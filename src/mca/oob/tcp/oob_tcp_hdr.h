@@ -67,6 +67,37 @@ typedef struct {
     /* routed module to be used */
     char routed[PRRTE_MAX_RTD_SIZE+1];
 } prrte_oob_tcp_hdr_t;
+
+/* compact header for tcp msgs - used in place of the
+ * legacy header above once both sides of a connection
+ * have advertised support for it in their IDENT handshake.
+ * The handshake itself always uses the legacy header.
+ *
+ * Layout on the wire:
+ *   byte 0    version (MCA_OOB_TCP_CHDR_V1)
+ *   byte 1    total length of the compact header, including
+ *             these first two bytes
+ *   byte 2    message type
+ *   byte 3    flags (MCA_OOB_TCP_CHDR_*)
+ *   byte 4    routed module id - 0 if none was given, otherwise
+ *             the index (+1) into the list of routed components
+ *             the recipient advertised at handshake
+ *   origin    jobid/vpid in network order - only present if the
+ *             origin is not the sending peer
+ *   dst       jobid/vpid in network order - only present if the
+ *             dst is not the receiving peer
+ *   tag, seq_num, nbytes as unsigned LEB128 varints
+ *   routed    length byte plus name - only present if the
+ *             module name could not be mapped to an id
+ */
+#define MCA_OOB_TCP_CHDR_V1         0xC1
+#define MCA_OOB_TCP_CHDR_PREFIX     2
+#define MCA_OOB_TCP_CHDR_MIN        8
+#define MCA_OOB_TCP_CHDR_MAX        72
+
+#define MCA_OOB_TCP_CHDR_ORIGIN     0x01
+#define MCA_OOB_TCP_CHDR_DST        0x02
+#define MCA_OOB_TCP_CHDR_RTD_INLINE 0x04
 /**
  * Convert the message header to host byte order
  */
@@ -66,6 +66,9 @@ typedef struct {
     prrte_list_t send_queue;      /**< list of messages to send */
     prrte_oob_tcp_send_t *send_msg; /**< current send in progress */
     prrte_oob_tcp_recv_t *recv_msg; /**< current recv in progress */
+    prrte_oob_tcp_slab_t *slab;   /**< unparsed bytes already read from the socket */
+    bool compact_hdr;             /**< both sides agreed to use the compact header */
+    char **rtd_ids;               /**< routed components the peer advertised, in id order */
 } prrte_oob_tcp_peer_t;
 PRRTE_CLASS_DECLARATION(prrte_oob_tcp_peer_t);
 
@@ -60,6 +60,7 @@
 #include "src/util/output.h"
 #include "src/util/net.h"
 #include "src/util/error.h"
+#include "src/util/argv.h"
 #include "src/class/prrte_hash_table.h"
 #include "src/event/event-internal.h"
 
@@ -111,6 +112,190 @@ void prrte_oob_tcp_queue_msg(int sd, short args, void *cbdata)
     }
 }
 
+/* unsigned LEB128 varints used by the compact header */
+static inline uint8_t* chdr_put_varint(uint8_t *p, uint32_t val)
+{
+    while (0x80 <= val) {
+        *p++ = (uint8_t)(val | 0x80);
+        val >>= 7;
+    }
+    *p++ = (uint8_t)val;
+    return p;
+}
+
+static inline uint8_t* chdr_get_varint(uint8_t *p, uint8_t *end, uint32_t *val)
+{
+    uint32_t v = 0;
+    int shift;
+
+    for (shift=0; p < end && shift < 35; shift += 7) {
+        v |= (uint32_t)(*p & 0x7f) << shift;
+        if (0 == (*p++ & 0x80)) {
+            *val = v;
+            return p;
+        }
+    }
+    /* ran off the end of the header */
+    return NULL;
+}
+
+static inline uint8_t* chdr_put_name(uint8_t *p, prrte_process_name_t *name)
+{
+    uint32_t n;
+
+    n = htonl(name->jobid);
+    memcpy(p, &n, sizeof(n));
+    p += sizeof(n);
+    n = htonl(name->vpid);
+    memcpy(p, &n, sizeof(n));
+    return p + sizeof(n);
+}
+
+static inline uint8_t* chdr_get_name(uint8_t *p, prrte_process_name_t *name)
+{
+    uint32_t n;
+
+    memcpy(&n, p, sizeof(n));
+    name->jobid = ntohl(n);
+    p += sizeof(n);
+    memcpy(&n, p, sizeof(n));
+    name->vpid = ntohl(n);
+    return p + sizeof(n);
+}
+
+/* if the peer agreed to the compact header, replace the legacy
+ * header of a msg that has not yet started onto the wire with
+ * its compact form. This is done at the time of transmission
+ * rather than when the msg is queued as the msg may have been
+ * queued before the connection (and hence the header format)
+ * was established */
+static void pack_chdr(prrte_oob_tcp_peer_t* peer, prrte_oob_tcp_send_t* msg)
+{
+    prrte_oob_tcp_hdr_t hdr;
+    uint8_t *p = (uint8_t*)msg->chdr;
+    uint8_t flags = 0, rtd = 0;
+    size_t len;
+    int i;
+
+    if (!peer->compact_hdr || msg->hdr_sent ||
+        msg->sdptr != (char*)&msg->hdr) {
+        return;
+    }
+
+    /* the legacy header is held in network order */
+    hdr = msg->hdr;
+    MCA_OOB_TCP_HDR_NTOH(&hdr);
+
+    if ('\0' != hdr.routed[0]) {
+        for (i=0; NULL != peer->rtd_ids && NULL != peer->rtd_ids[i] && i < UINT8_MAX; i++) {
+            if (0 == strcmp(hdr.routed, peer->rtd_ids[i])) {
+                rtd = i + 1;
+                break;
+            }
+        }
+        if (0 == rtd) {
+            /* the peer doesn't know this one - send it by name */
+            flags |= MCA_OOB_TCP_CHDR_RTD_INLINE;
+        }
+    }
+    if (hdr.origin.jobid != PRRTE_PROC_MY_NAME->jobid ||
+        hdr.origin.vpid != PRRTE_PROC_MY_NAME->vpid) {
+        flags |= MCA_OOB_TCP_CHDR_ORIGIN;
+    }
+    if (hdr.dst.jobid != peer->name.jobid ||
+        hdr.dst.vpid != peer->name.vpid) {
+        flags |= MCA_OOB_TCP_CHDR_DST;
+    }
+
+    *p++ = MCA_OOB_TCP_CHDR_V1;
+    p++;  // length is filled in below
+    *p++ = hdr.type;
+    *p++ = flags;
+    *p++ = rtd;
+    if (flags & MCA_OOB_TCP_CHDR_ORIGIN) {
+        p = chdr_put_name(p, &hdr.origin);
+    }
+    if (flags & MCA_OOB_TCP_CHDR_DST) {
+        p = chdr_put_name(p, &hdr.dst);
+    }
+    p = chdr_put_varint(p, hdr.tag);
+    p = chdr_put_varint(p, hdr.seq_num);
+    p = chdr_put_varint(p, hdr.nbytes);
+    if (flags & MCA_OOB_TCP_CHDR_RTD_INLINE) {
+        len = strnlen(hdr.routed, PRRTE_MAX_RTD_SIZE);
+        *p++ = (uint8_t)len;
+        memcpy(p, hdr.routed, len);
+        p += len;
+    }
+    len = p - (uint8_t*)msg->chdr;
+    msg->chdr[1] = (char)len;
+
+    msg->sdptr = msg->chdr;
+    msg->sdbytes = len;
+    prrte_oob_tcp_component.num_chdr_msgs++;
+    prrte_oob_tcp_component.num_chdr_bytes += len;
+}
+
+/* decode a complete compact header into the (host order)
+ * legacy header of the recv so the rest of the recv path
+ * is unaware of which format was used */
+static int unpack_chdr(prrte_oob_tcp_peer_t* peer, prrte_oob_tcp_recv_t* rcv)
+{
+    prrte_oob_tcp_hdr_t *hdr = &rcv->hdr;
+    uint8_t *p = (uint8_t*)rcv->chdr + MCA_OOB_TCP_CHDR_PREFIX;
+    uint8_t *end = (uint8_t*)rcv->chdr + rcv->chdr_len;
+    uint8_t flags, rtd;
+    size_t len;
+
+    hdr->type = *p++;
+    flags = *p++;
+    rtd = *p++;
+    if (flags & MCA_OOB_TCP_CHDR_ORIGIN) {
+        if (end - p < 2 * (ptrdiff_t)sizeof(uint32_t)) {
+            goto error;
+        }
+        p = chdr_get_name(p, &hdr->origin);
+    } else {
+        hdr->origin = peer->name;
+    }
+    if (flags & MCA_OOB_TCP_CHDR_DST) {
+        if (end - p < 2 * (ptrdiff_t)sizeof(uint32_t)) {
+            goto error;
+        }
+        p = chdr_get_name(p, &hdr->dst);
+    } else {
+        hdr->dst = *PRRTE_PROC_MY_NAME;
+    }
+    if (NULL == (p = chdr_get_varint(p, end, &hdr->tag)) ||
+        NULL == (p = chdr_get_varint(p, end, &hdr->seq_num)) ||
+        NULL == (p = chdr_get_varint(p, end, &hdr->nbytes))) {
+        goto error;
+    }
+    hdr->routed[0] = '\0';
+    if (flags & MCA_OOB_TCP_CHDR_RTD_INLINE) {
+        if (p == end || PRRTE_MAX_RTD_SIZE < (len = *p++) ||
+            (size_t)(end - p) < len) {
+            goto error;
+        }
+        memcpy(hdr->routed, p, len);
+        hdr->routed[len] = '\0';
+    } else if (0 < rtd) {
+        /* ids index the list we advertised */
+        if (prrte_argv_count(prrte_oob_tcp_component.rtd_ids) < rtd) {
+            goto error;
+        }
+        prrte_string_copy(hdr->routed, prrte_oob_tcp_component.rtd_ids[rtd-1],
+                          PRRTE_MAX_RTD_SIZE+1);
+    }
+    return PRRTE_SUCCESS;
+
+  error:
+    prrte_output(0, "%s-%s prrte_oob_tcp_recv_handler: malformed compact header",
+                PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                PRRTE_NAME_PRINT(&(peer->name)));
+    return PRRTE_ERR_COMM_FAILURE;
+}
+
 static int send_msg(prrte_oob_tcp_peer_t* peer, prrte_oob_tcp_send_t* msg)
 {
     struct iovec iov[2];
@@ -138,6 +323,11 @@ static int send_msg(prrte_oob_tcp_peer_t* peer, prrte_oob_tcp_send_t* msg)
 
   retry:
     rc = writev(peer->sd, iov, iov_count);
+    if (0 <= rc) {
+        /* only count the writes that made it onto the wire */
+        prrte_oob_tcp_component.num_writev++;
+        prrte_oob_tcp_component.num_writev_msgs++;
+    }
     if (PRRTE_LIKELY(rc == remain)) {
         /* we successfully sent the header and the msg data if any */
         msg->hdr_sent = true;
@@ -194,6 +384,180 @@ static int send_msg(prrte_oob_tcp_peer_t* peer, prrte_oob_tcp_send_t* msg)
     }
 }
 
+/* messages sent as a list of iovecs are rotated one iovec at
+ * a time, so they cannot be coalesced with other messages */
+#define MCA_OOB_TCP_MSG_BATCHABLE(m)                                    \
+    (NULL != (m)->data || NULL == (m)->msg || NULL == (m)->msg->iov)
+
+static char* msg_payload(prrte_oob_tcp_send_t *msg)
+{
+    if (NULL != msg->data) {
+        /* relay message */
+        return msg->data;
+    } else if (NULL != msg->msg->buffer) {
+        /* buffer send */
+        return msg->msg->buffer->base_ptr;
+    }
+    return msg->msg->data;
+}
+
+/* number of bytes of this message that remain to be written */
+static size_t msg_remaining(prrte_oob_tcp_send_t *msg)
+{
+    if (msg->hdr_sent) {
+        return msg->sdbytes;
+    }
+    return msg->sdbytes + ntohl(msg->hdr.nbytes);
+}
+
+/* account for a partial write of nbytes of this message */
+static void msg_advance(prrte_oob_tcp_send_t *msg, size_t nbytes)
+{
+    if (nbytes < msg->sdbytes) {
+        /* partial write of the header or the msg data */
+        msg->sdptr = (char *)msg->sdptr + nbytes;
+        msg->sdbytes -= nbytes;
+    } else {
+        /* header was fully written, but only a part of the msg data was written */
+        nbytes -= msg->sdbytes;
+        msg->hdr_sent = true;
+        msg->sdptr = msg_payload(msg) + nbytes;
+        msg->sdbytes = ntohl(msg->hdr.nbytes) - nbytes;
+    }
+}
+
+/* notify the RML (if required) that a message has been
+ * completely written and release it */
+static void msg_complete(prrte_oob_tcp_peer_t* peer, prrte_oob_tcp_send_t* msg)
+{
+    if (NULL != msg->data || NULL == msg->msg) {
+        /* the relay is complete - release the data */
+        prrte_output_verbose(2, prrte_oob_base_framework.framework_output,
+                            "%s MESSAGE RELAY COMPLETE TO %s OF %d BYTES ON SOCKET %d",
+                            PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                            PRRTE_NAME_PRINT(&(peer->name)),
+                            (int)ntohl(msg->hdr.nbytes), peer->sd);
+        prrte_oob_tcp_send_return(msg);
+    } else if (NULL != msg->msg->buffer) {
+        /* we are done - notify the RML */
+        prrte_output_verbose(2, prrte_oob_base_framework.framework_output,
+                            "%s MESSAGE SEND COMPLETE TO %s OF %d BYTES ON SOCKET %d",
+                            PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                            PRRTE_NAME_PRINT(&(peer->name)),
+                            (int)ntohl(msg->hdr.nbytes), peer->sd);
+        msg->msg->status = PRRTE_SUCCESS;
+        PRRTE_RML_SEND_COMPLETE(msg->msg);
+        prrte_oob_tcp_send_return(msg);
+    } else {
+        /* this was a relay we have now completed - no need to
+         * notify the RML as the local proc didn't initiate
+         * the send
+         */
+        prrte_output_verbose(2, prrte_oob_base_framework.framework_output,
+                            "%s MESSAGE RELAY COMPLETE TO %s OF %d BYTES ON SOCKET %d",
+                            PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                            PRRTE_NAME_PRINT(&(peer->name)),
+                            (int)ntohl(msg->hdr.nbytes), peer->sd);
+        msg->msg->status = PRRTE_SUCCESS;
+        prrte_oob_tcp_send_return(msg);
+    }
+}
+
+/* Coalesce the on-deck message and as many of the queued messages
+ * behind it as possible into a single writev. Messages that are
+ * fully written are completed and removed from the queue - if the
+ * write comes up short, the message it stopped in is left on-deck
+ * with its progress recorded so the next call resumes from there */
+static int send_batch(prrte_oob_tcp_peer_t* peer)
+{
+    struct iovec iov[2*MCA_OOB_TCP_MAX_SEND_BATCH];
+    prrte_oob_tcp_send_t *msgs[MCA_OOB_TCP_MAX_SEND_BATCH];
+    prrte_oob_tcp_send_t *msg;
+    prrte_list_item_t *item;
+    int niov = 0, nmsgs = 0, n, retries = 0;
+    ssize_t remain = 0, rc;
+    size_t left;
+
+    msg = peer->send_msg;
+    item = prrte_list_get_first(&peer->send_queue);
+    while (NULL != msg && MCA_OOB_TCP_MSG_BATCHABLE(msg) &&
+           nmsgs < prrte_oob_tcp_component.max_send_batch) {
+        pack_chdr(peer, msg);
+        msgs[nmsgs++] = msg;
+        if (0 < msg->sdbytes) {
+            iov[niov].iov_base = msg->sdptr;
+            iov[niov].iov_len = msg->sdbytes;
+            remain += msg->sdbytes;
+            ++niov;
+        }
+        if (!msg->hdr_sent && 0 < ntohl(msg->hdr.nbytes)) {
+            iov[niov].iov_base = msg_payload(msg);
+            iov[niov].iov_len = ntohl(msg->hdr.nbytes);
+            remain += ntohl(msg->hdr.nbytes);
+            ++niov;
+        }
+        if (item == prrte_list_get_end(&peer->send_queue)) {
+            break;
+        }
+        msg = (prrte_oob_tcp_send_t*)item;
+        item = prrte_list_get_next(item);
+    }
+
+  retry:
+    rc = writev(peer->sd, iov, niov);
+    if (rc < 0) {
+        if (prrte_socket_errno == EINTR) {
+            goto retry;
+        } else if (prrte_socket_errno == EAGAIN) {
+            /* tell the caller to keep this message on active,
+             * but let the event lib cycle so other messages
+             * can progress while this socket is busy
+             */
+            ++retries;
+            if (retries < OOB_SEND_MAX_RETRIES) {
+                goto retry;
+            }
+            return PRRTE_ERR_RESOURCE_BUSY;
+        } else if (prrte_socket_errno == EWOULDBLOCK) {
+            ++retries;
+            if (retries < OOB_SEND_MAX_RETRIES) {
+                goto retry;
+            }
+            return PRRTE_ERR_WOULD_BLOCK;
+        } else {
+            /* we hit an error and cannot progress this message */
+            prrte_output(0, "oob:tcp: send_batch: write failed: %s (%d) [sd = %d]",
+                        strerror(prrte_socket_errno),
+                        prrte_socket_errno, peer->sd);
+            return PRRTE_ERR_UNREACH;
+        }
+    }
+    prrte_oob_tcp_component.num_writev++;
+    prrte_oob_tcp_component.num_writev_msgs += nmsgs;
+
+    /* walk the batch, completing everything that made it out */
+    for (n=0; n < nmsgs; n++) {
+        msg = msgs[n];
+        left = msg_remaining(msg);
+        if (msg != peer->send_msg) {
+            prrte_list_remove_item(&peer->send_queue, &msg->super);
+            peer->send_msg = msg;
+        }
+        if ((size_t)rc < left) {
+            /* short writev. This usually means the kernel buffer is full,
+             * so there is no point for retrying at that time */
+            msg_advance(msg, rc);
+            return PRRTE_ERR_RESOURCE_BUSY;
+        }
+        rc -= left;
+        msg->hdr_sent = true;
+        msg->sdbytes = 0;
+        peer->send_msg = NULL;
+        msg_complete(peer, msg);
+    }
+    return PRRTE_SUCCESS;
+}
+
 /*
  * A file descriptor is available/ready for send. Check the state
  * of the socket and take the appropriate action.
@@ -236,40 +600,17 @@ void prrte_oob_tcp_send_handler(int sd, short flags, void *cbdata)
         if (NULL != msg) {
             prrte_output_verbose(2, prrte_oob_base_framework.framework_output,
                                 "oob:tcp:send_handler SENDING MSG");
-            if (PRRTE_SUCCESS == (rc = send_msg(peer, msg))) {
+            pack_chdr(peer, msg);
+            if (1 < prrte_oob_tcp_component.max_send_batch &&
+                MCA_OOB_TCP_MSG_BATCHABLE(msg)) {
+                /* coalesce any queued msgs into a single writev -
+                 * everything we tried to send is complete on success */
+                rc = send_batch(peer);
+                msg = peer->send_msg;
+            } else if (PRRTE_SUCCESS == (rc = send_msg(peer, msg))) {
                 /* this msg is complete */
-                if (NULL != msg->data || NULL == msg->msg) {
-                    /* the relay is complete - release the data */
-                    prrte_output_verbose(2, prrte_oob_base_framework.framework_output,
-                                        "%s MESSAGE RELAY COMPLETE TO %s OF %d BYTES ON SOCKET %d",
-                                        PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
-                                        PRRTE_NAME_PRINT(&(peer->name)),
-                                        (int)ntohl(msg->hdr.nbytes), peer->sd);
-                    PRRTE_RELEASE(msg);
-                    peer->send_msg = NULL;
-                } else if (NULL != msg->msg->buffer) {
-                    /* we are done - notify the RML */
-                    prrte_output_verbose(2, prrte_oob_base_framework.framework_output,
-                                        "%s MESSAGE SEND COMPLETE TO %s OF %d BYTES ON SOCKET %d",
-                                        PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
-                                        PRRTE_NAME_PRINT(&(peer->name)),
-                                        (int)ntohl(msg->hdr.nbytes), peer->sd);
-                    msg->msg->status = PRRTE_SUCCESS;
-                    PRRTE_RML_SEND_COMPLETE(msg->msg);
-                    PRRTE_RELEASE(msg);
-                    peer->send_msg = NULL;
-                } else if (NULL != msg->msg->data) {
-                    /* this was a relay we have now completed - no need to
-                     * notify the RML as the local proc didn't initiate
-                     * the send
-                     */
-                    prrte_output_verbose(2, prrte_oob_base_framework.framework_output,
-                                        "%s MESSAGE RELAY COMPLETE TO %s OF %d BYTES ON SOCKET %d",
-                                        PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
-                                        PRRTE_NAME_PRINT(&(peer->name)),
-                                        (int)ntohl(msg->hdr.nbytes), peer->sd);
-                    msg->msg->status = PRRTE_SUCCESS;
-                    PRRTE_RELEASE(msg);
+                if (MCA_OOB_TCP_MSG_BATCHABLE(msg)) {
+                    msg_complete(peer, msg);
                     peer->send_msg = NULL;
                 } else {
                     /* rotate to the next iovec */
@@ -291,10 +632,12 @@ void prrte_oob_tcp_send_handler(int sd, short flags, void *cbdata)
                                             (int)ntohl(msg->hdr.nbytes), peer->sd);
                         msg->msg->status = PRRTE_SUCCESS;
                         PRRTE_RML_SEND_COMPLETE(msg->msg);
-                        PRRTE_RELEASE(msg);
+                        prrte_oob_tcp_send_return(msg);
                         peer->send_msg = NULL;
                     }
                 }
+            }
+            if (PRRTE_SUCCESS == rc) {
                 /* fall thru to queue the next message */
             } else if (PRRTE_ERR_RESOURCE_BUSY == rc ||
                        PRRTE_ERR_WOULD_BLOCK == rc) {
@@ -343,13 +686,74 @@ void prrte_oob_tcp_send_handler(int sd, short flags, void *cbdata)
     }
 }
 
+static prrte_oob_tcp_slab_t* slab_get(void)
+{
+    prrte_oob_tcp_slab_t *slab;
+
+    slab = (prrte_oob_tcp_slab_t*)prrte_list_remove_first(&prrte_oob_tcp_component.slabs);
+    if (NULL == slab) {
+        slab = PRRTE_NEW(prrte_oob_tcp_slab_t);
+        slab->size = prrte_oob_tcp_component.recv_slab_size;
+        if (NULL == (slab->base = (char*)malloc(slab->size))) {
+            PRRTE_RELEASE(slab);
+            return NULL;
+        }
+    }
+    slab->head = slab->base;
+    slab->nbytes = 0;
+    return slab;
+}
+
+static void slab_put(prrte_oob_tcp_slab_t *slab)
+{
+    if (prrte_list_get_size(&prrte_oob_tcp_component.slabs) < MCA_OOB_TCP_MAX_FREE_SLABS) {
+        prrte_list_append(&prrte_oob_tcp_component.slabs, &slab->super);
+    } else {
+        PRRTE_RELEASE(slab);
+    }
+}
+
 static int read_bytes(prrte_oob_tcp_peer_t* peer)
 {
+    prrte_oob_tcp_slab_t *slab;
+    size_t n;
     int rc;
 
     /* read until all bytes recvd or error */
     while (0 < peer->recv_msg->rdbytes) {
-        rc = read(peer->sd, peer->recv_msg->rdptr, peer->recv_msg->rdbytes);
+        if (NULL != (slab = peer->slab)) {
+            /* take what we can from bytes we already pulled off
+             * the socket - the slab goes back to the pool once
+             * it has been fully parsed */
+            n = (slab->nbytes < peer->recv_msg->rdbytes) ? slab->nbytes : peer->recv_msg->rdbytes;
+            memcpy(peer->recv_msg->rdptr, slab->head, n);
+            slab->head += n;
+            slab->nbytes -= n;
+            peer->recv_msg->rdbytes -= n;
+            peer->recv_msg->rdptr += n;
+            if (0 == slab->nbytes) {
+                peer->slab = NULL;
+                slab_put(slab);
+            }
+            continue;
+        }
+        if (0 < prrte_oob_tcp_component.recv_slab_size &&
+            peer->recv_msg->rdbytes < (size_t)prrte_oob_tcp_component.recv_slab_size &&
+            NULL != (slab = slab_get())) {
+            /* read as much as the slab will hold so that any msgs
+             * queued behind this one come along with this read */
+            rc = read(peer->sd, slab->base, slab->size);
+            if (0 < rc) {
+                slab->nbytes = rc;
+                peer->slab = slab;
+                prrte_oob_tcp_component.num_slab_reads++;
+                continue;
+            }
+            slab_put(slab);
+        } else {
+            /* large bodies are read directly into place */
+            rc = read(peer->sd, peer->recv_msg->rdptr, peer->recv_msg->rdbytes);
+        }
         if (rc < 0) {
             if(prrte_socket_errno == EINTR) {
                 continue;
@@ -421,6 +825,34 @@ static int read_bytes(prrte_oob_tcp_peer_t* peer)
     return PRRTE_SUCCESS;
 }
 
+/* called each time a read of the compact header completes - the
+ * first time we have only its prefix, which tells us how much
+ * more remains to be read */
+static int recv_chdr(prrte_oob_tcp_peer_t* peer)
+{
+    prrte_oob_tcp_recv_t *rcv = peer->recv_msg;
+    size_t len;
+    int rc;
+
+    if (0 == rcv->chdr_len) {
+        len = (uint8_t)rcv->chdr[1];
+        if (MCA_OOB_TCP_CHDR_V1 != (uint8_t)rcv->chdr[0] ||
+            MCA_OOB_TCP_CHDR_MIN > len || MCA_OOB_TCP_CHDR_MAX < len) {
+            prrte_output(0, "%s-%s prrte_oob_tcp_recv_handler: bad compact header version %d length %d",
+                        PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                        PRRTE_NAME_PRINT(&(peer->name)),
+                        (int)(uint8_t)rcv->chdr[0], (int)len);
+            return PRRTE_ERR_COMM_FAILURE;
+        }
+        rcv->chdr_len = len;
+        rcv->rdbytes = len - MCA_OOB_TCP_CHDR_PREFIX;
+        if (PRRTE_SUCCESS != (rc = read_bytes(peer))) {
+            return rc;
+        }
+    }
+    return unpack_chdr(peer, rcv);
+}
+
 /*
  * Dispatch to the appropriate action routine based on the state
  * of the connection with the peer.
@@ -483,32 +915,44 @@ void prrte_oob_tcp_recv_handler(int sd, short flags, void *cbdata)
         prrte_output_verbose(OOB_TCP_DEBUG_CONNECT, prrte_oob_base_framework.framework_output,
                             "%s:tcp:recv:handler CONNECTED",
                             PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME));
+      next_msg:
         /* allocate a new message and setup for recv */
         if (NULL == peer->recv_msg) {
             prrte_output_verbose(OOB_TCP_DEBUG_CONNECT, prrte_oob_base_framework.framework_output,
                                 "%s:tcp:recv:handler allocate new recv msg",
                                 PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME));
-            peer->recv_msg = PRRTE_NEW(prrte_oob_tcp_recv_t);
+            peer->recv_msg = prrte_oob_tcp_recv_get();
             if (NULL == peer->recv_msg) {
                 prrte_output(0, "%s-%s prrte_oob_tcp_peer_recv_handler: unable to allocate recv message\n",
                             PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
                             PRRTE_NAME_PRINT(&(peer->name)));
                 return;
             }
-            /* start by reading the header */
-            peer->recv_msg->rdptr = (char*)&peer->recv_msg->hdr;
-            peer->recv_msg->rdbytes = sizeof(prrte_oob_tcp_hdr_t);
+            /* start by reading the header - if it is compact, we
+             * only know the size of its fixed prefix */
+            if (peer->compact_hdr) {
+                peer->recv_msg->rdptr = peer->recv_msg->chdr;
+                peer->recv_msg->rdbytes = MCA_OOB_TCP_CHDR_PREFIX;
+            } else {
+                peer->recv_msg->rdptr = (char*)&peer->recv_msg->hdr;
+                peer->recv_msg->rdbytes = sizeof(prrte_oob_tcp_hdr_t);
+            }
         }
         /* if the header hasn't been completely read, read it */
         if (!peer->recv_msg->hdr_recvd) {
             prrte_output_verbose(OOB_TCP_DEBUG_CONNECT, prrte_oob_base_framework.framework_output,
                                 "%s:tcp:recv:handler read hdr",
                                 PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME));
-            if (PRRTE_SUCCESS == (rc = read_bytes(peer))) {
-                /* completed reading the header */
-                peer->recv_msg->hdr_recvd = true;
+            rc = read_bytes(peer);
+            if (PRRTE_SUCCESS == rc && peer->compact_hdr) {
+                rc = recv_chdr(peer);
+            } else if (PRRTE_SUCCESS == rc) {
                 /* convert the header */
                 MCA_OOB_TCP_HDR_NTOH(&peer->recv_msg->hdr);
+            }
+            if (PRRTE_SUCCESS == rc) {
+                /* completed reading the header */
+                peer->recv_msg->hdr_recvd = true;
                 /* if this is a zero-byte message, then we are done */
                 if (0 == peer->recv_msg->hdr.nbytes) {
                     prrte_output_verbose(OOB_TCP_DEBUG_CONNECT, prrte_oob_base_framework.framework_output,
@@ -571,7 +1015,9 @@ void prrte_oob_tcp_recv_handler(int sd, short flags, void *cbdata)
                                           peer->recv_msg->hdr.seq_num,
                                           peer->recv_msg->data,
                                           peer->recv_msg->hdr.nbytes);
-                    PRRTE_RELEASE(peer->recv_msg);
+                    /* the RML now owns the data */
+                    peer->recv_msg->data = NULL;
+                    prrte_oob_tcp_recv_return(peer->recv_msg);
                 } else {
                     /* promote this to the OOB as some other transport might
                      * be the next best hop */
@@ -593,9 +1039,18 @@ void prrte_oob_tcp_recv_handler(int sd, short flags, void *cbdata)
                     /* protect the data */
                     peer->recv_msg->data = NULL;
                     /* cleanup */
-                    PRRTE_RELEASE(peer->recv_msg);
+                    prrte_oob_tcp_recv_return(peer->recv_msg);
                 }
                 peer->recv_msg = NULL;
+                if (0 < prrte_oob_tcp_component.recv_slab_size) {
+                    prrte_oob_tcp_component.num_slab_msgs++;
+                }
+                /* if the read that completed this msg also brought in
+                 * the start of others, process them now - the socket
+                 * won't signal readiness for bytes we already hold */
+                if (NULL != peer->slab) {
+                    goto next_msg;
+                }
                 return;
             } else if (PRRTE_ERR_RESOURCE_BUSY == rc ||
                        PRRTE_ERR_WOULD_BLOCK == rc) {
@@ -652,6 +1107,8 @@ PRRTE_CLASS_INSTANCE(prrte_oob_tcp_send_t,
 static void rcv_cons(prrte_oob_tcp_recv_t *ptr)
 {
     memset(&ptr->hdr, 0, sizeof(prrte_oob_tcp_hdr_t));
+    ptr->chdr_len = 0;
+    ptr->data = NULL;
     ptr->hdr_recvd = false;
     ptr->rdptr = NULL;
     ptr->rdbytes = 0;
@@ -660,6 +1117,73 @@ PRRTE_CLASS_INSTANCE(prrte_oob_tcp_recv_t,
                    prrte_list_item_t,
                    rcv_cons, NULL);
 
+static void slab_cons(prrte_oob_tcp_slab_t *ptr)
+{
+    ptr->base = NULL;
+    ptr->size = 0;
+    ptr->head = NULL;
+    ptr->nbytes = 0;
+}
+static void slab_des(prrte_oob_tcp_slab_t *ptr)
+{
+    if (NULL != ptr->base) {
+        free(ptr->base);
+    }
+}
+PRRTE_CLASS_INSTANCE(prrte_oob_tcp_slab_t,
+                   prrte_list_item_t,
+                   slab_cons, slab_des);
+
+/* send and recv objects are recycled through the component's
+ * pools rather than being constructed and destructed for every
+ * msg. All of this runs in the OOB event base, so the pools
+ * need no locking */
+prrte_oob_tcp_send_t* prrte_oob_tcp_send_get(void)
+{
+    prrte_oob_tcp_send_t *snd;
+
+    snd = (prrte_oob_tcp_send_t*)prrte_list_remove_first(&prrte_oob_tcp_component.send_pool);
+    if (NULL == snd) {
+        snd = PRRTE_NEW(prrte_oob_tcp_send_t);
+    }
+    return snd;
+}
+
+void prrte_oob_tcp_send_return(prrte_oob_tcp_send_t *snd)
+{
+    if ((int)prrte_list_get_size(&prrte_oob_tcp_component.send_pool) <
+        prrte_oob_tcp_component.msg_pool_size) {
+        /* release anything we own and reset for the next msg */
+        snd_des(snd);
+        snd_cons(snd);
+        prrte_list_append(&prrte_oob_tcp_component.send_pool, &snd->super);
+    } else {
+        PRRTE_RELEASE(snd);
+    }
+}
+
+prrte_oob_tcp_recv_t* prrte_oob_tcp_recv_get(void)
+{
+    prrte_oob_tcp_recv_t *rcv;
+
+    rcv = (prrte_oob_tcp_recv_t*)prrte_list_remove_first(&prrte_oob_tcp_component.recv_pool);
+    if (NULL == rcv) {
+        rcv = PRRTE_NEW(prrte_oob_tcp_recv_t);
+    }
+    return rcv;
+}
+
+void prrte_oob_tcp_recv_return(prrte_oob_tcp_recv_t *rcv)
+{
+    if ((int)prrte_list_get_size(&prrte_oob_tcp_component.recv_pool) <
+        prrte_oob_tcp_component.msg_pool_size) {
+        rcv_cons(rcv);
+        prrte_list_append(&prrte_oob_tcp_component.recv_pool, &rcv->super);
+    } else {
+        PRRTE_RELEASE(rcv);
+    }
+}
+
 static void err_cons(prrte_oob_tcp_msg_error_t *ptr)
 {
     ptr->rmsg = NULL;
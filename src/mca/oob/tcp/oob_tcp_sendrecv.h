@@ -45,6 +45,7 @@ typedef struct {
     struct prrte_oob_tcp_peer_t *peer;
     bool activate;
     prrte_oob_tcp_hdr_t hdr;
+    char chdr[MCA_OOB_TCP_CHDR_MAX];  // compact form of hdr, if the peer supports it
     prrte_rml_send_t *msg;
     char *data;
     bool hdr_sent;
@@ -58,6 +59,8 @@ PRRTE_CLASS_DECLARATION(prrte_oob_tcp_send_t);
 typedef struct {
     prrte_list_item_t super;
     prrte_oob_tcp_hdr_t hdr;
+    char chdr[MCA_OOB_TCP_CHDR_MAX];  // compact hdr as read from the wire
+    size_t chdr_len;                  // length of the compact hdr - 0 until its prefix is read
     bool hdr_recvd;
     char *data;
     char *rdptr;
@@ -65,6 +68,29 @@ typedef struct {
 } prrte_oob_tcp_recv_t;
 PRRTE_CLASS_DECLARATION(prrte_oob_tcp_recv_t);
 
+/* buffer that socket reads land in when receiving through
+ * slabs - a single read can bring in several small msgs,
+ * which are then parsed out of the slab without going back
+ * to the socket. A peer only holds a slab while it has
+ * unparsed bytes - otherwise the slab sits in the
+ * component's pool */
+typedef struct {
+    prrte_list_item_t super;
+    char *base;
+    size_t size;
+    char *head;     // next unparsed byte
+    size_t nbytes;  // number of unparsed bytes
+} prrte_oob_tcp_slab_t;
+PRRTE_CLASS_DECLARATION(prrte_oob_tcp_slab_t);
+
+/* get/return send and recv objects from/to the component's
+ * pools - objects that cannot be returned to a pool (e.g.,
+ * because it is full) are simply released */
+PRRTE_MODULE_EXPORT prrte_oob_tcp_send_t* prrte_oob_tcp_send_get(void);
+PRRTE_MODULE_EXPORT void prrte_oob_tcp_send_return(prrte_oob_tcp_send_t *snd);
+PRRTE_MODULE_EXPORT prrte_oob_tcp_recv_t* prrte_oob_tcp_recv_get(void);
+PRRTE_MODULE_EXPORT void prrte_oob_tcp_recv_return(prrte_oob_tcp_recv_t *rcv);
+
 /* Queue a message to be sent to a specified peer. The macro
  * checks to see if a message is already in position to be
  * sent - if it is, then the message provided is simply added
@@ -104,7 +130,7 @@ PRRTE_CLASS_DECLARATION(prrte_oob_tcp_recv_t);
                              PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),        \
                              __FILE__, __LINE__,                        \
                             PRRTE_NAME_PRINT(&((m)->dst)));              \
-        _s = PRRTE_NEW(prrte_oob_tcp_send_t);                              \
+        _s = prrte_oob_tcp_send_get();                                     \
         /* setup the header */                                          \
         _s->hdr.origin = (m)->origin;                                  \
         _s->hdr.dst = (m)->dst;                                        \
@@ -148,7 +174,7 @@ PRRTE_CLASS_DECLARATION(prrte_oob_tcp_recv_t);
                             PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),         \
                             __FILE__, __LINE__,                         \
                             PRRTE_NAME_PRINT(&((m)->dst)));              \
-        _s = PRRTE_NEW(prrte_oob_tcp_send_t);                              \
+        _s = prrte_oob_tcp_send_get();                                     \
         /* setup the header */                                          \
         _s->hdr.origin = (m)->origin;                                  \
         _s->hdr.dst = (m)->dst;                                        \
@@ -191,7 +217,7 @@ PRRTE_CLASS_DECLARATION(prrte_oob_tcp_recv_t);
                             PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),         \
                             __FILE__, __LINE__,                         \
                             PRRTE_NAME_PRINT(&((p)->name)));             \
-        _s = PRRTE_NEW(prrte_oob_tcp_send_t);                              \
+        _s = prrte_oob_tcp_send_get();                                     \
         /* setup the header */                                          \
         _s->hdr.origin = (m)->hdr.origin;                              \
         _s->hdr.dst = (m)->hdr.dst;                                    \
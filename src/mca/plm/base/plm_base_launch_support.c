@@ -989,8 +989,7 @@ void prrte_plm_base_daemon_topology(int status, prrte_process_name_t* sender,
     int rc, idx;
     char *sig, *coprocessors, **sns;
     prrte_proc_t *daemon=NULL;
-    prrte_topology_t *t, *t2;
-    int i;
+    prrte_topology_t *t;
     uint32_t h;
     prrte_job_t *jdata;
     uint8_t flag;
@@ -1066,18 +1065,7 @@ void prrte_plm_base_daemon_topology(int status, prrte_process_name_t* sender,
         goto CLEANUP;
     }
     /* find it in the array */
-    t = NULL;
-    for (i=0; i < prrte_node_topologies->size; i++) {
-        if (NULL == (t2 = (prrte_topology_t*)prrte_pointer_array_get_item(prrte_node_topologies, i))) {
-            continue;
-        }
-        /* just check the signature */
-        if (0 == strcmp(sig, t2->sig)) {
-            t = t2;
-            break;
-        }
-    }
-    if (NULL == t) {
+    if (NULL == (t = prrte_get_topology_object(sig))) {
         /* should never happen */
         PRRTE_ERROR_LOG(PRRTE_ERR_NOT_FOUND);
         prted_failed_launch = true;
@@ -1104,6 +1092,9 @@ void prrte_plm_base_daemon_topology(int status, prrte_process_name_t* sender,
     #else
         sum->available = hwloc_bitmap_dup(hwloc_topology_get_allowed_cpuset(topo));
     #endif
+    /* now that we have the full topology, precompute the
+     * object counts for all the nodes that share it */
+    prrte_hwloc_base_summarize(topo);
 
     /* unpack any coprocessors */
     idx=1;
@@ -1215,7 +1206,6 @@ void prrte_plm_base_daemon_callback(int status, prrte_process_name_t* sender,
     char *sig;
     prrte_topology_t *t;
     hwloc_topology_t topo;
-    int i;
     bool found;
     prrte_daemon_cmd_flag_t cmd;
     char *myendian;
@@ -1501,42 +1491,35 @@ void prrte_plm_base_daemon_callback(int status, prrte_process_name_t* sender,
 
         /* do we already have this topology from some other node? */
         found = false;
-        for (i=0; i < prrte_node_topologies->size; i++) {
-            if (NULL == (t = (prrte_topology_t*)prrte_pointer_array_get_item(prrte_node_topologies, i))) {
-                continue;
+        if (NULL != (t = prrte_get_topology_object(sig))) {
+            PRRTE_OUTPUT_VERBOSE((5, prrte_plm_base_framework.framework_output,
+                                 "%s TOPOLOGY ALREADY RECORDED",
+                                 PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME)));
+            found = true;
+            daemon->node->topology = t;
+            if (NULL != topo) {
+                hwloc_topology_destroy(topo);
             }
-            /* just check the signature */
-            if (0 == strcmp(sig, t->sig)) {
-                PRRTE_OUTPUT_VERBOSE((5, prrte_plm_base_framework.framework_output,
-                                     "%s TOPOLOGY ALREADY RECORDED",
-                                     PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME)));
-                found = true;
-                daemon->node->topology = t;
+            free(sig);
+        }
+#if !PRRTE_ENABLE_HETEROGENEOUS_SUPPORT
+          else {
+            /* check if the difference is due to the endianness */
+            ptr = strrchr(sig, ':');
+            ++ptr;
+            if (0 != strcmp(ptr, myendian)) {
+                /* we don't currently handle multi-endian operations in the
+                 * MPI support */
+                prrte_show_help("help-plm-base", "multi-endian", true,
+                               nodename, ptr, myendian);
+                prted_failed_launch = true;
                 if (NULL != topo) {
                     hwloc_topology_destroy(topo);
                 }
-                free(sig);
-                break;
-            }
-#if !PRRTE_ENABLE_HETEROGENEOUS_SUPPORT
-              else {
-                /* check if the difference is due to the endianness */
-                ptr = strrchr(sig, ':');
-                ++ptr;
-                if (0 != strcmp(ptr, myendian)) {
-                    /* we don't currently handle multi-endian operations in the
-                     * MPI support */
-                    prrte_show_help("help-plm-base", "multi-endian", true,
-                                   nodename, ptr, myendian);
-                    prted_failed_launch = true;
-                    if (NULL != topo) {
-                        hwloc_topology_destroy(topo);
-                    }
-                    goto CLEANUP;
-                }
+                goto CLEANUP;
             }
-#endif
         }
+#endif
 
         if (!found) {
             /* nope - save the signature and request the complete topology from that node */
@@ -1545,11 +1528,15 @@ void prrte_plm_base_daemon_callback(int status, prrte_process_name_t* sender,
                                  PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME)));
             t = PRRTE_NEW(prrte_topology_t);
             t->sig = sig;
-            t->index = prrte_pointer_array_add(prrte_node_topologies, t);
+            t->topo = topo;
+            if (PRRTE_SUCCESS != (rc = prrte_set_topology_object(t))) {
+                PRRTE_ERROR_LOG(rc);
+                PRRTE_RELEASE(t);
+                prted_failed_launch = true;
+                goto CLEANUP;
+            }
             daemon->node->topology = t;
-            if (NULL != topo) {
-                t->topo = topo;
-            } else {
+            if (NULL == topo) {
                 /* nope - save the signature and request the complete topology from that node */
                 PRRTE_OUTPUT_VERBOSE((5, prrte_plm_base_framework.framework_output,
                                      "%s REQUESTING TOPOLOGY FROM %s",
@@ -46,5 +46,8 @@ PRRTE_EXPORT extern const prrte_pstat_base_component_t prrte_pstat_linux_compone
 
 PRRTE_EXPORT extern const prrte_pstat_base_module_t prrte_pstat_linux_module;
 
+/* msecs for which node-level stats are reused */
+extern int prrte_pstat_linux_node_interval;
+
 END_C_DECLS
 #endif /* prrte_pstat_LINUX_EXPORT_H */
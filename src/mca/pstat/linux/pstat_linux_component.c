@@ -45,6 +45,9 @@ const char *prrte_pstat_linux_component_version_string =
  * Local function
  */
 static int pstat_linux_component_query(prrte_mca_base_module_t **module, int *priority);
+static int pstat_linux_component_register(void);
+
+int prrte_pstat_linux_node_interval = 1000;
 
 /*
  * Instantiate the public struct with all of our public information
@@ -65,6 +68,7 @@ const prrte_pstat_base_component_t prrte_pstat_linux_component = {
                                     PRRTE_RELEASE_VERSION),
 
         .mca_query_component = pstat_linux_component_query,
+        .mca_register_component_params = pstat_linux_component_register,
     },
     .base_data = {
         /* The component is checkpoint ready */
@@ -73,6 +77,20 @@ const prrte_pstat_base_component_t prrte_pstat_linux_component = {
 };
 
 
+static int pstat_linux_component_register(void)
+{
+    prrte_pstat_linux_node_interval = 1000;
+    (void) prrte_mca_base_component_var_register(&prrte_pstat_linux_component.base_version,
+                                                 "node_interval",
+                                                 "Time (in msecs) for which the node-level stats (load, memory, "
+                                                 "disk and network) are reused before being sampled again [default: 1000]",
+                                                 PRRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                                 PRRTE_INFO_LVL_9,
+                                                 PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                                 &prrte_pstat_linux_node_interval);
+    return PRRTE_SUCCESS;
+}
+
 static int pstat_linux_component_query(prrte_mca_base_module_t **module, int *priority)
 {
     *priority = 20;
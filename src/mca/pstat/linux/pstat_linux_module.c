@@ -41,9 +41,8 @@
 
 #include <sys/param.h>  /* for HZ to convert jiffies to actual time */
 
+#include "src/class/prrte_hash_table.h"
 #include "src/dss/dss_types.h"
-#include "src/util/argv.h"
-#include "src/util/printf.h"
 
 #include "pstat_linux.h"
 
@@ -66,47 +65,194 @@ const prrte_pstat_base_module_t prrte_pstat_linux_module = {
     linux_module_fini
 };
 
-#define PRRTE_STAT_MAX_LENGTH   1024
+#define PRRTE_STAT_MAX_LENGTH   4096
+
+/* how often (in secs) we close the files of procs
+ * that are no longer being sampled */
+#define PRRTE_STAT_SWEEP_INTERVAL   10
+
+/* a proc being sampled - we keep its /proc files open
+ * so each sample only costs a pread of each file */
+typedef struct {
+    prrte_object_t super;
+    pid_t pid;
+    int stat_fd;
+    int status_fd;
+    int smaps_fd;
+    time_t last_used;
+} prrte_pstat_linux_tracker_t;
+
+static void trkcon(prrte_pstat_linux_tracker_t *p)
+{
+    p->pid = 0;
+    p->stat_fd = -1;
+    p->status_fd = -1;
+    p->smaps_fd = -1;
+    p->last_used = 0;
+}
+static void trkdes(prrte_pstat_linux_tracker_t *p)
+{
+    if (0 <= p->stat_fd) {
+        close(p->stat_fd);
+    }
+    if (0 <= p->status_fd) {
+        close(p->status_fd);
+    }
+    if (0 <= p->smaps_fd) {
+        close(p->smaps_fd);
+    }
+}
+static PRRTE_CLASS_INSTANCE(prrte_pstat_linux_tracker_t,
+                            prrte_object_t,
+                            trkcon, trkdes);
 
 /* Local functions */
-static char *local_getline(FILE *fp);
-static char *local_stripper(char *data);
-static void local_getfields(char *data, char ***fields);
+static int open_proc_file(pid_t pid, const char *file);
+static char *read_file(int fd, ssize_t *len);
+static char *skip_fields(char *ptr, int nfields);
+static char *next_line(char *ptr);
+static void copy_node_stats(prrte_node_stats_t *dest, prrte_node_stats_t *src);
 
 /* Local data */
-static char input[PRRTE_STAT_MAX_LENGTH];
+static prrte_hash_table_t trackers;
+static time_t last_sweep = 0;
+static char *input = NULL;
+static size_t input_size = 0;
+static int loadavg_fd = -1;
+static int meminfo_fd = -1;
+static int diskstats_fd = -1;
+static int netdev_fd = -1;
+static prrte_node_stats_t *node_cache = NULL;
 
 static int linux_module_init(void)
 {
+    PRRTE_CONSTRUCT(&trackers, prrte_hash_table_t);
+    prrte_hash_table_init(&trackers, 256);
+    input_size = PRRTE_STAT_MAX_LENGTH;
+    input = (char*)malloc(input_size);
+    if (NULL == input) {
+        return PRRTE_ERR_OUT_OF_RESOURCE;
+    }
     return PRRTE_SUCCESS;
 }
 
 static int linux_module_fini(void)
 {
+    prrte_pstat_linux_tracker_t *trk;
+    uint32_t key;
+    void *node;
+
+    if (PRRTE_SUCCESS == prrte_hash_table_get_first_key_uint32(&trackers, &key,
+                                                               (void**)&trk, &node)) {
+        do {
+            PRRTE_RELEASE(trk);
+        } while (PRRTE_SUCCESS == prrte_hash_table_get_next_key_uint32(&trackers, &key,
+                                                                       (void**)&trk,
+                                                                       node, &node));
+    }
+    PRRTE_DESTRUCT(&trackers);
+    if (NULL != input) {
+        free(input);
+        input = NULL;
+    }
+    if (0 <= loadavg_fd) {
+        close(loadavg_fd);
+        loadavg_fd = -1;
+    }
+    if (0 <= meminfo_fd) {
+        close(meminfo_fd);
+        meminfo_fd = -1;
+    }
+    if (0 <= diskstats_fd) {
+        close(diskstats_fd);
+        diskstats_fd = -1;
+    }
+    if (0 <= netdev_fd) {
+        close(netdev_fd);
+        netdev_fd = -1;
+    }
+    if (NULL != node_cache) {
+        PRRTE_RELEASE(node_cache);
+        node_cache = NULL;
+    }
     return PRRTE_SUCCESS;
 }
 
-static char *next_field(char *ptr, int barrier)
+/* drop the procs that haven't been sampled since the last
+ * sweep - they have most likely terminated */
+static void sweep_trackers(time_t now)
+{
+    prrte_pstat_linux_tracker_t *trk;
+    pid_t *stale = NULL;
+    int i, nstale = 0, nalloc = 0;
+    uint32_t key;
+    void *node;
+
+    if (PRRTE_SUCCESS == prrte_hash_table_get_first_key_uint32(&trackers, &key,
+                                                               (void**)&trk, &node)) {
+        do {
+            if (trk->last_used < last_sweep) {
+                if (nstale == nalloc) {
+                    nalloc = (0 == nalloc) ? 16 : 2 * nalloc;
+                    stale = (pid_t*)realloc(stale, nalloc * sizeof(pid_t));
+                    if (NULL == stale) {
+                        return;
+                    }
+                }
+                stale[nstale++] = trk->pid;
+            }
+        } while (PRRTE_SUCCESS == prrte_hash_table_get_next_key_uint32(&trackers, &key,
+                                                                       (void**)&trk,
+                                                                       node, &node));
+    }
+    for (i=0; i < nstale; i++) {
+        if (PRRTE_SUCCESS == prrte_hash_table_get_value_uint32(&trackers, stale[i], (void**)&trk)) {
+            prrte_hash_table_remove_value_uint32(&trackers, stale[i]);
+            PRRTE_RELEASE(trk);
+        }
+    }
+    if (NULL != stale) {
+        free(stale);
+    }
+    last_sweep = now;
+}
+
+static prrte_pstat_linux_tracker_t* get_tracker(pid_t pid)
 {
-    int i=0;
+    prrte_pstat_linux_tracker_t *trk;
 
-    /* we are probably pointing to the last char
-     * of the current field, so look for whitespace
-     */
-    while (!isspace(*ptr) && i < barrier) {
-        ptr++;  /* step over the current char */
-        i++;
+    if (PRRTE_SUCCESS == prrte_hash_table_get_value_uint32(&trackers, pid, (void**)&trk)) {
+        return trk;
     }
 
-    /* now look for the next field */
-    while (isspace(*ptr) && i < barrier) {
-        ptr++;
-        i++;
+    /* start tracking this proc */
+    trk = PRRTE_NEW(prrte_pstat_linux_tracker_t);
+    trk->pid = pid;
+    if (0 > (trk->stat_fd = open_proc_file(pid, "stat"))) {
+        /* can't access this file - most likely, this means we
+         * aren't really on a supported system, or the proc no
+         * longer exists. */
+        PRRTE_RELEASE(trk);
+        return NULL;
+    }
+    /* the others are optional */
+    trk->status_fd = open_proc_file(pid, "status");
+    /* smaps_rollup gives us the totals without walking every
+     * mapping, so use it where the kernel provides it */
+    if (0 > (trk->smaps_fd = open_proc_file(pid, "smaps_rollup"))) {
+        trk->smaps_fd = open_proc_file(pid, "smaps");
     }
+    prrte_hash_table_set_value_uint32(&trackers, pid, trk);
+    return trk;
+}
 
-    return ptr;
+static void drop_tracker(prrte_pstat_linux_tracker_t *trk)
+{
+    prrte_hash_table_remove_value_uint32(&trackers, trk->pid);
+    PRRTE_RELEASE(trk);
 }
 
+/* read the value of a "Name:   value kB" line in MBytes */
 static float convert_value(char *value)
 {
     char *ptr;
@@ -115,464 +261,403 @@ static float convert_value(char *value)
     /* compute base value */
     fval = (float)strtoul(value, &ptr, 10);
     /* get the unit multiplier */
-    if (NULL != ptr && NULL != strstr(ptr, "kB")) {
+    while (' ' == *ptr) {
+        ++ptr;
+    }
+    if ('k' == ptr[0] && 'B' == ptr[1]) {
         fval /= 1024.0;
     }
     return fval;
 }
 
-static int query(pid_t pid,
-                 prrte_pstats_t *stats,
-                 prrte_node_stats_t *nstats)
+/* does this line start with the given "Name:" tag? */
+#define PRRTE_STAT_IS_TAG(l, t) \
+    (0 == strncmp((l), (t), sizeof(t) - 1))
+
+static int query_proc(pid_t pid, prrte_pstats_t *stats)
 {
-    char data[4096];
-    int fd;
-    size_t numchars;
-    char *ptr, *eptr;
-    int i;
-    int len, itime;
+    prrte_pstat_linux_tracker_t *trk;
+    char *data, *ptr, *eptr;
+    ssize_t len;
+    int i, itime;
     double dtime;
-    FILE *fp;
-    char *dptr, *value;
-    char **fields;
-    prrte_diskstats_t *ds;
-    prrte_netstats_t *ns;
 
-    if (NULL != stats) {
-        /* record the time of this sample */
-        gettimeofday(&stats->sample_time, NULL);
-        /* check the nstats - don't do gettimeofday twice
-         * as it is expensive
-         */
-        if (NULL != nstats) {
-            nstats->sample_time.tv_sec = stats->sample_time.tv_sec;
-            nstats->sample_time.tv_usec = stats->sample_time.tv_usec;
-        }
-    } else if (NULL != nstats) {
-        /* record the time of this sample */
-        gettimeofday(&nstats->sample_time, NULL);
+    if (NULL == (trk = get_tracker(pid))) {
+        return PRRTE_ERR_FILE_OPEN_FAILURE;
     }
+    trk->last_used = stats->sample_time.tv_sec;
 
-    if (NULL != stats) {
-        /* create the stat filename for this proc */
-        numchars = snprintf(data, sizeof(data), "/proc/%d/stat", pid);
-        if (numchars >= sizeof(data)) {
-            return PRRTE_ERR_VALUE_OUT_OF_BOUNDS;
-        }
-
-        if (0 > (fd = open(data, O_RDONLY))) {
-            /* can't access this file - most likely, this means we
-             * aren't really on a supported system, or the proc no
-             * longer exists. Just return an error
-             */
-            return PRRTE_ERR_FILE_OPEN_FAILURE;
-        }
-
-        /* absorb all of the file's contents in one gulp - we'll process
-         * it once it is in memory for speed
-         */
-        memset(data, 0, sizeof(data));
-        len = read(fd, data, sizeof(data)-1);
-        if (len < 0) {
-            /* This shouldn't happen! */
-            close(fd);
-            return PRRTE_ERR_FILE_OPEN_FAILURE;
-        }
-        close(fd);
-
-        /* remove newline at end */
-        data[len] = '\0';
-
-        /* the stat file consists of a single line in a carefully formatted
-         * form. Parse it field by field as per proc(3) to get the ones we want
-         */
-
-        /* we don't need to read the pid from the file - we already know it! */
-        stats->pid = pid;
+    if (NULL == (data = read_file(trk->stat_fd, &len))) {
+        /* the proc has terminated - if its pid was reused, the
+         * next query will start tracking the new one */
+        drop_tracker(trk);
+        return PRRTE_ERR_FILE_OPEN_FAILURE;
+    }
 
-        /* the cmd is surrounded by parentheses - find the start */
-        if (NULL == (ptr = strchr(data, '('))) {
-            /* no cmd => something wrong with data, return error */
-            return PRRTE_ERR_BAD_PARAM;
-        }
-        /* step over the paren */
-        ptr++;
+    /* the stat file consists of a single line in a carefully formatted
+     * form. Parse it field by field as per proc(3) to get the ones we want
+     */
 
-        /* find the ending paren */
-        if (NULL == (eptr = strchr(ptr, ')'))) {
-            /* no end to cmd => something wrong with data, return error */
-            return PRRTE_ERR_BAD_PARAM;
-        }
+    /* we don't need to read the pid from the file - we already know it! */
+    stats->pid = pid;
 
-        /* save the cmd name, up to the limit of the array */
-        i = 0;
-        while (ptr < eptr && i < PRRTE_PSTAT_MAX_STRING_LEN) {
-            stats->cmd[i++] = *ptr++;
-        }
+    /* the cmd is surrounded by parentheses - find the start */
+    if (NULL == (ptr = strchr(data, '('))) {
+        /* no cmd => something wrong with data, return error */
+        return PRRTE_ERR_BAD_PARAM;
+    }
+    /* step over the paren */
+    ptr++;
 
-        /* move to the next field in the data */
-        ptr = next_field(eptr, len);
-
-        /* next is the process state - a single character */
-        stats->state[0] = *ptr;
-        /* move to next field */
-        ptr = next_field(ptr, len);
-
-        /* skip fields until we get to the times */
-        ptr = next_field(ptr, len); /* ppid */
-        ptr = next_field(ptr, len); /* pgrp */
-        ptr = next_field(ptr, len); /* session */
-        ptr = next_field(ptr, len); /* tty_nr */
-        ptr = next_field(ptr, len); /* tpgid */
-        ptr = next_field(ptr, len); /* flags */
-        ptr = next_field(ptr, len); /* minflt */
-        ptr = next_field(ptr, len); /* cminflt */
-        ptr = next_field(ptr, len); /* majflt */
-        ptr = next_field(ptr, len); /* cmajflt */
-
-        /* grab the process time usage fields */
-        itime = strtoul(ptr, &ptr, 10);    /* utime */
-        itime += strtoul(ptr, &ptr, 10);   /* add the stime */
-        /* convert to time in seconds */
-        dtime = (double)itime / (double)HZ;
-        stats->time.tv_sec = (int)dtime;
-        stats->time.tv_usec = (int)(1000000.0 * (dtime - stats->time.tv_sec));
-        /* move to next field */
-        ptr = next_field(ptr, len);
-
-        /* skip fields until we get to priority */
-        ptr = next_field(ptr, len); /* cutime */
-        ptr = next_field(ptr, len); /* cstime */
-
-        /* save the priority */
-        stats->priority = strtol(ptr, &ptr, 10);
-        /* move to next field */
-        ptr = next_field(ptr, len);
-
-        /* skip nice */
-        ptr = next_field(ptr, len);
-
-        /* get number of threads */
-        stats->num_threads = strtoul(ptr, &ptr, 10);
-        /* move to next field */
-        ptr = next_field(ptr, len);
-
-        /* skip fields until we get to processor id */
-        ptr = next_field(ptr, len);  /* itrealvalue */
-        ptr = next_field(ptr, len);  /* starttime */
-        ptr = next_field(ptr, len);  /* vsize */
-        ptr = next_field(ptr, len);  /* rss */
-        ptr = next_field(ptr, len);  /* rss limit */
-        ptr = next_field(ptr, len);  /* startcode */
-        ptr = next_field(ptr, len);  /* endcode */
-        ptr = next_field(ptr, len);  /* startstack */
-        ptr = next_field(ptr, len);  /* kstkesp */
-        ptr = next_field(ptr, len);  /* kstkeip */
-        ptr = next_field(ptr, len);  /* signal */
-        ptr = next_field(ptr, len);  /* blocked */
-        ptr = next_field(ptr, len);  /* sigignore */
-        ptr = next_field(ptr, len);  /* sigcatch */
-        ptr = next_field(ptr, len);  /* wchan */
-        ptr = next_field(ptr, len);  /* nswap */
-        ptr = next_field(ptr, len);  /* cnswap */
-        ptr = next_field(ptr, len);  /* exit_signal */
-
-        /* finally - get the processor */
-        stats->processor = strtol(ptr, NULL, 10);
-
-        /* that's all we care about from this data - ignore the rest */
-
-        /* now create the status filename for this proc */
-        memset(data, 0, sizeof(data));
-        numchars = snprintf(data, sizeof(data), "/proc/%d/status", pid);
-        if (numchars >= sizeof(data)) {
-            return PRRTE_ERR_VALUE_OUT_OF_BOUNDS;
-        }
+    /* find the ending paren - the cmd itself may contain one */
+    if (NULL == (eptr = strrchr(ptr, ')'))) {
+        /* no end to cmd => something wrong with data, return error */
+        return PRRTE_ERR_BAD_PARAM;
+    }
 
-        if (NULL == (fp = fopen(data, "r"))) {
-            /* ignore this */
-            return PRRTE_SUCCESS;
-        }
+    /* save the cmd name, up to the limit of the array */
+    i = 0;
+    while (ptr < eptr && i < PRRTE_PSTAT_MAX_STRING_LEN) {
+        stats->cmd[i++] = *ptr++;
+    }
 
-        /* parse it according to proc(3) */
-        while (NULL != (dptr = local_getline(fp))) {
-            if (NULL == (value = local_stripper(dptr))) {
-                /* cannot process */
+    /* the remaining fields are single-space separated,
+     * starting with the process state (field 3) */
+    ptr = skip_fields(eptr + 1, 0);
+    stats->state[0] = *ptr;
+
+    /* skip ppid thru cmajflt to get to utime (field 14) */
+    ptr = skip_fields(ptr, 11);
+    itime = strtoul(ptr, &ptr, 10);    /* utime */
+    itime += strtoul(ptr, &ptr, 10);   /* add the stime */
+    /* convert to time in seconds */
+    dtime = (double)itime / (double)HZ;
+    stats->time.tv_sec = (int)dtime;
+    stats->time.tv_usec = (int)(1000000.0 * (dtime - stats->time.tv_sec));
+
+    /* skip cutime and cstime to get to priority (field 18) */
+    ptr = skip_fields(ptr, 2);
+    stats->priority = strtol(ptr, &ptr, 10);
+
+    /* skip nice to get the number of threads (field 20) */
+    ptr = skip_fields(ptr, 1);
+    stats->num_threads = strtoul(ptr, &ptr, 10);
+
+    /* skip itrealvalue thru exit_signal to get the processor (field 39) */
+    ptr = skip_fields(ptr, 18);
+    stats->processor = strtol(ptr, NULL, 10);
+
+    /* that's all we care about from this data - ignore the rest */
+
+    /* now get the memory footprint from the status file */
+    if (0 <= trk->status_fd && NULL != (data = read_file(trk->status_fd, &len))) {
+        for (ptr = data; NULL != ptr; ptr = next_line(ptr)) {
+            if ('V' != ptr[0] || 'm' != ptr[1]) {
                 continue;
             }
-            /* look for VmPeak */
-            if (0 == strncmp(dptr, "VmPeak", strlen("VmPeak"))) {
-                stats->peak_vsize = convert_value(value);
-            } else if (0 == strncmp(dptr, "VmSize", strlen("VmSize"))) {
-                stats->vsize = convert_value(value);
-            } else if (0 == strncmp(dptr, "VmRSS", strlen("VmRSS"))) {
-                stats->rss = convert_value(value);
+            if (PRRTE_STAT_IS_TAG(ptr, "VmPeak:")) {
+                stats->peak_vsize = convert_value(ptr + sizeof("VmPeak:") - 1);
+            } else if (PRRTE_STAT_IS_TAG(ptr, "VmSize:")) {
+                stats->vsize = convert_value(ptr + sizeof("VmSize:") - 1);
+            } else if (PRRTE_STAT_IS_TAG(ptr, "VmRSS:")) {
+                stats->rss = convert_value(ptr + sizeof("VmRSS:") - 1);
             }
         }
-        fclose(fp);
-
-        /* now create the smaps filename for this proc */
-        memset(data, 0, sizeof(data));
-        numchars = snprintf(data, sizeof(data), "/proc/%d/smaps", pid);
-        if (numchars >= sizeof(data)) {
-            return PRRTE_ERR_VALUE_OUT_OF_BOUNDS;
-        }
-
-        if (NULL == (fp = fopen(data, "r"))) {
-            /* ignore this */
-            return PRRTE_SUCCESS;
-        }
+    }
 
-        /* parse it to find lines that start with "Pss" */
-        while (NULL != (dptr = local_getline(fp))) {
-            if (NULL == (value = local_stripper(dptr))) {
-                /* cannot process */
-                continue;
-            }
-            /* look for Pss */
-            if (0 == strncmp(dptr, "Pss", strlen("Pss"))) {
-                stats->pss += convert_value(value);
+    /* and the proportional set size from smaps - if this is
+     * smaps_rollup, there is only one Pss line to add */
+    if (0 <= trk->smaps_fd && NULL != (data = read_file(trk->smaps_fd, &len))) {
+        for (ptr = data; NULL != ptr; ptr = next_line(ptr)) {
+            if ('P' == ptr[0] && PRRTE_STAT_IS_TAG(ptr, "Pss:")) {
+                stats->pss += convert_value(ptr + sizeof("Pss:") - 1);
             }
         }
-        fclose(fp);
     }
 
-    if (NULL != nstats) {
-        /* get the loadavg data */
-        if (0 > (fd = open("/proc/loadavg", O_RDONLY))) {
-            /* not an error if we don't find this one as it
-             * isn't critical
-             */
-            goto diskstats;
-        }
-
-        /* absorb all of the file's contents in one gulp - we'll process
-         * it once it is in memory for speed
-         */
-        memset(data, 0, sizeof(data));
-        len = read(fd, data, sizeof(data)-1);
-        close(fd);
-        if (len < 0) {
-            goto diskstats;
-        }
+    return PRRTE_SUCCESS;
+}
 
-        /* remove newline at end */
-        data[len] = '\0';
+static void query_node(prrte_node_stats_t *nstats)
+{
+    char *data, *ptr, *eptr;
+    ssize_t len;
+    int i;
+    unsigned long vals[11];
+    prrte_diskstats_t *ds;
+    prrte_netstats_t *ns;
 
+    /* get the loadavg data */
+    if (0 > loadavg_fd) {
+        loadavg_fd = open("/proc/loadavg", O_RDONLY | O_CLOEXEC);
+    }
+    /* not an error if we don't find this one as it
+     * isn't critical */
+    if (0 <= loadavg_fd && NULL != (data = read_file(loadavg_fd, &len))) {
         /* we only care about the first three numbers */
         nstats->la = strtof(data, &ptr);
         nstats->la5 = strtof(ptr, &eptr);
         nstats->la15 = strtof(eptr, NULL);
+    }
 
-        /* see if we can open the meminfo file */
-        if (NULL == (fp = fopen("/proc/meminfo", "r"))) {
-            /* ignore this */
-            goto diskstats;
+    if (0 > meminfo_fd) {
+        meminfo_fd = open("/proc/meminfo", O_RDONLY | O_CLOEXEC);
+    }
+    if (0 <= meminfo_fd && NULL != (data = read_file(meminfo_fd, &len))) {
+        for (ptr = data; NULL != ptr; ptr = next_line(ptr)) {
+            if (PRRTE_STAT_IS_TAG(ptr, "MemTotal:")) {
+                nstats->total_mem = convert_value(ptr + sizeof("MemTotal:") - 1);
+            } else if (PRRTE_STAT_IS_TAG(ptr, "MemFree:")) {
+                nstats->free_mem = convert_value(ptr + sizeof("MemFree:") - 1);
+            } else if (PRRTE_STAT_IS_TAG(ptr, "Buffers:")) {
+                nstats->buffers = convert_value(ptr + sizeof("Buffers:") - 1);
+            } else if (PRRTE_STAT_IS_TAG(ptr, "Cached:")) {
+                nstats->cached = convert_value(ptr + sizeof("Cached:") - 1);
+            } else if (PRRTE_STAT_IS_TAG(ptr, "SwapCached:")) {
+                nstats->swap_cached = convert_value(ptr + sizeof("SwapCached:") - 1);
+            } else if (PRRTE_STAT_IS_TAG(ptr, "SwapTotal:")) {
+                nstats->swap_total = convert_value(ptr + sizeof("SwapTotal:") - 1);
+            } else if (PRRTE_STAT_IS_TAG(ptr, "SwapFree:")) {
+                nstats->swap_free = convert_value(ptr + sizeof("SwapFree:") - 1);
+            } else if (PRRTE_STAT_IS_TAG(ptr, "Mapped:")) {
+                nstats->mapped = convert_value(ptr + sizeof("Mapped:") - 1);
+            }
         }
+    }
 
-        /* read the file one line at a time */
-        while (NULL != (dptr = local_getline(fp))) {
-            if (NULL == (value = local_stripper(dptr))) {
-                /* cannot process */
-                continue;
-            }
-            if (0 == strcmp(dptr, "MemTotal")) {
-                nstats->total_mem = convert_value(value);
-            } else if (0 == strcmp(dptr, "MemFree")) {
-                nstats->free_mem = convert_value(value);
-            } else if (0 == strcmp(dptr, "Buffers")) {
-                nstats->buffers = convert_value(value);
-            } else if (0 == strcmp(dptr, "Cached")) {
-                nstats->cached = convert_value(value);
-            } else if (0 == strcmp(dptr, "SwapCached")) {
-                nstats->swap_cached = convert_value(value);
-            } else if (0 == strcmp(dptr, "SwapTotal")) {
-                nstats->swap_total = convert_value(value);
-            } else if (0 == strcmp(dptr, "SwapFree")) {
-                nstats->swap_free = convert_value(value);
-            } else if (0 == strcmp(dptr, "Mapped")) {
-                nstats->mapped = convert_value(value);
+    /* look for the diskstats file */
+    if (0 > diskstats_fd) {
+        diskstats_fd = open("/proc/diskstats", O_RDONLY | O_CLOEXEC);
+    }
+    if (0 <= diskstats_fd && NULL != (data = read_file(diskstats_fd, &len))) {
+        for (ptr = data; NULL != ptr; ptr = next_line(ptr)) {
+            /* each line is: major minor name, followed by the counters */
+            ptr = skip_fields(ptr, 2);
+            eptr = ptr;
+            while ('\0' != *eptr && !isspace(*eptr)) {
+                ++eptr;
             }
-        }
-        fclose(fp);
-
-    diskstats:
-        /* look for the diskstats file */
-        if (NULL == (fp = fopen("/proc/diskstats", "r"))) {
-            /* not an error if we don't find this one as it
-             * isn't critical
-             */
-            goto netstats;
-        }
-        /* read the file one line at a time */
-        while (NULL != (dptr = local_getline(fp))) {
             /* look for the local disks */
-            if (NULL == strstr(dptr, "sd")) {
-                continue;
-            }
-            /* parse to extract the fields */
-            fields = NULL;
-            local_getfields(dptr, &fields);
-            if (NULL == fields) {
-                continue;
-            }
-            if (14 < prrte_argv_count(fields)) {
-                prrte_argv_free(fields);
+            if (NULL == memmem(ptr, eptr - ptr, "sd", 2)) {
                 continue;
             }
-            /* pack the ones of interest into the struct */
             ds = PRRTE_NEW(prrte_diskstats_t);
-            ds->disk = strdup(fields[2]);
-            ds->num_reads_completed = strtoul(fields[3], NULL, 10);
-            ds->num_reads_merged = strtoul(fields[4], NULL, 10);
-            ds->num_sectors_read = strtoul(fields[5], NULL, 10);
-            ds->milliseconds_reading = strtoul(fields[6], NULL, 10);
-            ds->num_writes_completed = strtoul(fields[7], NULL, 10);
-            ds->num_writes_merged = strtoul(fields[8], NULL, 10);
-            ds->num_sectors_written = strtoul(fields[9], NULL, 10);
-            ds->milliseconds_writing = strtoul(fields[10], NULL, 10);
-            ds->num_ios_in_progress = strtoul(fields[11], NULL, 10);
-            ds->milliseconds_io = strtoul(fields[12], NULL, 10);
-            ds->weighted_milliseconds_io = strtoul(fields[13], NULL, 10);
+            ds->disk = strndup(ptr, eptr - ptr);
+            for (i=0; i < 11; i++) {
+                vals[i] = strtoul(eptr, &eptr, 10);
+            }
+            ds->num_reads_completed = vals[0];
+            ds->num_reads_merged = vals[1];
+            ds->num_sectors_read = vals[2];
+            ds->milliseconds_reading = vals[3];
+            ds->num_writes_completed = vals[4];
+            ds->num_writes_merged = vals[5];
+            ds->num_sectors_written = vals[6];
+            ds->milliseconds_writing = vals[7];
+            ds->num_ios_in_progress = vals[8];
+            ds->milliseconds_io = vals[9];
+            ds->weighted_milliseconds_io = vals[10];
             prrte_list_append(&nstats->diskstats, &ds->super);
-            prrte_argv_free(fields);
-        }
-        fclose(fp);
-
-    netstats:
-        /* look for the netstats file */
-        if (NULL == (fp = fopen("/proc/net/dev", "r"))) {
-            /* not an error if we don't find this one as it
-             * isn't critical
-             */
-            goto complete;
         }
+    }
+
+    /* look for the netstats file */
+    if (0 > netdev_fd) {
+        netdev_fd = open("/proc/net/dev", O_RDONLY | O_CLOEXEC);
+    }
+    if (0 <= netdev_fd && NULL != (data = read_file(netdev_fd, &len))) {
         /* skip the first two lines as they are headers */
-        local_getline(fp);
-        local_getline(fp);
-        /* read the file one line at a time */
-        while (NULL != (dptr = local_getline(fp))) {
+        ptr = next_line(data);
+        ptr = (NULL == ptr) ? NULL : next_line(ptr);
+        for (; NULL != ptr; ptr = next_line(ptr)) {
             /* the interface is at the start of the line */
-            if (NULL == (ptr = strchr(dptr, ':'))) {
-                continue;
+            while (' ' == *ptr) {
+                ++ptr;
             }
-            *ptr = '\0';
-            ptr++;
-            /* parse to extract the fields */
-            fields = NULL;
-            local_getfields(ptr, &fields);
-            if (NULL == fields) {
+            if (NULL == (eptr = strchr(ptr, ':'))) {
                 continue;
             }
-            /* pack the ones of interest into the struct */
             ns = PRRTE_NEW(prrte_netstats_t);
-            ns->net_interface = strdup(dptr);
-            ns->num_bytes_recvd = strtoul(fields[0], NULL, 10);
-            ns->num_packets_recvd = strtoul(fields[1], NULL, 10);
-            ns->num_recv_errs = strtoul(fields[2], NULL, 10);
-            ns->num_bytes_sent = strtoul(fields[8], NULL, 10);
-            ns->num_packets_sent = strtoul(fields[9], NULL, 10);
-            ns->num_send_errs = strtoul(fields[10], NULL, 10);
+            ns->net_interface = strndup(ptr, eptr - ptr);
+            ++eptr;
+            for (i=0; i < 11; i++) {
+                vals[i] = strtoul(eptr, &eptr, 10);
+            }
+            ns->num_bytes_recvd = vals[0];
+            ns->num_packets_recvd = vals[1];
+            ns->num_recv_errs = vals[2];
+            ns->num_bytes_sent = vals[8];
+            ns->num_packets_sent = vals[9];
+            ns->num_send_errs = vals[10];
             prrte_list_append(&nstats->netstats, &ns->super);
-            prrte_argv_free(fields);
         }
-        fclose(fp);
     }
-
- complete:
-    return PRRTE_SUCCESS;
 }
 
-static char *local_getline(FILE *fp)
+static int query(pid_t pid,
+                 prrte_pstats_t *stats,
+                 prrte_node_stats_t *nstats)
 {
-    char *ret, *ptr;
-
-    ret = fgets(input, PRRTE_STAT_MAX_LENGTH, fp);
-    if (NULL != ret) {
-        input[strlen(input)-1] = '\0';  /* remove newline */
-        /* strip leading white space */
-        ptr = input;
-        while (!isalnum(*ptr)) {
-            ptr++;
+    struct timeval now;
+    long elapsed;
+    int rc = PRRTE_SUCCESS;
+
+    /* don't do gettimeofday twice as it is expensive */
+    gettimeofday(&now, NULL);
+    if (now.tv_sec - last_sweep >= PRRTE_STAT_SWEEP_INTERVAL) {
+        sweep_trackers(now.tv_sec);
+    }
+
+    if (NULL != stats) {
+        /* record the time of this sample */
+        stats->sample_time = now;
+        rc = query_proc(pid, stats);
+        if (PRRTE_SUCCESS != rc) {
+            return rc;
         }
-        return ptr;
     }
 
-    return NULL;
+    if (NULL != nstats) {
+        /* the node-level values are the same for every proc we are
+         * sampling, so only read them once per sampling interval */
+        if (NULL != node_cache) {
+            elapsed = 1000 * (now.tv_sec - node_cache->sample_time.tv_sec) +
+                      (now.tv_usec - node_cache->sample_time.tv_usec) / 1000;
+            if (elapsed < 0 || prrte_pstat_linux_node_interval <= elapsed) {
+                PRRTE_RELEASE(node_cache);
+                node_cache = NULL;
+            }
+        }
+        if (NULL == node_cache) {
+            node_cache = PRRTE_NEW(prrte_node_stats_t);
+            node_cache->sample_time = now;
+            query_node(node_cache);
+        }
+        copy_node_stats(nstats, node_cache);
+    }
+
+    return PRRTE_SUCCESS;
 }
 
-static char *local_stripper(char *data)
+static int open_proc_file(pid_t pid, const char *file)
 {
-    char *ptr, *end, *enddata;
-    int len = strlen(data);
+    char path[64];
+    size_t numchars;
 
-    /* find the colon */
-    if (NULL == (end = strchr(data, ':'))) {
-        return NULL;
+    numchars = snprintf(path, sizeof(path), "/proc/%d/%s", pid, file);
+    if (numchars >= sizeof(path)) {
+        return -1;
     }
-    ptr = end;
-    --end;
-    /* working backwards, look for first non-whitespace */
-    while (end != data && !isalnum(*end)) {
-        --end;
+    return open(path, O_RDONLY | O_CLOEXEC);
+}
+
+/* read the current contents of a /proc file into our buffer,
+ * growing the buffer if the file doesn't fit. The kernel
+ * regenerates the contents on every read from offset zero */
+static char *read_file(int fd, ssize_t *len)
+{
+    ssize_t n;
+    size_t total = 0;
+    char *tmp;
+
+    while (1) {
+        n = pread(fd, input + total, input_size - total - 1, total);
+        if (n < 0) {
+            if (EINTR == errno) {
+                continue;
+            }
+            return NULL;
+        }
+        if (0 == n) {
+            break;
+        }
+        total += n;
+        if (total == input_size - 1) {
+            tmp = (char*)realloc(input, 2 * input_size);
+            if (NULL == tmp) {
+                break;
+            }
+            input = tmp;
+            input_size *= 2;
+        }
     }
-    ++end;
-    *end = '\0';
-    /* now look for value */
-    ptr++;
-    enddata = &(data[len-1]);
-    while (ptr != enddata && !isalnum(*ptr)) {
+    input[total] = '\0';
+    *len = total;
+    return input;
+}
+
+/* step over the given number of space-separated fields,
+ * returning the start of the field that follows them */
+static char *skip_fields(char *ptr, int nfields)
+{
+    while (' ' == *ptr) {
         ++ptr;
     }
+    while (0 < nfields && '\0' != *ptr && '\n' != *ptr) {
+        if (' ' == *ptr) {
+            while (' ' == *ptr) {
+                ++ptr;
+            }
+            --nfields;
+        } else {
+            ++ptr;
+        }
+    }
     return ptr;
 }
 
-static void local_getfields(char *dptr, char ***fields)
+/* return the start of the next line, or NULL at the end */
+static char *next_line(char *ptr)
 {
-    char *ptr, *end;
-
-    /* set default */
-    *fields = NULL;
-
-    /* find the beginning */
-    ptr = dptr;
-    while ('\0' != *ptr && !isalnum(*ptr)) {
-        ptr++;
-    }
-    if ('\0' == *ptr) {
-        return;
+    if (NULL == (ptr = strchr(ptr, '\n')) || '\0' == ptr[1]) {
+        return NULL;
     }
+    return ptr + 1;
+}
 
-    /* working from this point, find the end of each
-     * alpha-numeric field and store it on the stack.
-     * Then shift across the white space to the start
-     * of the next one
-     */
-    end = ptr;  /* ptr points to an alnum */
-    end++;  /* look at next character */
-    while ('\0' != *end) {
-        /* find the end of this alpha string */
-        while ('\0' != *end && isalnum(*end)) {
-            end++;
-        }
-        /* terminate it */
-        *end = '\0';
-        /* store it on the stack */
-        prrte_argv_append_nosize(fields, ptr);
-        /* step across any white space */
-        end++;
-        while ('\0' != *end && !isalnum(*end)) {
-            end++;
-        }
-        if ('\0' == *end) {
-            ptr = NULL;
-            break;
-        }
-        ptr = end;
-        end++;
+static void copy_node_stats(prrte_node_stats_t *dest, prrte_node_stats_t *src)
+{
+    prrte_diskstats_t *ds, *dsrc;
+    prrte_netstats_t *ns, *nsrc;
+
+    dest->la = src->la;
+    dest->la5 = src->la5;
+    dest->la15 = src->la15;
+    dest->total_mem = src->total_mem;
+    dest->free_mem = src->free_mem;
+    dest->buffers = src->buffers;
+    dest->cached = src->cached;
+    dest->swap_cached = src->swap_cached;
+    dest->swap_total = src->swap_total;
+    dest->swap_free = src->swap_free;
+    dest->mapped = src->mapped;
+    dest->sample_time = src->sample_time;
+
+    PRRTE_LIST_FOREACH(dsrc, &src->diskstats, prrte_diskstats_t) {
+        ds = PRRTE_NEW(prrte_diskstats_t);
+        ds->disk = strdup(dsrc->disk);
+        ds->num_reads_completed = dsrc->num_reads_completed;
+        ds->num_reads_merged = dsrc->num_reads_merged;
+        ds->num_sectors_read = dsrc->num_sectors_read;
+        ds->milliseconds_reading = dsrc->milliseconds_reading;
+        ds->num_writes_completed = dsrc->num_writes_completed;
+        ds->num_writes_merged = dsrc->num_writes_merged;
+        ds->num_sectors_written = dsrc->num_sectors_written;
+        ds->milliseconds_writing = dsrc->milliseconds_writing;
+        ds->num_ios_in_progress = dsrc->num_ios_in_progress;
+        ds->milliseconds_io = dsrc->milliseconds_io;
+        ds->weighted_milliseconds_io = dsrc->weighted_milliseconds_io;
+        prrte_list_append(&dest->diskstats, &ds->super);
     }
-    if (NULL != ptr) {
-        /* have a hanging field */
-        prrte_argv_append_nosize(fields, ptr);
+    PRRTE_LIST_FOREACH(nsrc, &src->netstats, prrte_netstats_t) {
+        ns = PRRTE_NEW(prrte_netstats_t);
+        ns->net_interface = strdup(nsrc->net_interface);
+        ns->num_bytes_recvd = nsrc->num_bytes_recvd;
+        ns->num_packets_recvd = nsrc->num_packets_recvd;
+        ns->num_recv_errs = nsrc->num_recv_errs;
+        ns->num_bytes_sent = nsrc->num_bytes_sent;
+        ns->num_packets_sent = nsrc->num_packets_sent;
+        ns->num_send_errs = nsrc->num_send_errs;
+        prrte_list_append(&dest->netstats, &ns->super);
     }
 }
@@ -49,7 +49,7 @@ prrte_ras_base_module_t prrte_ras_sim_module = {
 
 static int allocate(prrte_job_t *jdata, prrte_list_t *nodes)
 {
-    int i, n, val, dig, num_nodes;
+    int i, n, val, dig, num_nodes, rc;
     prrte_node_t *node;
     prrte_topology_t *t;
     hwloc_topology_t topo;
@@ -188,7 +188,10 @@ static int allocate(prrte_job_t *jdata, prrte_list_t *nodes)
             t = PRRTE_NEW(prrte_topology_t);
             t->topo = topo;
             t->sig = prrte_hwloc_base_get_topo_signature(topo);
-            prrte_pointer_array_add(prrte_node_topologies, t);
+            if (PRRTE_SUCCESS != (rc = prrte_set_topology_object(t))) {
+                PRRTE_ERROR_LOG(rc);
+                goto error_silent;
+            }
         } else {
             if (0 != hwloc_topology_init(&topo)) {
                 prrte_show_help("help-ras-simulator.txt",
@@ -244,7 +247,10 @@ static int allocate(prrte_job_t *jdata, prrte_list_t *nodes)
             t = PRRTE_NEW(prrte_topology_t);
             t->topo = topo;
             t->sig = prrte_hwloc_base_get_topo_signature(topo);
-            prrte_pointer_array_add(prrte_node_topologies, t);
+            if (PRRTE_SUCCESS != (rc = prrte_set_topology_object(t))) {
+                PRRTE_ERROR_LOG(rc);
+                goto error_silent;
+            }
         }
 
         for (i=0; i < num_nodes; i++) {
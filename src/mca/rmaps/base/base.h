@@ -33,6 +33,7 @@
 #include "types.h"
 
 #include "src/class/prrte_list.h"
+#include "src/class/prrte_hash_table.h"
 #include "src/util/printf.h"
 #include "src/mca/mca.h"
 
@@ -66,6 +67,8 @@ typedef struct {
     int cpus_per_rank;
     /* display the map after it is computed */
     bool display_map;
+    /* report per-phase mapping times and peak memory */
+    bool report_timing;
     /* slot list, if provided by user */
     char *slot_list;
     /* default mapping directives */
@@ -75,6 +78,10 @@ typedef struct {
     char *device;
     /* whether or not child jobs should inherit launch directives */
     bool inherit;
+    /* node name -> node object, used to resolve user-given hosts */
+    prrte_hash_table_t node_index;
+    /* parsed -host and hostfile specifications, by content */
+    prrte_hash_table_t host_cache;
 } prrte_rmaps_base_t;
 
 /**
@@ -100,6 +107,23 @@ typedef struct {
 } prrte_rmaps_base_selected_module_t;
 PRRTE_CLASS_DECLARATION(prrte_rmaps_base_selected_module_t);
 
+/*
+ * Cached result of parsing a -host or hostfile specification
+ */
+typedef struct {
+    prrte_object_t super;
+    /* node names in the order given by the user */
+    char **names;
+    /* for -host, the individual entries and the number of slots
+     * requested by each - a negative count means "all available" */
+    char **specs;
+    int *slots;
+    /* for a hostfile, its modification time and size when parsed */
+    time_t mtime;
+    off_t size;
+} prrte_rmaps_base_hosts_t;
+PRRTE_CLASS_DECLARATION(prrte_rmaps_base_hosts_t);
+
 /*
  * Map a job
  */
@@ -134,6 +158,8 @@ PRRTE_EXPORT int prrte_rmaps_base_set_ranking_policy(prrte_ranking_policy_t *pol
 
 PRRTE_EXPORT void prrte_rmaps_base_display_map(prrte_job_t *jdata);
 
+PRRTE_EXPORT void prrte_rmaps_base_release_target_cache(void);
+
 END_C_DECLS
 
 #endif
@@ -197,6 +197,14 @@ static int prrte_rmaps_base_register(prrte_mca_base_register_flag_t flags)
                                        PRRTE_INFO_LVL_9,
                                        PRRTE_MCA_BASE_VAR_SCOPE_READONLY, &prrte_rmaps_base.display_map);
 
+    /* should we report how long each mapping phase took? */
+    prrte_rmaps_base.report_timing = false;
+    (void) prrte_mca_base_var_register("prrte", "rmaps", "base", "report_timing",
+                                       "Whether to report the time spent in each mapping phase and the peak memory footprint after a job is mapped",
+                                       PRRTE_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                       PRRTE_INFO_LVL_9,
+                                       PRRTE_MCA_BASE_VAR_SCOPE_READONLY, &prrte_rmaps_base.report_timing);
+
     rmaps_base_display_devel_map = false;
     (void) prrte_mca_base_var_register("prrte", "rmaps", "base", "display_devel_map",
                                        "Whether to display a developer-detail process map after it is computed",
@@ -244,6 +252,9 @@ static int prrte_rmaps_base_close(void)
         PRRTE_RELEASE(item);
     }
     PRRTE_DESTRUCT(&prrte_rmaps_base.selected_modules);
+    prrte_rmaps_base_release_target_cache();
+    PRRTE_DESTRUCT(&prrte_rmaps_base.host_cache);
+    PRRTE_DESTRUCT(&prrte_rmaps_base.node_index);
 
     return prrte_mca_base_framework_components_close(&prrte_rmaps_base_framework, NULL);
 }
@@ -258,6 +269,10 @@ static int prrte_rmaps_base_open(prrte_mca_base_open_flag_t flags)
 
     /* init the globals */
     PRRTE_CONSTRUCT(&prrte_rmaps_base.selected_modules, prrte_list_t);
+    PRRTE_CONSTRUCT(&prrte_rmaps_base.node_index, prrte_hash_table_t);
+    prrte_hash_table_init(&prrte_rmaps_base.node_index, 1024);
+    PRRTE_CONSTRUCT(&prrte_rmaps_base.host_cache, prrte_hash_table_t);
+    prrte_hash_table_init(&prrte_rmaps_base.host_cache, 64);
     prrte_rmaps_base.slot_list = NULL;
     prrte_rmaps_base.mapping = 0;
     prrte_rmaps_base.ranking = 0;
@@ -28,6 +28,12 @@
 #include "constants.h"
 
 #include <string.h>
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif
+#ifdef HAVE_SYS_RESOURCE_H
+#include <sys/resource.h>
+#endif
 
 #include "src/mca/mca.h"
 #include "src/util/argv.h"
@@ -47,6 +53,50 @@
 #include "src/mca/rmaps/base/base.h"
 #include "src/mca/rmaps/base/rmaps_private.h"
 
+/* per-phase timing support - only active when the user
+ * asked for it via rmaps_base_report_timing */
+#define PRRTE_RMAPS_TIMING_START(t)                        \
+    do {                                                   \
+        if (prrte_rmaps_base.report_timing) {              \
+            (t) = rmaps_timing_now();                      \
+        }                                                  \
+    } while(0)
+
+#define PRRTE_RMAPS_TIMING_REPORT(j, p, t)                 \
+    do {                                                   \
+        if (prrte_rmaps_base.report_timing) {              \
+            rmaps_timing_report((j), (p), (t));            \
+        }                                                  \
+    } while(0)
+
+static double rmaps_timing_now(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return (double)tv.tv_sec + (double)tv.tv_usec / 1000000.0;
+}
+
+static void rmaps_timing_report(prrte_job_t *jdata, const char *phase, double start)
+{
+    long maxrss = 0;
+#ifdef HAVE_SYS_RESOURCE_H
+    struct rusage ru;
+
+    /* note that ru_maxrss is reported in kilobytes on Linux,
+     * but in bytes on some other platforms */
+    if (0 == getrusage(RUSAGE_SELF, &ru)) {
+        maxrss = ru.ru_maxrss;
+    }
+#endif
+
+    prrte_output(0, "%s rmaps:timing job %s nodes %u procs %s phase %s: %.6f sec maxrss %ld",
+                 PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                 PRRTE_JOBID_PRINT(jdata->jobid),
+                 (NULL == jdata->map) ? 0 : (unsigned)jdata->map->num_nodes,
+                 PRRTE_VPID_PRINT(jdata->num_procs),
+                 phase, rmaps_timing_now() - start, maxrss);
+}
 
 void prrte_rmaps_base_map_job(int fd, short args, void *cbdata)
 {
@@ -61,9 +111,11 @@ void prrte_rmaps_base_map_job(int fd, short args, void *cbdata)
     prrte_app_context_t *app;
     bool inherit = false;
     prrte_process_name_t name, *nptr;
+    double tstart = 0.0, ttotal = 0.0;
 
     PRRTE_ACQUIRE_OBJECT(caddy);
     jdata = caddy->jdata;
+    PRRTE_RMAPS_TIMING_START(ttotal);
 
     jdata->state = PRRTE_JOB_STATE_MAP;
 
@@ -393,6 +445,7 @@ void prrte_rmaps_base_map_job(int fd, short args, void *cbdata)
      * the job
      */
     did_map = false;
+    PRRTE_RMAPS_TIMING_START(tstart);
     if (1 == prrte_list_get_size(&prrte_rmaps_base.selected_modules)) {
         /* forced selection */
         mod = (prrte_rmaps_base_selected_module_t*)prrte_list_get_first(&prrte_rmaps_base.selected_modules);
@@ -414,6 +467,10 @@ void prrte_rmaps_base_map_job(int fd, short args, void *cbdata)
         }
     }
 
+    if (did_map) {
+        PRRTE_RMAPS_TIMING_REPORT(jdata, mod->component->mca_component_name, tstart);
+    }
+
     if (did_map && PRRTE_ERR_RESOURCE_BUSY == rc) {
         /* the map was done but nothing could be mapped
          * for launch as all the resources were busy
@@ -452,57 +509,71 @@ void prrte_rmaps_base_map_job(int fd, short args, void *cbdata)
         prrte_get_attribute(&jdata->attributes, PRRTE_JOB_DISPLAY_DIFF, NULL, PRRTE_BOOL)) {
         /* compute the ranks and add the proc objects
          * to the jdata->procs array */
+        PRRTE_RMAPS_TIMING_START(tstart);
         if (PRRTE_SUCCESS != (rc = prrte_rmaps_base_compute_vpids(jdata))) {
             PRRTE_ERROR_LOG(rc);
             jdata->exit_code = rc;
             PRRTE_ACTIVATE_JOB_STATE(jdata, PRRTE_JOB_STATE_MAP_FAILED);
             goto cleanup;
         }
+        PRRTE_RMAPS_TIMING_REPORT(jdata, "compute_vpids", tstart);
         /* compute and save local ranks */
+        PRRTE_RMAPS_TIMING_START(tstart);
         if (PRRTE_SUCCESS != (rc = prrte_rmaps_base_compute_local_ranks(jdata))) {
             PRRTE_ERROR_LOG(rc);
             jdata->exit_code = rc;
             PRRTE_ACTIVATE_JOB_STATE(jdata, PRRTE_JOB_STATE_MAP_FAILED);
             goto cleanup;
         }
+        PRRTE_RMAPS_TIMING_REPORT(jdata, "compute_local_ranks", tstart);
         /* compute and save location assignments */
+        PRRTE_RMAPS_TIMING_START(tstart);
         if (PRRTE_SUCCESS != (rc = prrte_rmaps_base_assign_locations(jdata))) {
             PRRTE_ERROR_LOG(rc);
             jdata->exit_code = rc;
             PRRTE_ACTIVATE_JOB_STATE(jdata, PRRTE_JOB_STATE_MAP_FAILED);
             goto cleanup;
         }
+        PRRTE_RMAPS_TIMING_REPORT(jdata, "assign_locations", tstart);
         /* compute and save bindings */
+        PRRTE_RMAPS_TIMING_START(tstart);
         if (PRRTE_SUCCESS != (rc = prrte_rmaps_base_compute_bindings(jdata))) {
             PRRTE_ERROR_LOG(rc);
             jdata->exit_code = rc;
             PRRTE_ACTIVATE_JOB_STATE(jdata, PRRTE_JOB_STATE_MAP_FAILED);
             goto cleanup;
         }
+        PRRTE_RMAPS_TIMING_REPORT(jdata, "compute_bindings", tstart);
     } else if (!prrte_get_attribute(&jdata->attributes, PRRTE_JOB_FULLY_DESCRIBED, NULL, PRRTE_BOOL)) {
         /* compute and save location assignments */
+        PRRTE_RMAPS_TIMING_START(tstart);
         if (PRRTE_SUCCESS != (rc = prrte_rmaps_base_assign_locations(jdata))) {
             PRRTE_ERROR_LOG(rc);
             jdata->exit_code = rc;
             PRRTE_ACTIVATE_JOB_STATE(jdata, PRRTE_JOB_STATE_MAP_FAILED);
             goto cleanup;
         }
+        PRRTE_RMAPS_TIMING_REPORT(jdata, "assign_locations", tstart);
     } else {
         /* compute and save local ranks */
+        PRRTE_RMAPS_TIMING_START(tstart);
         if (PRRTE_SUCCESS != (rc = prrte_rmaps_base_compute_local_ranks(jdata))) {
             PRRTE_ERROR_LOG(rc);
             jdata->exit_code = rc;
             PRRTE_ACTIVATE_JOB_STATE(jdata, PRRTE_JOB_STATE_MAP_FAILED);
             goto cleanup;
         }
+        PRRTE_RMAPS_TIMING_REPORT(jdata, "compute_local_ranks", tstart);
 
         /* compute and save bindings */
+        PRRTE_RMAPS_TIMING_START(tstart);
         if (PRRTE_SUCCESS != (rc = prrte_rmaps_base_compute_bindings(jdata))) {
             PRRTE_ERROR_LOG(rc);
             jdata->exit_code = rc;
             PRRTE_ACTIVATE_JOB_STATE(jdata, PRRTE_JOB_STATE_MAP_FAILED);
             goto cleanup;
         }
+        PRRTE_RMAPS_TIMING_REPORT(jdata, "compute_bindings", tstart);
     }
 
     /* set the offset so shared memory components can potentially
@@ -519,6 +590,9 @@ void prrte_rmaps_base_map_job(int fd, short args, void *cbdata)
         }
     }
 
+    /* report before displaying so the output time isn't counted */
+    PRRTE_RMAPS_TIMING_REPORT(jdata, "total", ttotal);
+
     if (prrte_get_attribute(&jdata->attributes, PRRTE_JOB_DISPLAY_MAP, NULL, PRRTE_BOOL) ||
         prrte_get_attribute(&jdata->attributes, PRRTE_JOB_DISPLAY_DEVEL_MAP, NULL, PRRTE_BOOL) ||
         prrte_get_attribute(&jdata->attributes, PRRTE_JOB_DISPLAY_DIFF, NULL, PRRTE_BOOL)) {
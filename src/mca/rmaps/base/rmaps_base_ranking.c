@@ -28,6 +28,7 @@
 #include <unistd.h>
 #endif  /* HAVE_UNISTD_H */
 #include <string.h>
+#include <stdlib.h>
 
 #include "src/class/prrte_pointer_array.h"
 #include "src/util/if.h"
@@ -742,16 +743,39 @@ int prrte_rmaps_base_compute_vpids(prrte_job_t *jdata)
     return PRRTE_ERR_NOT_IMPLEMENTED;
 }
 
+/* procs on a node that still need a rank, in the order they
+ * appear in the node's proc array */
+typedef struct {
+    prrte_proc_t *proc;
+    int idx;
+} prrte_rmaps_rank_slot_t;
+
+static int rank_slot_cmp(const void *a, const void *b)
+{
+    const prrte_rmaps_rank_slot_t *sa = (const prrte_rmaps_rank_slot_t*)a;
+    const prrte_rmaps_rank_slot_t *sb = (const prrte_rmaps_rank_slot_t*)b;
+
+    /* order by vpid - procs from different jobs can share a
+     * vpid, so break ties by position on the node */
+    if (sa->proc->name.vpid < sb->proc->name.vpid) {
+        return -1;
+    }
+    if (sa->proc->name.vpid > sb->proc->name.vpid) {
+        return 1;
+    }
+    return (sa->idx < sb->idx) ? -1 : (sa->idx > sb->idx);
+}
+
 int prrte_rmaps_base_compute_local_ranks(prrte_job_t *jdata)
 {
     prrte_std_cntr_t i;
-    int j, k;
+    int j, k, nlocal, nnode, nslots = 0;
     prrte_node_t *node;
-    prrte_proc_t *proc, *psave, *psave2;
-    prrte_vpid_t minv, minv2;
+    prrte_proc_t *proc;
     prrte_local_rank_t local_rank;
     prrte_job_map_t *map;
     prrte_app_context_t *app;
+    prrte_rmaps_rank_slot_t *local = NULL, *noderanks = NULL, *tmp;
 
     PRRTE_OUTPUT_VERBOSE((5, prrte_rmaps_base_framework.framework_output,
                          "%s rmaps:base:compute_usage",
@@ -762,65 +786,73 @@ int prrte_rmaps_base_compute_local_ranks(prrte_job_t *jdata)
 
     /* for each node in the map... */
     for (i=0; i < map->nodes->size; i++) {
-        /* cycle through the array of procs on this node, setting
-         * local and node ranks, until we
-         * have done so for all procs on nodes in this map
-         */
         if (NULL == (node = (prrte_node_t*)prrte_pointer_array_get_item(map->nodes, i))) {
             continue;
         }
 
-        /* init search values */
-        local_rank = 0;
+        /* make sure we have room to track every proc on this node */
+        if (nslots < node->procs->size) {
+            nslots = node->procs->size;
+            tmp = (prrte_rmaps_rank_slot_t*)realloc(local, nslots * sizeof(prrte_rmaps_rank_slot_t));
+            if (NULL == tmp) {
+                PRRTE_ERROR_LOG(PRRTE_ERR_OUT_OF_RESOURCE);
+                free(local);
+                free(noderanks);
+                return PRRTE_ERR_OUT_OF_RESOURCE;
+            }
+            local = tmp;
+            tmp = (prrte_rmaps_rank_slot_t*)realloc(noderanks, nslots * sizeof(prrte_rmaps_rank_slot_t));
+            if (NULL == tmp) {
+                PRRTE_ERROR_LOG(PRRTE_ERR_OUT_OF_RESOURCE);
+                free(local);
+                free(noderanks);
+                return PRRTE_ERR_OUT_OF_RESOURCE;
+            }
+            noderanks = tmp;
+        }
 
-        /* the proc map may have holes in it, so cycle
-         * all the way through and avoid the holes
-         */
+        /* collect the procs that still need a local rank (this
+         * job only) and those that need a node rank (any job).
+         * The proc map may have holes in it, so cycle all the
+         * way through and avoid the holes */
+        nlocal = 0;
+        nnode = 0;
         for (k=0; k < node->procs->size; k++) {
-            /* if this proc is NULL, skip it */
-            if (NULL == prrte_pointer_array_get_item(node->procs, k)) {
+            if (NULL == (proc = (prrte_proc_t*)prrte_pointer_array_get_item(node->procs, k))) {
                 continue;
             }
-            minv = PRRTE_VPID_MAX;
-            minv2 = PRRTE_VPID_MAX;
-            psave = NULL;
-            psave2 = NULL;
-            /* find the minimum vpid proc */
-            for (j=0; j < node->procs->size; j++) {
-                /* if this proc is NULL, skip it */
-                if (NULL == (proc = (prrte_proc_t*)prrte_pointer_array_get_item(node->procs, j))) {
-                    continue;
-                }
-                /* only look at procs for this job when
-                 * determining local rank
-                 */
-                if (proc->name.jobid == jdata->jobid &&
-                    PRRTE_LOCAL_RANK_INVALID == proc->local_rank &&
-                    proc->name.vpid < minv) {
-                    minv = proc->name.vpid;
-                    psave = proc;
-                }
-                /* no matter what job...still have to handle node_rank */
-                if (PRRTE_NODE_RANK_INVALID == proc->node_rank &&
-                    proc->name.vpid < minv2) {
-                    minv2 = proc->name.vpid;
-                    psave2 = proc;
-                }
-            }
-            if (NULL == psave && NULL == psave2) {
-                /* we must have processed them all for this node! */
-                break;
-            }
-            if (NULL != psave) {
-                psave->local_rank = local_rank;
-                ++local_rank;
+            if (proc->name.jobid == jdata->jobid &&
+                PRRTE_LOCAL_RANK_INVALID == proc->local_rank) {
+                local[nlocal].proc = proc;
+                local[nlocal].idx = k;
+                nlocal++;
             }
-            if (NULL != psave2) {
-                psave2->node_rank = node->next_node_rank;
-                node->next_node_rank++;
+            if (PRRTE_NODE_RANK_INVALID == proc->node_rank) {
+                noderanks[nnode].proc = proc;
+                noderanks[nnode].idx = k;
+                nnode++;
             }
         }
+
+        /* ranks are handed out in vpid order */
+        if (1 < nlocal) {
+            qsort(local, nlocal, sizeof(prrte_rmaps_rank_slot_t), rank_slot_cmp);
+        }
+        if (1 < nnode) {
+            qsort(noderanks, nnode, sizeof(prrte_rmaps_rank_slot_t), rank_slot_cmp);
+        }
+        local_rank = 0;
+        for (j=0; j < nlocal; j++) {
+            local[j].proc->local_rank = local_rank;
+            ++local_rank;
+        }
+        for (j=0; j < nnode; j++) {
+            noderanks[j].proc->node_rank = node->next_node_rank;
+            node->next_node_rank++;
+        }
     }
+    free(local);
+    free(noderanks);
 
     /* compute app_rank */
     for (i=0; i < jdata->apps->size; i++) {
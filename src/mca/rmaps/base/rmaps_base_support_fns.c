@@ -29,6 +29,9 @@
 #include <unistd.h>
 #endif  /* HAVE_UNISTD_H */
 #include <string.h>
+#ifdef HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif
 
 #include "src/util/argv.h"
 #include "src/util/if.h"
@@ -133,6 +136,274 @@ int prrte_rmaps_base_filter_nodes(prrte_app_context_t *app,
 }
 
 
+/* flush the host cache once it holds this many specifications */
+#define PRRTE_RMAPS_HOST_CACHE_MAX  256
+
+static void hcon(prrte_rmaps_base_hosts_t *p)
+{
+    p->names = NULL;
+    p->specs = NULL;
+    p->slots = NULL;
+    p->mtime = 0;
+    p->size = 0;
+}
+static void hdes(prrte_rmaps_base_hosts_t *p)
+{
+    if (NULL != p->names) {
+        prrte_argv_free(p->names);
+    }
+    if (NULL != p->specs) {
+        prrte_argv_free(p->specs);
+    }
+    if (NULL != p->slots) {
+        free(p->slots);
+    }
+}
+PRRTE_CLASS_INSTANCE(prrte_rmaps_base_hosts_t,
+                     prrte_object_t,
+                     hcon, hdes);
+
+static void release_table(prrte_hash_table_t *table)
+{
+    void *key, *nptr, *nxt;
+    size_t keysize;
+    prrte_object_t *obj;
+    int rc;
+
+    rc = prrte_hash_table_get_first_key_ptr(table, &key, &keysize, (void**)&obj, &nptr);
+    while (PRRTE_SUCCESS == rc) {
+        PRRTE_RELEASE(obj);
+        rc = prrte_hash_table_get_next_key_ptr(table, &key, &keysize, (void**)&obj, nptr, &nxt);
+        nptr = nxt;
+    }
+    prrte_hash_table_remove_all(table);
+}
+
+void prrte_rmaps_base_release_target_cache(void)
+{
+    release_table(&prrte_rmaps_base.node_index);
+    release_table(&prrte_rmaps_base.host_cache);
+}
+
+/* find the node object for a user-provided host name. Names
+ * are indexed the first time we resolve them so the next job
+ * that uses them doesn't have to search the node pool. Entries
+ * are checked against the pool on every lookup in case the
+ * node has been removed since we cached it */
+static prrte_node_t* lookup_node(char *name)
+{
+    prrte_node_t *node = NULL;
+    size_t len = strlen(name);
+    int i;
+
+    if (PRRTE_SUCCESS == prrte_hash_table_get_value_ptr(&prrte_rmaps_base.node_index,
+                                                        name, len, (void**)&node)) {
+        if (0 <= node->index &&
+            node == (prrte_node_t*)prrte_pointer_array_get_item(prrte_node_pool, node->index) &&
+            prrte_node_match(node, name)) {
+            return node;
+        }
+        /* stale entry */
+        prrte_hash_table_remove_value_ptr(&prrte_rmaps_base.node_index, name, len);
+        PRRTE_RELEASE(node);
+        node = NULL;
+    }
+
+    /* look for an exact match first as that is the cheapest
+     * check, then fall back to checking aliases */
+    for (i=0; i < prrte_node_pool->size; i++) {
+        if (NULL != (node = (prrte_node_t*)prrte_pointer_array_get_item(prrte_node_pool, i)) &&
+            0 == strcmp(node->name, name)) {
+            break;
+        }
+        node = NULL;
+    }
+    if (NULL == node) {
+        for (i=0; i < prrte_node_pool->size; i++) {
+            if (NULL != (node = (prrte_node_t*)prrte_pointer_array_get_item(prrte_node_pool, i)) &&
+                prrte_node_match(node, name)) {
+                break;
+            }
+            node = NULL;
+        }
+    }
+    if (NULL == node || node->index != i) {
+        /* we can only validate entries whose index is correct */
+        return node;
+    }
+
+    PRRTE_RETAIN(node);
+    if (PRRTE_SUCCESS != prrte_hash_table_set_value_ptr(&prrte_rmaps_base.node_index,
+                                                        name, len, node)) {
+        PRRTE_RELEASE(node);
+    }
+    return node;
+}
+
+/* parse the -host entries into names and requested slots
+ * the same way prrte_util_dash_host_compute_slots does. Returns
+ * false if any entry uses the relative node syntax as those
+ * depend on the current state of the node pool */
+static bool parse_dash_host_slots(prrte_rmaps_base_hosts_t *hs, char *hosts)
+{
+    char *cptr;
+    int n;
+
+    hs->specs = prrte_argv_split(hosts, ',');
+    if (NULL == hs->specs) {
+        return true;
+    }
+    hs->slots = (int*)malloc(prrte_argv_count(hs->specs) * sizeof(int));
+    for (n=0; NULL != hs->specs[n]; n++) {
+        if ('+' == hs->specs[n][0]) {
+            return false;
+        }
+        if (NULL != (cptr = strchr(hs->specs[n], ':'))) {
+            *cptr = '\0';
+            ++cptr;
+            if ('*' == *cptr || 0 == strcmp(cptr, "auto")) {
+                hs->slots[n] = -1;
+            } else {
+                hs->slots[n] = strtol(cptr, NULL, 10);
+            }
+        } else {
+            hs->slots[n] = 1;
+        }
+    }
+    return true;
+}
+
+/* get the parsed form of a -host or hostfile specification,
+ * parsing and caching it if we haven't seen it before. The
+ * returned object is retained for the caller */
+static int get_hosts(prrte_rmaps_base_hosts_t **hosts, char *spec, bool hostfile)
+{
+    prrte_rmaps_base_hosts_t *hs = NULL;
+    prrte_list_t nodes;
+    prrte_node_t *nptr;
+    char *key;
+    bool cache = true;
+    int rc;
+#ifdef HAVE_SYS_STAT_H
+    struct stat buf;
+#endif
+
+    *hosts = NULL;
+
+    if (hostfile) {
+#ifdef HAVE_SYS_STAT_H
+        /* a hostfile can change between jobs, so we can only
+         * use the cached version if the file is untouched */
+        if (0 != stat(spec, &buf)) {
+            cache = false;
+        }
+#else
+        cache = false;
+#endif
+    }
+
+    prrte_asprintf(&key, "%s:%s", hostfile ? "hostfile" : "host", spec);
+    if (cache &&
+        PRRTE_SUCCESS == prrte_hash_table_get_value_ptr(&prrte_rmaps_base.host_cache,
+                                                        key, strlen(key), (void**)&hs)) {
+#ifdef HAVE_SYS_STAT_H
+        if (hostfile && (buf.st_mtime != hs->mtime || buf.st_size != hs->size)) {
+            prrte_hash_table_remove_value_ptr(&prrte_rmaps_base.host_cache, key, strlen(key));
+            PRRTE_RELEASE(hs);
+            hs = NULL;
+        }
+#endif
+        if (NULL != hs) {
+            PRRTE_RETAIN(hs);
+            *hosts = hs;
+            free(key);
+            return PRRTE_SUCCESS;
+        }
+    }
+
+    PRRTE_CONSTRUCT(&nodes, prrte_list_t);
+    if (hostfile) {
+        rc = prrte_util_add_hostfile_nodes(&nodes, spec);
+    } else {
+        rc = prrte_util_add_dash_host_nodes(&nodes, spec, false);
+    }
+    if (PRRTE_SUCCESS != rc) {
+        PRRTE_LIST_DESTRUCT(&nodes);
+        free(key);
+        return rc;
+    }
+
+    hs = PRRTE_NEW(prrte_rmaps_base_hosts_t);
+    PRRTE_LIST_FOREACH(nptr, &nodes, prrte_node_t) {
+        prrte_argv_append_nosize(&hs->names, nptr->name);
+    }
+    PRRTE_LIST_DESTRUCT(&nodes);
+    if (hostfile) {
+#ifdef HAVE_SYS_STAT_H
+        if (cache) {
+            hs->mtime = buf.st_mtime;
+            hs->size = buf.st_size;
+        }
+#endif
+    } else if (!parse_dash_host_slots(hs, spec)) {
+        /* relative node syntax - cannot be reused */
+        cache = false;
+        prrte_argv_free(hs->specs);
+        hs->specs = NULL;
+    }
+
+    if (cache) {
+        if (PRRTE_RMAPS_HOST_CACHE_MAX <= prrte_hash_table_get_size(&prrte_rmaps_base.host_cache)) {
+            release_table(&prrte_rmaps_base.host_cache);
+        }
+        PRRTE_RETAIN(hs);
+        if (PRRTE_SUCCESS != prrte_hash_table_set_value_ptr(&prrte_rmaps_base.host_cache,
+                                                            key, strlen(key), hs)) {
+            PRRTE_RELEASE(hs);
+        }
+    }
+    free(key);
+    *hosts = hs;
+    return PRRTE_SUCCESS;
+}
+
+/* check whether a node can be considered for this mapping */
+static bool node_is_usable(prrte_node_t *node, bool novm)
+{
+    /* ignore nodes that are non-usable */
+    if (PRRTE_FLAG_TEST(node, PRRTE_NODE_NON_USABLE)) {
+        return false;
+    }
+    /* ignore nodes that are marked as do-not-use for this mapping */
+    if (PRRTE_NODE_STATE_DO_NOT_USE == node->state) {
+        PRRTE_OUTPUT_VERBOSE((10, prrte_rmaps_base_framework.framework_output,
+                             "NODE %s IS MARKED NO_USE", node->name));
+        /* reset the state so it can be used another time */
+        node->state = PRRTE_NODE_STATE_UP;
+        return false;
+    }
+    if (PRRTE_NODE_STATE_DOWN == node->state) {
+        PRRTE_OUTPUT_VERBOSE((10, prrte_rmaps_base_framework.framework_output,
+                             "NODE %s IS MARKED DOWN", node->name));
+        return false;
+    }
+    if (PRRTE_NODE_STATE_NOT_INCLUDED == node->state) {
+        PRRTE_OUTPUT_VERBOSE((10, prrte_rmaps_base_framework.framework_output,
+                             "NODE %s IS MARKED NO_INCLUDE", node->name));
+        /* not to be used */
+        return false;
+    }
+    /* if this node wasn't included in the vm (e.g., by -host), ignore it,
+     * unless we are mapping prior to launching the vm
+     */
+    if (NULL == node->daemon && !novm) {
+        PRRTE_OUTPUT_VERBOSE((10, prrte_rmaps_base_framework.framework_output,
+                             "NODE %s HAS NO DAEMON", node->name));
+        return false;
+    }
+    return true;
+}
+
 /*
  * Query the registry for all nodes allocated to a specified app_context
  */
@@ -141,14 +412,17 @@ int prrte_rmaps_base_get_target_nodes(prrte_list_t *allocated_nodes, prrte_std_c
                                      bool initial_map, bool silent)
 {
     prrte_list_item_t *item;
-    prrte_node_t *node, *nd, *nptr, *next;
+    prrte_node_t *node, *nd, *next;
     prrte_std_cntr_t num_slots;
     prrte_std_cntr_t i;
     int rc;
     prrte_job_t *daemons;
     bool novm;
-    prrte_list_t nodes;
     char *hosts = NULL;
+    prrte_rmaps_base_hosts_t *hs = NULL;
+    prrte_proc_t *dmn;
+    prrte_hash_table_t reqs;
+    int *req = NULL, *rq;
 
     /** set default answer */
     *total_num_slots = 0;
@@ -163,7 +437,6 @@ int prrte_rmaps_base_get_target_nodes(prrte_list_t *allocated_nodes, prrte_std_c
      * all available nodes and "filter" them
      */
     if (!prrte_managed_allocation) {
-        PRRTE_CONSTRUCT(&nodes, prrte_list_t);
         /* if the app provided a dash-host, and we are not treating
          * them as requested or "soft" locations, then use those nodes
          */
@@ -173,7 +446,7 @@ int prrte_rmaps_base_get_target_nodes(prrte_list_t *allocated_nodes, prrte_std_c
             PRRTE_OUTPUT_VERBOSE((5, prrte_rmaps_base_framework.framework_output,
                                  "%s using dash_host %s",
                                  PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), hosts));
-            if (PRRTE_SUCCESS != (rc = prrte_util_add_dash_host_nodes(&nodes, hosts, false))) {
+            if (PRRTE_SUCCESS != (rc = get_hosts(&hs, hosts, false))) {
                 PRRTE_ERROR_LOG(rc);
                 free(hosts);
                 return rc;
@@ -184,7 +457,7 @@ int prrte_rmaps_base_get_target_nodes(prrte_list_t *allocated_nodes, prrte_std_c
             PRRTE_OUTPUT_VERBOSE((5, prrte_rmaps_base_framework.framework_output,
                                  "%s using hostfile %s",
                                  PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), hosts));
-            if (PRRTE_SUCCESS != (rc = prrte_util_add_hostfile_nodes(&nodes, hosts))) {
+            if (PRRTE_SUCCESS != (rc = get_hosts(&hs, hosts, true))) {
                 free(hosts);
                 PRRTE_ERROR_LOG(rc);
                 return rc;
@@ -200,86 +473,45 @@ int prrte_rmaps_base_get_target_nodes(prrte_list_t *allocated_nodes, prrte_std_c
             goto addknown;
         }
         /** if we still don't have anything */
-        if (0 == prrte_list_get_size(&nodes)) {
+        if (NULL == hs->names) {
             if (!silent) {
                 prrte_show_help("help-prrte-rmaps-base.txt",
                                "prrte-rmaps-base:no-available-resources",
                                true);
             }
-            PRRTE_DESTRUCT(&nodes);
+            PRRTE_RELEASE(hs);
             return PRRTE_ERR_SILENT;
         }
         /* find the nodes in our node array and assemble them
-         * in list order as that is what the user specified. Note
-         * that the prrte_node_t objects on the nodes list are not
-         * fully filled in - they only contain the user-provided
-         * name of the node as a temp object. Thus, we cannot just
-         * check to see if the node pointer matches that of a node
-         * in the node_pool.
+         * in list order as that is what the user specified. The
+         * names are the user-provided ones, so we have to look
+         * them up rather than compare them to the node pool
          */
-        PRRTE_LIST_FOREACH_SAFE(nptr, next, &nodes, prrte_node_t) {
-            for (i=0; i < prrte_node_pool->size; i++) {
-                if (NULL == (node = (prrte_node_t*)prrte_pointer_array_get_item(prrte_node_pool, i))) {
-                    continue;
-                }
-                /* ignore nodes that are non-usable */
-                if (PRRTE_FLAG_TEST(node, PRRTE_NODE_NON_USABLE)) {
-                    continue;
-                }
-                /* ignore nodes that are marked as do-not-use for this mapping */
-                if (PRRTE_NODE_STATE_DO_NOT_USE == node->state) {
-                    PRRTE_OUTPUT_VERBOSE((10, prrte_rmaps_base_framework.framework_output,
-                                         "NODE %s IS MARKED NO_USE", node->name));
-                    /* reset the state so it can be used another time */
-                    node->state = PRRTE_NODE_STATE_UP;
-                    continue;
-                }
-                if (PRRTE_NODE_STATE_DOWN == node->state) {
-                    PRRTE_OUTPUT_VERBOSE((10, prrte_rmaps_base_framework.framework_output,
-                                         "NODE %s IS DOWN", node->name));
-                    continue;
-                }
-                if (PRRTE_NODE_STATE_NOT_INCLUDED == node->state) {
-                    PRRTE_OUTPUT_VERBOSE((10, prrte_rmaps_base_framework.framework_output,
-                                         "NODE %s IS MARKED NO_INCLUDE", node->name));
-                    /* not to be used */
-                    continue;
-                }
-                /* if this node wasn't included in the vm (e.g., by -host), ignore it,
-                 * unless we are mapping prior to launching the vm
-                 */
-                if (NULL == node->daemon && !novm) {
-                    PRRTE_OUTPUT_VERBOSE((10, prrte_rmaps_base_framework.framework_output,
-                                         "NODE %s HAS NO DAEMON", node->name));
-                    continue;
-                }
-                if (!prrte_node_match(node, nptr->name)) {
-                    PRRTE_OUTPUT_VERBOSE((10, prrte_rmaps_base_framework.framework_output,
-                                         "NODE %s DOESNT MATCH NODE %s",
-                                         node->name, nptr->name));
-                    continue;
-                }
-                /* retain a copy for our use in case the item gets
-                 * destructed along the way
+        for (i=0; NULL != hs->names[i]; i++) {
+            if (NULL == (node = lookup_node(hs->names[i]))) {
+                PRRTE_OUTPUT_VERBOSE((10, prrte_rmaps_base_framework.framework_output,
+                                     "NODE %s NOT FOUND", hs->names[i]));
+                continue;
+            }
+            if (!node_is_usable(node, novm)) {
+                continue;
+            }
+            /* retain a copy for our use in case the item gets
+             * destructed along the way
+             */
+            PRRTE_RETAIN(node);
+            if (initial_map) {
+                /* if this is the first app_context we
+                 * are getting for an initial map of a job,
+                 * then mark all nodes as unmapped
                  */
-                PRRTE_RETAIN(node);
-                if (initial_map) {
-                    /* if this is the first app_context we
-                     * are getting for an initial map of a job,
-                     * then mark all nodes as unmapped
-                     */
-                    PRRTE_FLAG_UNSET(node, PRRTE_NODE_FLAG_MAPPED);
-                }
-                /* the list is ordered as per user direction using -host
-                 * or the listing in -hostfile - preserve that ordering */
-                prrte_list_append(allocated_nodes, &node->super);
-                break;
+                PRRTE_FLAG_UNSET(node, PRRTE_NODE_FLAG_MAPPED);
             }
-            /* remove the item from the list as we have allocated it */
-            prrte_list_remove_item(&nodes, (prrte_list_item_t*)nptr);
-            PRRTE_RELEASE(nptr);
+            /* the list is ordered as per user direction using -host
+             * or the listing in -hostfile - preserve that ordering */
+            prrte_list_append(allocated_nodes, &node->super);
         }
-        PRRTE_DESTRUCT(&nodes);
+        PRRTE_RELEASE(hs);
         /* now prune for usage and compute total slots */
         goto complete;
     }
@@ -303,37 +535,32 @@ int prrte_rmaps_base_get_target_nodes(prrte_list_t *allocated_nodes, prrte_std_c
     } else {
         nd = (prrte_node_t*)prrte_list_get_last(allocated_nodes);
     }
-    for (i=1; i < prrte_node_pool->size; i++) {
-        if (NULL != (node = (prrte_node_t*)prrte_pointer_array_get_item(prrte_node_pool, i))) {
-            /* ignore nodes that are non-usable */
-            if (PRRTE_FLAG_TEST(node, PRRTE_NODE_NON_USABLE)) {
+    if (!novm) {
+        /* every usable node has a daemon, so walking the daemons
+         * in vpid order gives us the nodes in daemon order without
+         * having to sort them */
+        for (i=1; i < daemons->procs->size; i++) {
+            if (NULL == (dmn = (prrte_proc_t*)prrte_pointer_array_get_item(daemons->procs, i))) {
                 continue;
             }
-            /* ignore nodes that are marked as do-not-use for this mapping */
-            if (PRRTE_NODE_STATE_DO_NOT_USE == node->state) {
-                PRRTE_OUTPUT_VERBOSE((10, prrte_rmaps_base_framework.framework_output,
-                                     "NODE %s IS MARKED NO_USE", node->name));
-                /* reset the state so it can be used another time */
-                node->state = PRRTE_NODE_STATE_UP;
+            node = dmn->node;
+            if (NULL == node || 0 == node->index || dmn != node->daemon) {
                 continue;
             }
-            if (PRRTE_NODE_STATE_DOWN == node->state) {
-                PRRTE_OUTPUT_VERBOSE((10, prrte_rmaps_base_framework.framework_output,
-                                     "NODE %s IS MARKED DOWN", node->name));
+            if (!node_is_usable(node, novm)) {
                 continue;
             }
-            if (PRRTE_NODE_STATE_NOT_INCLUDED == node->state) {
-                PRRTE_OUTPUT_VERBOSE((10, prrte_rmaps_base_framework.framework_output,
-                                     "NODE %s IS MARKED NO_INCLUDE", node->name));
-                /* not to be used */
-                continue;
+            PRRTE_RETAIN(node);
+            if (initial_map) {
+                PRRTE_FLAG_UNSET(node, PRRTE_NODE_FLAG_MAPPED);
             }
-            /* if this node wasn't included in the vm (e.g., by -host), ignore it,
-             * unless we are mapping prior to launching the vm
-             */
-            if (NULL == node->daemon && !novm) {
-                PRRTE_OUTPUT_VERBOSE((10, prrte_rmaps_base_framework.framework_output,
-                                     "NODE %s HAS NO DAEMON", node->name));
+            prrte_list_append(allocated_nodes, &node->super);
+        }
+        goto filter;
+    }
+    for (i=1; i < prrte_node_pool->size; i++) {
+        if (NULL != (node = (prrte_node_t*)prrte_pointer_array_get_item(prrte_node_pool, i))) {
+            if (!node_is_usable(node, novm)) {
                 continue;
             }
             /* retain a copy for our use in case the item gets
@@ -378,6 +605,7 @@ int prrte_rmaps_base_get_target_nodes(prrte_list_t *allocated_nodes, prrte_std_c
         }
     }
 
+  filter:
     PRRTE_OUTPUT_VERBOSE((5, prrte_rmaps_base_framework.framework_output,
                          "%s Starting with %d nodes in list",
                          PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
@@ -417,6 +645,33 @@ int prrte_rmaps_base_get_target_nodes(prrte_list_t *allocated_nodes, prrte_std_c
     if (PRRTE_MAPPING_DEBUGGER & PRRTE_GET_MAPPING_DIRECTIVE(policy)) {
         num_slots = prrte_list_get_size(allocated_nodes);    // tell the mapper there is one slot/node for debuggers
     } else {
+        /* if the app gave us a -host, then resolve each of its entries
+         * once up front so we don't have to search the entire list for
+         * every node */
+        hosts = NULL;
+        hs = NULL;
+        if (prrte_get_attribute(&app->attributes, PRRTE_APP_DASH_HOST, (void**)&hosts, PRRTE_STRING) &&
+            PRRTE_SUCCESS == get_hosts(&hs, hosts, false) && NULL != hs->specs) {
+            PRRTE_CONSTRUCT(&reqs, prrte_hash_table_t);
+            prrte_hash_table_init(&reqs, prrte_argv_count(hs->specs));
+            /* for each node, the fixed number of slots requested and
+             * the number of times all available slots were requested */
+            req = (int*)calloc(2 * prrte_argv_count(hs->specs), sizeof(int));
+            for (i=0; NULL != hs->specs[i]; i++) {
+                if (NULL == (node = lookup_node(hs->specs[i]))) {
+                    continue;
+                }
+                if (PRRTE_SUCCESS != prrte_hash_table_get_value_ptr(&reqs, &node, sizeof(node), (void**)&rq)) {
+                    rq = &req[2*i];
+                    prrte_hash_table_set_value_ptr(&reqs, &node, sizeof(node), rq);
+                }
+                if (hs->slots[i] < 0) {
+                    rq[1]++;
+                } else {
+                    rq[0] += hs->slots[i];
+                }
+            }
+        }
         PRRTE_LIST_FOREACH_SAFE(node, next, allocated_nodes, prrte_node_t) {
             /* if the hnp was not allocated, or flagged not to be used,
              * then remove it here */
@@ -451,7 +706,13 @@ int prrte_rmaps_base_get_target_nodes(prrte_list_t *allocated_nodes, prrte_std_c
             if (node->slots > node->slots_inuse) {
                 prrte_std_cntr_t s;
                 /* check for any -host allocations */
-                if (prrte_get_attribute(&app->attributes, PRRTE_APP_DASH_HOST, (void**)&hosts, PRRTE_STRING)) {
+                if (NULL != req) {
+                    if (PRRTE_SUCCESS == prrte_hash_table_get_value_ptr(&reqs, &node, sizeof(node), (void**)&rq)) {
+                        s = rq[0] + rq[1] * (node->slots - node->slots_inuse);
+                    } else {
+                        s = 0;
+                    }
+                } else if (NULL != hosts) {
                     s = prrte_util_dash_host_compute_slots(node, hosts);
                 } else {
                     s = node->slots - node->slots_inuse;
@@ -479,6 +740,16 @@ int prrte_rmaps_base_get_target_nodes(prrte_list_t *allocated_nodes, prrte_std_c
                 PRRTE_RELEASE(node);  /* "un-retain" it */
             }
         }
+        if (NULL != req) {
+            PRRTE_DESTRUCT(&reqs);
+            free(req);
+        }
+        if (NULL != hs) {
+            PRRTE_RELEASE(hs);
+        }
+        if (NULL != hosts) {
+            free(hosts);
+        }
     }
 
     /* Sanity check to make sure we have resources available */
@@ -120,6 +120,7 @@ typedef struct {
     prrte_rml_tag_t tag;          // targeted tag
     uint32_t seq_num;             //sequence number
     struct iovec iov;            // the recvd data
+    prrte_buffer_t *buffer;       // shared payload delivered in place of iov
 } prrte_rml_recv_t;
 PRRTE_EXPORT PRRTE_CLASS_DECLARATION(prrte_rml_recv_t);
 
@@ -184,6 +185,34 @@ PRRTE_EXPORT PRRTE_CLASS_DECLARATION(prrte_self_send_xfer_t);
         prrte_event_active(&msg->ev, PRRTE_EV_WRITE, 1);                  \
     } while(0);
 
+/* post a message whose payload is the unread portion of a
+ * buffer that may also be referenced elsewhere (e.g., queued
+ * for relay in the OOB). The buffer is retained, not copied,
+ * and is delivered to the recv callback positioned at its
+ * current unpack_ptr - receivers must therefore treat it as
+ * read-only */
+#define PRRTE_RML_POST_BUFFER(p, t, s, b)                                \
+    do {                                                                \
+        prrte_rml_recv_t *msg;                                           \
+        prrte_output_verbose(5, prrte_rml_base_framework.framework_output, \
+                            "%s Buffer posted at %s:%d for tag %d",     \
+                            PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),         \
+                            __FILE__, __LINE__, (t));                   \
+        msg = PRRTE_NEW(prrte_rml_recv_t);                                 \
+        msg->sender.jobid = (p)->jobid;                                 \
+        msg->sender.vpid = (p)->vpid;                                   \
+        msg->tag = (t);                                                 \
+        msg->seq_num = (s);                                             \
+        PRRTE_RETAIN((b));                                               \
+        msg->buffer = (b);                                              \
+        /* setup the event */                                           \
+        prrte_event_set(prrte_event_base, &msg->ev, -1,                   \
+                       PRRTE_EV_WRITE,                                   \
+                       prrte_rml_base_process_msg, msg);                 \
+        prrte_event_set_priority(&msg->ev, PRRTE_MSG_PRI);                \
+        prrte_event_active(&msg->ev, PRRTE_EV_WRITE, 1);                  \
+    } while(0);
+
 #define PRRTE_RML_ACTIVATE_MESSAGE(m)                            \
     do {                                                        \
         /* setup the event */                                   \
@@ -187,12 +187,16 @@ static void recv_cons(prrte_rml_recv_t *ptr)
 {
     ptr->iov.iov_base = NULL;
     ptr->iov.iov_len = 0;
+    ptr->buffer = NULL;
 }
 static void recv_des(prrte_rml_recv_t *ptr)
 {
     if (NULL != ptr->iov.iov_base) {
         free(ptr->iov.iov_base);
     }
+    if (NULL != ptr->buffer) {
+        PRRTE_RELEASE(ptr->buffer);
+    }
 }
 PRRTE_CLASS_INSTANCE(prrte_rml_recv_t,
                    prrte_list_item_t,
@@ -208,7 +208,15 @@ void prrte_rml_base_process_msg(int fd, short flags, void *cbdata)
         if (PRRTE_EQUAL == prrte_util_compare_name_fields(mask, &msg->sender, &post->peer) &&
             msg->tag == post->tag) {
             /* deliver the data to this location */
-            if (post->buffer_data) {
+            if (NULL != msg->buffer && post->buffer_data) {
+                /* the payload is shared - deliver it in place */
+                post->cbfunc.buffer(PRRTE_SUCCESS, &msg->sender, msg->buffer, msg->tag, post->cbdata);
+                PRRTE_OUTPUT_VERBOSE((5, prrte_rml_base_framework.framework_output,
+                                     "%s message received  bytes from %s for tag %d called callback",
+                                     PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                                     PRRTE_NAME_PRINT(&msg->sender),
+                                     msg->tag));
+            } else if (post->buffer_data) {
                 /* deliver it in a buffer */
                 PRRTE_CONSTRUCT(&buf, prrte_buffer_t);
                 prrte_dss.load(&buf, msg->iov.iov_base, msg->iov.iov_len);
@@ -225,6 +233,13 @@ void prrte_rml_base_process_msg(int fd, short flags, void *cbdata)
                                      msg->tag));
                 PRRTE_DESTRUCT(&buf);
             } else {
+                if (NULL != msg->buffer) {
+                    /* iovec recipients may take ownership of the
+                     * data, so they must be given their own copy */
+                    msg->iov.iov_len = msg->buffer->bytes_used - (msg->buffer->unpack_ptr - msg->buffer->base_ptr);
+                    msg->iov.iov_base = (IOVBASE_TYPE*)malloc(msg->iov.iov_len);
+                    memcpy(msg->iov.iov_base, msg->buffer->unpack_ptr, msg->iov.iov_len);
+                }
                 /* deliver as an iovec */
                 post->cbfunc.iov(PRRTE_SUCCESS, &msg->sender, &msg->iov, 1, msg->tag, post->cbdata);
                 /* the user should have shifted the data to
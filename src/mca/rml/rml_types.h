@@ -183,6 +183,9 @@ BEGIN_C_DECLS
 /* pmix log requests */
 #define PRRTE_RML_TAG_LOGGING                65
 
+/* resource telemetry reports */
+#define PRRTE_RML_TAG_TELEMETRY              66
+
 #define PRRTE_RML_TAG_MAX                   100
 
 
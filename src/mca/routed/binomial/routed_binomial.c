@@ -20,7 +20,6 @@
 
 #include "src/dss/dss.h"
 #include "src/class/prrte_pointer_array.h"
-#include "src/class/prrte_bitmap.h"
 #include "src/util/bit_ops.h"
 #include "src/util/output.h"
 
@@ -72,6 +71,12 @@ static prrte_process_name_t      local_lifeline;
 static int                      num_children;
 static prrte_list_t              my_children;
 static bool                     hnp_direct=true;
+/* everyone beneath me in the tree shares my bits up to and
+ * including my highest set bit, and each of my children adds
+ * a single higher bit - which is recorded here once the child
+ * has been lost */
+static prrte_vpid_t              my_mask = 0;
+static prrte_vpid_t              lost_children = 0;
 
 static int init(void)
 {
@@ -160,11 +165,30 @@ static int update_route(prrte_process_name_t *target,
 }
 
 
+/* return the child through which we reach the given daemon,
+ * or PRRTE_VPID_INVALID if it is not below us in the tree */
+static prrte_vpid_t binomial_next_hop(prrte_vpid_t vpid)
+{
+    prrte_vpid_t diff;
+
+    if (vpid >= prrte_process_info.num_daemons ||
+        (vpid & my_mask) != PRRTE_PROC_MY_NAME->vpid) {
+        return PRRTE_VPID_INVALID;
+    }
+    /* the lowest bit the target has beyond mine is the
+     * one that distinguishes the child leading to it */
+    diff = vpid ^ PRRTE_PROC_MY_NAME->vpid;
+    diff &= ~diff + 1;
+    if (0 == diff || (lost_children & diff)) {
+        return PRRTE_VPID_INVALID;
+    }
+    return PRRTE_PROC_MY_NAME->vpid | diff;
+}
+
 static prrte_process_name_t get_route(prrte_process_name_t *target)
 {
     prrte_process_name_t *ret, daemon;
-    prrte_list_item_t *item;
-    prrte_routed_tree_t *child;
+    prrte_vpid_t vpid;
 
     if (!prrte_routing_is_enabled) {
         ret = target;
@@ -218,24 +242,11 @@ static prrte_process_name_t get_route(prrte_process_name_t *target)
         goto found;
     }
 
-    /* search routing tree for next step to that daemon */
-    for (item = prrte_list_get_first(&my_children);
-            item != prrte_list_get_end(&my_children);
-            item = prrte_list_get_next(item)) {
-        child = (prrte_routed_tree_t*)item;
-        if (child->vpid == daemon.vpid) {
-            /* the child is hosting the proc - just send it there */
-            ret = &daemon;
-            goto found;
-        }
-        /* otherwise, see if the daemon we need is below the child */
-        if (prrte_bitmap_is_set_bit(&child->relatives, daemon.vpid)) {
-            /* yep - we need to step through this child */
-            daemon.vpid = child->vpid;
-
-            ret = &daemon;
-            goto found;
-        }
+    /* compute the next step to that daemon down the tree */
+    if (PRRTE_VPID_INVALID != (vpid = binomial_next_hop(daemon.vpid))) {
+        daemon.vpid = vpid;
+        ret = &daemon;
+        goto found;
     }
 
     /* if we get here, then the target daemon is not beneath
@@ -295,6 +306,8 @@ static int route_lost(const prrte_process_name_t *route)
                                      PRRTE_NAME_PRINT(route)));
                 prrte_list_remove_item(&my_children, item);
                 PRRTE_RELEASE(item);
+                /* route anything beneath it through our parent */
+                lost_children |= route->vpid ^ PRRTE_PROC_MY_NAME->vpid;
                 return PRRTE_SUCCESS;
             }
         }
@@ -327,107 +340,41 @@ static int set_lifeline(prrte_process_name_t *proc)
     return PRRTE_SUCCESS;
 }
 
-static int binomial_tree(int rank, int parent, int me, int num_procs,
-                         int *nchildren, prrte_list_t *childrn,
-                         prrte_bitmap_t *relatives, bool mine)
-{
-    int i, bitmap, peer, hibit, mask, found;
-    prrte_routed_tree_t *child;
-    prrte_bitmap_t *relations;
-
-    PRRTE_OUTPUT_VERBOSE((3, prrte_routed_base_framework.framework_output,
-                         "%s routed:binomial rank %d parent %d me %d num_procs %d",
-                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
-                         rank, parent, me, num_procs));
-
-    /* is this me? */
-    if (me == rank) {
-        bitmap = prrte_cube_dim(num_procs);
-
-        hibit = prrte_hibit(rank, bitmap);
-        --bitmap;
-
-        for (i = hibit + 1, mask = 1 << i; i <= bitmap; ++i, mask <<= 1) {
-            peer = rank | mask;
-            if (peer < num_procs) {
-                child = PRRTE_NEW(prrte_routed_tree_t);
-                child->vpid = peer;
-                PRRTE_OUTPUT_VERBOSE((3, prrte_routed_base_framework.framework_output,
-                                     "%s routed:binomial %d found child %s",
-                                     PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
-                                     rank,
-                                     PRRTE_VPID_PRINT(child->vpid)));
-
-                if (mine) {
-                    /* this is a direct child - add it to my list */
-                    prrte_list_append(childrn, &child->super);
-                    (*nchildren)++;
-                    /* setup the relatives bitmap */
-                    prrte_bitmap_init(&child->relatives, num_procs);
-
-                    /* point to the relatives */
-                    relations = &child->relatives;
-                } else {
-                    /* we are recording someone's relatives - set the bit */
-                    prrte_bitmap_set_bit(relatives, peer);
-                    /* point to this relations */
-                    relations = relatives;
-                }
-                /* search for this child's relatives */
-                binomial_tree(0, 0, peer, num_procs, nchildren, childrn, relations, false);
-            }
-        }
-        return parent;
-    }
-
-    /* find the children of this rank */
-    PRRTE_OUTPUT_VERBOSE((5, prrte_routed_base_framework.framework_output,
-                         "%s routed:binomial find children of rank %d",
-                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), rank));
-    bitmap = prrte_cube_dim(num_procs);
-
-    hibit = prrte_hibit(rank, bitmap);
-    --bitmap;
-
-    for (i = hibit + 1, mask = 1 << i; i <= bitmap; ++i, mask <<= 1) {
-        peer = rank | mask;
-        PRRTE_OUTPUT_VERBOSE((5, prrte_routed_base_framework.framework_output,
-                             "%s routed:binomial find children checking peer %d",
-                             PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), peer));
-        if (peer < num_procs) {
-            PRRTE_OUTPUT_VERBOSE((5, prrte_routed_base_framework.framework_output,
-                                 "%s routed:binomial find children computing tree",
-                                 PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME)));
-            /* execute compute on this child */
-            if (0 <= (found = binomial_tree(peer, rank, me, num_procs, nchildren, childrn, relatives, mine))) {
-                PRRTE_OUTPUT_VERBOSE((5, prrte_routed_base_framework.framework_output,
-                                     "%s routed:binomial find children returning found value %d",
-                                     PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), found));
-                return found;
-            }
-        }
-    }
-    return -1;
-}
-
 static void update_routing_plan(void)
 {
     prrte_routed_tree_t *child;
-    int j;
     prrte_list_item_t *item;
+    prrte_vpid_t me, peer;
+    int i, dim, hibit;
 
     /* clear the list of children if any are already present */
     while (NULL != (item = prrte_list_remove_first(&my_children))) {
         PRRTE_RELEASE(item);
     }
     num_children = 0;
-
-    /* compute my direct children and the bitmap that shows which vpids
-     * lie underneath their branch
-     */
-    PRRTE_PROC_MY_PARENT->vpid = binomial_tree(0, 0, PRRTE_PROC_MY_NAME->vpid,
-                                   prrte_process_info.num_daemons,
-                                   &num_children, &my_children, NULL, true);
+    lost_children = 0;
+
+    /* my parent is me without my highest bit, and my children
+     * are me plus any one higher bit, so long as they exist */
+    me = PRRTE_PROC_MY_NAME->vpid;
+    dim = prrte_cube_dim(prrte_process_info.num_daemons);
+    hibit = prrte_hibit(me, dim);
+    if (hibit < 0) {
+        PRRTE_PROC_MY_PARENT->vpid = 0;
+        my_mask = 0;
+    } else {
+        PRRTE_PROC_MY_PARENT->vpid = me & ~((prrte_vpid_t)1 << hibit);
+        my_mask = ((prrte_vpid_t)1 << hibit << 1) - 1;
+    }
+    for (i = hibit + 1; i < dim; i++) {
+        peer = me | ((prrte_vpid_t)1 << i);
+        if (peer < prrte_process_info.num_daemons) {
+            child = PRRTE_NEW(prrte_routed_tree_t);
+            child->vpid = peer;
+            prrte_list_append(&my_children, &child->super);
+            num_children++;
+        }
+    }
 
     if (0 < prrte_output_get_verbosity(prrte_routed_base_framework.framework_output)) {
         prrte_output(0, "%s: parent %d num_children %d", PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), PRRTE_PROC_MY_PARENT->vpid, num_children);
@@ -436,11 +383,6 @@ static void update_routing_plan(void)
              item = prrte_list_get_next(item)) {
             child = (prrte_routed_tree_t*)item;
             prrte_output(0, "%s: \tchild %d", PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), child->vpid);
-            for (j=0; j < (int)prrte_process_info.num_daemons; j++) {
-                if (prrte_bitmap_is_set_bit(&child->relatives, j)) {
-                    prrte_output(0, "%s: \t\trelation %d", PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), j);
-                }
-            }
         }
     }
 }
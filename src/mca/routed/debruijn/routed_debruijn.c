@@ -17,6 +17,7 @@
 #include "constants.h"
 
 #include <stddef.h>
+#include <stdlib.h>
 
 #include "src/dss/dss.h"
 #include "src/class/prrte_hash_table.h"
@@ -74,6 +75,9 @@ static bool                     hnp_direct=true;
 static int                      log_nranks;
 static int                      log_npeers;
 static unsigned int             rank_mask;
+/* precomputed next hop to each daemon vpid */
+static prrte_vpid_t              *next_hops = NULL;
+static prrte_vpid_t              num_next_hops = 0;
 
 static int init(void)
 {
@@ -108,6 +112,12 @@ static int finalize(void)
     }
     PRRTE_DESTRUCT(&my_children);
 
+    if (NULL != next_hops) {
+        free(next_hops);
+        next_hops = NULL;
+    }
+    num_next_hops = 0;
+
     return PRRTE_SUCCESS;
 }
 
@@ -234,7 +244,11 @@ static prrte_process_name_t get_route(prrte_process_name_t *target)
         }
 
         /* find next hop */
-        ret.vpid = debruijn_next_hop (ret.vpid);
+        if (ret.vpid < num_next_hops) {
+            ret.vpid = next_hops[ret.vpid];
+        } else {
+            ret.vpid = debruijn_next_hop (ret.vpid);
+        }
     } while (0);
 
     PRRTE_OUTPUT_VERBOSE((1, prrte_routed_base_framework.framework_output,
@@ -336,6 +350,7 @@ static void update_routing_plan(void)
     prrte_list_item_t *item;
     int my_vpid = PRRTE_PROC_MY_NAME->vpid;
     int i;
+    prrte_vpid_t v;
 
     /* clear the list of children if any are already present */
     while (NULL != (item = prrte_list_remove_first(&my_children))) {
@@ -375,6 +390,29 @@ static void update_routing_plan(void)
             }
         }
     }
+
+    /* the next hop only depends on the target vpid, so compute
+     * it once for every daemon rather than on every message */
+    if (num_next_hops != prrte_process_info.num_daemons) {
+        if (NULL != next_hops) {
+            free(next_hops);
+        }
+        next_hops = NULL;
+        num_next_hops = 0;
+        if (0 == prrte_process_info.num_daemons) {
+            return;
+        }
+        next_hops = (prrte_vpid_t*)malloc(prrte_process_info.num_daemons * sizeof(prrte_vpid_t));
+        if (NULL == next_hops) {
+            /* get_route will compute each hop as needed */
+            PRRTE_ERROR_LOG(PRRTE_ERR_OUT_OF_RESOURCE);
+            return;
+        }
+    }
+    for (v=0; v < prrte_process_info.num_daemons; v++) {
+        next_hops[v] = debruijn_next_hop(v);
+    }
+    num_next_hops = prrte_process_info.num_daemons;
 }
 
 static void get_routing_list(prrte_list_t *coll)
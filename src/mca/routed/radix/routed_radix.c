@@ -20,10 +20,10 @@
 #include "constants.h"
 
 #include <stddef.h>
+#include <stdlib.h>
 
 #include "src/dss/dss.h"
 #include "src/class/prrte_hash_table.h"
-#include "src/class/prrte_bitmap.h"
 #include "src/util/output.h"
 
 #include "src/mca/errmgr/errmgr.h"
@@ -69,12 +69,25 @@ prrte_routed_module_t prrte_routed_radix_module = {
     .num_routes = num_routes,
 };
 
+/* a radix tree over 32-bit vpids can never be deeper than this */
+#define PRRTE_ROUTED_RADIX_MAX_LEVELS  66
+
 /* local globals */
 static prrte_process_name_t      *lifeline=NULL;
 static prrte_process_name_t      local_lifeline;
 static int                      num_children;
 static prrte_list_t              my_children;
 static bool                     hnp_direct=true;
+/* routing table - the first vpid and width of each level of
+ * the tree, plus the next hop through each of my child slots
+ * (PRRTE_VPID_INVALID once that child has been lost). This
+ * lets us compute the route to any daemon from its vpid */
+static int                      num_levels = 0;
+static int                      my_level = 0;
+static uint64_t                 level_start[PRRTE_ROUTED_RADIX_MAX_LEVELS];
+static uint64_t                 level_width[PRRTE_ROUTED_RADIX_MAX_LEVELS];
+static prrte_vpid_t             *child_hop = NULL;
+static int                      num_child_slots = 0;
 
 static int init(void)
 {
@@ -111,6 +124,13 @@ static int finalize(void)
     PRRTE_DESTRUCT(&my_children);
     num_children = 0;
 
+    if (NULL != child_hop) {
+        free(child_hop);
+        child_hop = NULL;
+    }
+    num_child_slots = 0;
+    num_levels = 0;
+
     return PRRTE_SUCCESS;
 }
 
@@ -164,11 +184,57 @@ static int update_route(prrte_process_name_t *target,
 }
 
 
+/* return the child through which we reach the given daemon,
+ * or PRRTE_VPID_INVALID if it is not below us in the tree */
+static prrte_vpid_t radix_next_hop(prrte_vpid_t vpid)
+{
+    uint64_t offset, slot;
+    int lvl;
+
+    /* everyone below us has a higher vpid */
+    if (vpid <= PRRTE_PROC_MY_NAME->vpid ||
+        vpid >= prrte_process_info.num_daemons ||
+        0 == num_child_slots) {
+        return PRRTE_VPID_INVALID;
+    }
+
+    if (1 == prrte_routed_radix_component.radix) {
+        /* the tree is a chain */
+        return child_hop[0];
+    }
+
+    /* anyone else on my own level is not below me */
+    if (vpid < level_start[my_level+1]) {
+        return PRRTE_VPID_INVALID;
+    }
+
+    /* find the level holding this vpid */
+    for (lvl=my_level+1; lvl < num_levels-1; lvl++) {
+        if (vpid < level_start[lvl+1]) {
+            break;
+        }
+    }
+    offset = vpid - level_start[lvl];
+
+    /* the ancestor of a vpid at any level sits at the same
+     * offset modulo the width of that level - if it isn't
+     * me, then the target is not below me */
+    if (level_start[my_level] + (offset % level_width[my_level]) != PRRTE_PROC_MY_NAME->vpid) {
+        return PRRTE_VPID_INVALID;
+    }
+    /* likewise, the offset of its ancestor on the level
+     * below me tells us which child leads to it */
+    slot = (offset % level_width[my_level+1]) / level_width[my_level];
+    if (slot >= (uint64_t)num_child_slots) {
+        return PRRTE_VPID_INVALID;
+    }
+    return child_hop[slot];
+}
+
 static prrte_process_name_t get_route(prrte_process_name_t *target)
 {
     prrte_process_name_t *ret, daemon;
-    prrte_list_item_t *item;
-    prrte_routed_tree_t *child;
+    prrte_vpid_t vpid;
 
     if (!prrte_routing_is_enabled) {
         ret = target;
@@ -230,25 +296,13 @@ static prrte_process_name_t get_route(prrte_process_name_t *target)
     if (PRRTE_PROC_MY_NAME->vpid == daemon.vpid) {
         ret = target;
         goto found;
-    } else {
-        /* search routing tree for next step to that daemon */
-        for (item = prrte_list_get_first(&my_children);
-             item != prrte_list_get_end(&my_children);
-             item = prrte_list_get_next(item)) {
-            child = (prrte_routed_tree_t*)item;
-            if (child->vpid == daemon.vpid) {
-                /* the child is hosting the proc - just send it there */
-                ret = &daemon;
-                goto found;
-            }
-            /* otherwise, see if the daemon we need is below the child */
-            if (prrte_bitmap_is_set_bit(&child->relatives, daemon.vpid)) {
-                /* yep - we need to step through this child */
-                daemon.vpid = child->vpid;
-                ret = &daemon;
-                goto found;
-            }
-        }
+    }
+
+    /* compute the next step to that daemon down the tree */
+    if (PRRTE_VPID_INVALID != (vpid = radix_next_hop(daemon.vpid))) {
+        daemon.vpid = vpid;
+        ret = &daemon;
+        goto found;
     }
 
     /* if we get here, then the target daemon is not beneath
@@ -272,6 +326,7 @@ static int route_lost(const prrte_process_name_t *route)
 {
     prrte_list_item_t *item;
     prrte_routed_tree_t *child;
+    int i;
 
     PRRTE_OUTPUT_VERBOSE((2, prrte_routed_base_framework.framework_output,
                          "%s route to %s lost",
@@ -304,6 +359,12 @@ static int route_lost(const prrte_process_name_t *route)
             if (child->vpid == route->vpid) {
                 prrte_list_remove_item(&my_children, item);
                 PRRTE_RELEASE(item);
+                /* anything below it now goes via our parent */
+                for (i=0; i < num_child_slots; i++) {
+                    if (child_hop[i] == route->vpid) {
+                        child_hop[i] = PRRTE_VPID_INVALID;
+                    }
+                }
                 return PRRTE_SUCCESS;
             }
         }
@@ -336,11 +397,10 @@ static int set_lifeline(prrte_process_name_t *proc)
 }
 
 static void radix_tree(int rank, int *num_children,
-                       prrte_list_t *children, prrte_bitmap_t *relatives)
+                       prrte_list_t *children)
 {
     int i, peer, Sum, NInLevel;
     prrte_routed_tree_t *child;
-    prrte_bitmap_t *relations;
 
     /* compute how many procs are at my level */
     Sum=1;
@@ -357,25 +417,9 @@ static void radix_tree(int rank, int *num_children,
         if (peer < (int)prrte_process_info.num_daemons) {
             child = PRRTE_NEW(prrte_routed_tree_t);
             child->vpid = peer;
-            if (NULL != children) {
-                /* this is a direct child - add it to my list */
-                prrte_list_append(children, &child->super);
-                (*num_children)++;
-                /* setup the relatives bitmap */
-                prrte_bitmap_init(&child->relatives, prrte_process_info.num_daemons);
-                /* point to the relatives */
-                relations = &child->relatives;
-            } else {
-                /* we are recording someone's relatives - set the bit */
-                if (PRRTE_SUCCESS != prrte_bitmap_set_bit(relatives, peer)) {
-                    prrte_output(0, "%s Error: could not set relations bit!", PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME));
-                }
-                /* point to this relations */
-                relations = relatives;
-                PRRTE_RELEASE(child);
-            }
-            /* search for this child's relatives */
-            radix_tree(peer, NULL, NULL, relations);
+            prrte_list_append(children, &child->super);
+            (*num_children)++;
+            child_hop[i] = peer;
         }
         peer += NInLevel;
     }
@@ -388,6 +432,7 @@ static void update_routing_plan(void)
     prrte_list_item_t *item;
     int Level,Sum,NInLevel,Ii;
     int NInPrevLevel;
+    uint64_t radix = prrte_routed_radix_component.radix;
 
     /* clear the list of children if any are already present */
     while (NULL != (item = prrte_list_remove_first(&my_children))) {
@@ -417,10 +462,54 @@ static void update_routing_plan(void)
         PRRTE_PROC_MY_PARENT->vpid += (Sum - NInPrevLevel);
     }
 
-    /* compute my direct children and the bitmap that shows which vpids
-     * lie underneath their branch
-     */
-    radix_tree(Ii, &num_children, &my_children, NULL);
+    /* lay out the levels of the tree so we can compute the
+     * route to any daemon directly from its vpid */
+    num_levels = 0;
+    my_level = 0;
+    if (1 < radix) {
+        level_start[0] = 0;
+        level_width[0] = 1;
+        num_levels = 1;
+        while (num_levels < PRRTE_ROUTED_RADIX_MAX_LEVELS) {
+            level_start[num_levels] = level_start[num_levels-1] + level_width[num_levels-1];
+            level_width[num_levels] = level_width[num_levels-1] * radix;
+            num_levels++;
+            if (prrte_process_info.num_daemons <= level_start[num_levels-1]) {
+                /* include one empty level so the level below
+                 * the deepest daemon is always defined */
+                break;
+            }
+        }
+        for (j=0; j < num_levels-1; j++) {
+            if ((uint64_t)Ii < level_start[j+1]) {
+                my_level = j;
+                break;
+            }
+        }
+    }
+
+    /* reset the next hop through each child slot */
+    if (num_child_slots != prrte_routed_radix_component.radix) {
+        if (NULL != child_hop) {
+            free(child_hop);
+        }
+        child_hop = NULL;
+        num_child_slots = 0;
+        if (0 < prrte_routed_radix_component.radix) {
+            child_hop = (prrte_vpid_t*)malloc(prrte_routed_radix_component.radix * sizeof(prrte_vpid_t));
+            if (NULL == child_hop) {
+                PRRTE_ERROR_LOG(PRRTE_ERR_OUT_OF_RESOURCE);
+                return;
+            }
+            num_child_slots = prrte_routed_radix_component.radix;
+        }
+    }
+    for (j=0; j < num_child_slots; j++) {
+        child_hop[j] = PRRTE_VPID_INVALID;
+    }
+
+    /* compute my direct children */
+    radix_tree(Ii, &num_children, &my_children);
 
     if (0 < prrte_output_get_verbosity(prrte_routed_base_framework.framework_output)) {
         prrte_output(0, "%s: parent %d num_children %d", PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), PRRTE_PROC_MY_PARENT->vpid, num_children);
@@ -429,11 +518,6 @@ static void update_routing_plan(void)
              item = prrte_list_get_next(item)) {
             child = (prrte_routed_tree_t*)item;
             prrte_output(0, "%s: \tchild %d", PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), child->vpid);
-            for (j=0; j < (int)prrte_process_info.num_daemons; j++) {
-                if (prrte_bitmap_is_set_bit(&child->relatives, j)) {
-                    prrte_output(0, "%s: \t\trelation %d", PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), j);
-                }
-            }
         }
     }
 }
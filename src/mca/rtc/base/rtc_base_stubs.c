@@ -10,6 +10,10 @@
 
 #include "prrte_config.h"
 
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
 #include "src/util/fd.h"
 #include "src/util/show_help.h"
 
@@ -134,6 +138,7 @@ void prrte_rtc_base_send_error_show_help(int fd, int exit_status,
     write_help_msg(fd, &msg, file, topic, ap);
     va_end(ap);
 
-    exit(exit_status);
+    /* we are in the child - don't run the daemon's atexit handlers */
+    _exit(exit_status);
 }
 
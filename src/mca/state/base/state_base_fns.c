@@ -16,6 +16,7 @@
 #include "prrte_config.h"
 #include "constants.h"
 
+#include <string.h>
 #if HAVE_UNISTD_H
 #include <unistd.h>
 #endif
@@ -48,63 +49,148 @@
 #include "src/mca/state/base/base.h"
 #include "src/mca/state/base/state_private.h"
 
+/* Direct-indexed dispatch tables for the job and proc state
+ * machines. The lists remain the authoritative record of the
+ * state machine - the tables are rebuilt from them whenever a
+ * state is added/removed or has its callback changed. States
+ * that fall outside the table (e.g., dynamically defined ones)
+ * are found by searching the list */
+#define PRRTE_STATE_DISPATCH_SIZE   128
+
+typedef struct {
+    prrte_state_t *states[PRRTE_STATE_DISPATCH_SIZE];
+    prrte_state_t *any;
+    prrte_state_t *error;
+    /* at least one state lies outside the table */
+    bool overflow;
+} prrte_state_dispatch_t;
+
+static prrte_state_dispatch_t job_dispatch = {{0}};
+static prrte_state_dispatch_t proc_dispatch = {{0}};
+
+/* Proc state updates for batching callbacks that arrive before the
+ * event loop gets around to processing them are collected into a
+ * single caddy. Like the rest of the state machine, this is only
+ * accessed from within the PRRTE event base */
+#define PRRTE_STATE_MAX_PENDING   8
+
+typedef struct {
+    prrte_state_cbfunc_t cbfunc;
+    int priority;
+    prrte_state_caddy_t *caddy;
+} prrte_state_pending_t;
+
+static prrte_state_pending_t pending[PRRTE_STATE_MAX_PENDING];
+static int npending = 0;
+
+static void rebuild_job_dispatch(void)
+{
+    prrte_state_t *st;
+
+    memset(&job_dispatch, 0, sizeof(job_dispatch));
+    PRRTE_LIST_FOREACH(st, &prrte_job_states, prrte_state_t) {
+        if (PRRTE_JOB_STATE_ANY == st->job_state) {
+            job_dispatch.any = st;
+        } else if (0 <= st->job_state && st->job_state < PRRTE_STATE_DISPATCH_SIZE) {
+            job_dispatch.states[st->job_state] = st;
+        } else {
+            job_dispatch.overflow = true;
+        }
+        if (PRRTE_JOB_STATE_ERROR == st->job_state) {
+            job_dispatch.error = st;
+        }
+    }
+}
+
+static void rebuild_proc_dispatch(void)
+{
+    prrte_state_t *st;
+
+    memset(&proc_dispatch, 0, sizeof(proc_dispatch));
+    PRRTE_LIST_FOREACH(st, &prrte_proc_states, prrte_state_t) {
+        if (PRRTE_PROC_STATE_ANY == st->proc_state) {
+            proc_dispatch.any = st;
+        } else if (st->proc_state < PRRTE_STATE_DISPATCH_SIZE) {
+            proc_dispatch.states[st->proc_state] = st;
+        } else {
+            proc_dispatch.overflow = true;
+        }
+        if (PRRTE_PROC_STATE_ERROR == st->proc_state) {
+            proc_dispatch.error = st;
+        }
+    }
+}
+
+void prrte_state_base_clear_dispatch(void)
+{
+    memset(&job_dispatch, 0, sizeof(job_dispatch));
+    memset(&proc_dispatch, 0, sizeof(proc_dispatch));
+}
+
+static prrte_state_t* find_job_state(prrte_job_state_t state)
+{
+    prrte_state_t *st;
+
+    if (0 <= state && state < PRRTE_STATE_DISPATCH_SIZE) {
+        return job_dispatch.states[state];
+    }
+    if (job_dispatch.overflow) {
+        PRRTE_LIST_FOREACH(st, &prrte_job_states, prrte_state_t) {
+            if (st->job_state == state) {
+                return st;
+            }
+        }
+    }
+    return NULL;
+}
+
+static prrte_state_t* find_proc_state(prrte_proc_state_t state)
+{
+    prrte_state_t *st;
+
+    if (state < PRRTE_STATE_DISPATCH_SIZE) {
+        return proc_dispatch.states[state];
+    }
+    if (proc_dispatch.overflow) {
+        PRRTE_LIST_FOREACH(st, &prrte_proc_states, prrte_state_t) {
+            if (st->proc_state == state) {
+                return st;
+            }
+        }
+    }
+    return NULL;
+}
+
 void prrte_state_base_activate_job_state(prrte_job_t *jdata,
                                         prrte_job_state_t state)
 {
-    prrte_list_item_t *itm, *any=NULL, *error=NULL;
     prrte_state_t *s;
     prrte_state_caddy_t *caddy;
 
-    for (itm = prrte_list_get_first(&prrte_job_states);
-         itm != prrte_list_get_end(&prrte_job_states);
-         itm = prrte_list_get_next(itm)) {
-        s = (prrte_state_t*)itm;
-        if (s->job_state == PRRTE_JOB_STATE_ANY) {
-            /* save this place */
-            any = itm;
-        }
-        if (s->job_state == PRRTE_JOB_STATE_ERROR) {
-            error = itm;
+    if (NULL == (s = find_job_state(state))) {
+        /* the state wasn't found, so execute the default
+         * handler if it is defined
+         */
+        if (PRRTE_JOB_STATE_ERROR < state && NULL != job_dispatch.error) {
+            s = job_dispatch.error;
+        } else if (NULL != job_dispatch.any) {
+            s = job_dispatch.any;
+        } else {
+            PRRTE_OUTPUT_VERBOSE((1, prrte_state_base_framework.framework_output,
+                                 "ACTIVATE: JOB STATE %s NOT REGISTERED", prrte_job_state_to_str(state)));
+            return;
         }
-        if (s->job_state == state) {
+        if (NULL == s->cbfunc) {
             PRRTE_OUTPUT_VERBOSE((1, prrte_state_base_framework.framework_output,
-                                 "%s ACTIVATING JOB %s STATE %s PRI %d",
-                                 PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
-                                 (NULL == jdata) ? "NULL" : PRRTE_JOBID_PRINT(jdata->jobid),
-                                 prrte_job_state_to_str(state), s->priority));
-            if (NULL == s->cbfunc) {
-                PRRTE_OUTPUT_VERBOSE((1, prrte_state_base_framework.framework_output,
-                                     "%s NULL CBFUNC FOR JOB %s STATE %s",
-                                     PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
-                                     (NULL == jdata) ? "ALL" : PRRTE_JOBID_PRINT(jdata->jobid),
-                                     prrte_job_state_to_str(state)));
-                return;
-            }
-            caddy = PRRTE_NEW(prrte_state_caddy_t);
-            if (NULL != jdata) {
-                caddy->jdata = jdata;
-                caddy->job_state = state;
-                PRRTE_RETAIN(jdata);
-            }
-            PRRTE_THREADSHIFT(caddy, prrte_event_base, s->cbfunc, s->priority);
+                                 "ACTIVATE: ANY STATE HANDLER NOT DEFINED"));
             return;
         }
-    }
-    /* if we get here, then the state wasn't found, so execute
-     * the default handler if it is defined
-     */
-    if (PRRTE_JOB_STATE_ERROR < state && NULL != error) {
-        s = (prrte_state_t*)error;
-    } else if (NULL != any) {
-        s = (prrte_state_t*)any;
-    } else {
-        PRRTE_OUTPUT_VERBOSE((1, prrte_state_base_framework.framework_output,
-                             "ACTIVATE: JOB STATE %s NOT REGISTERED", prrte_job_state_to_str(state)));
-        return;
-    }
-    if (NULL == s->cbfunc) {
+    } else if (NULL == s->cbfunc) {
         PRRTE_OUTPUT_VERBOSE((1, prrte_state_base_framework.framework_output,
-                             "ACTIVATE: ANY STATE HANDLER NOT DEFINED"));
+                             "%s NULL CBFUNC FOR JOB %s STATE %s",
+                             PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                             (NULL == jdata) ? "ALL" : PRRTE_JOBID_PRINT(jdata->jobid),
+                             prrte_job_state_to_str(state)));
         return;
     }
     caddy = PRRTE_NEW(prrte_state_caddy_t);
@@ -147,6 +233,7 @@ int prrte_state_base_add_job_state(prrte_job_state_t state,
     st->cbfunc = cbfunc;
     st->priority = priority;
     prrte_list_append(&prrte_job_states, &(st->super));
+    rebuild_job_dispatch();
 
     return PRRTE_SUCCESS;
 }
@@ -163,6 +250,7 @@ int prrte_state_base_set_job_state_callback(prrte_job_state_t state,
         st = (prrte_state_t*)item;
         if (st->job_state == state) {
             st->cbfunc = cbfunc;
+            rebuild_job_dispatch();
             return PRRTE_SUCCESS;
         }
     }
@@ -173,6 +261,7 @@ int prrte_state_base_set_job_state_callback(prrte_job_state_t state,
     st->cbfunc = cbfunc;
     st->priority = PRRTE_SYS_PRI;
     prrte_list_append(&prrte_job_states, &(st->super));
+    rebuild_job_dispatch();
 
     return PRRTE_SUCCESS;
 }
@@ -207,6 +296,7 @@ int prrte_state_base_remove_job_state(prrte_job_state_t state)
         if (st->job_state == state) {
             prrte_list_remove_item(&prrte_job_states, item);
             PRRTE_RELEASE(item);
+            rebuild_job_dispatch();
             return PRRTE_SUCCESS;
         }
     }
@@ -231,71 +321,128 @@ void prrte_state_base_print_job_state_machine(void)
 
 
 /****    PROC STATE MACHINE    ****/
+static void fire_batch(int fd, short args, void *cbdata)
+{
+    prrte_state_caddy_t *caddy = (prrte_state_caddy_t*)cbdata;
+    prrte_state_cbfunc_t cbfunc = NULL;
+    int n;
+
+    /* detach the batch so that any proc states activated
+     * by the callback start a new one */
+    for (n=0; n < npending; n++) {
+        if (pending[n].caddy == caddy) {
+            cbfunc = pending[n].cbfunc;
+            --npending;
+            pending[n] = pending[npending];
+            break;
+        }
+    }
+    if (NULL == cbfunc) {
+        PRRTE_ERROR_LOG(PRRTE_ERR_NOT_FOUND);
+        PRRTE_RELEASE(caddy);
+        return;
+    }
+    cbfunc(fd, args, caddy);
+}
+
+static bool batch_proc_state(prrte_state_t *s,
+                             prrte_process_name_t *proc,
+                             prrte_proc_state_t state)
+{
+    prrte_state_caddy_t *caddy;
+    prrte_state_proc_update_t *tmp;
+    int n;
+
+    /* add to the batch already pending for this callback, if any */
+    for (n=0; n < npending; n++) {
+        if (pending[n].cbfunc == s->cbfunc &&
+            pending[n].priority == s->priority) {
+            caddy = pending[n].caddy;
+            if (caddy->nprocs == caddy->nalloc) {
+                tmp = (prrte_state_proc_update_t*)realloc(caddy->procs,
+                                                          2 * caddy->nalloc * sizeof(prrte_state_proc_update_t));
+                if (NULL == tmp) {
+                    return false;
+                }
+                caddy->procs = tmp;
+                caddy->nalloc *= 2;
+            }
+            caddy->procs[caddy->nprocs].name = *proc;
+            caddy->procs[caddy->nprocs].state = state;
+            caddy->nprocs++;
+            return true;
+        }
+    }
+    if (PRRTE_STATE_MAX_PENDING == npending) {
+        return false;
+    }
+
+    /* start a new batch */
+    caddy = PRRTE_NEW(prrte_state_caddy_t);
+    caddy->nalloc = 16;
+    caddy->procs = (prrte_state_proc_update_t*)malloc(caddy->nalloc * sizeof(prrte_state_proc_update_t));
+    if (NULL == caddy->procs) {
+        PRRTE_RELEASE(caddy);
+        return false;
+    }
+    caddy->name = *proc;
+    caddy->proc_state = state;
+    caddy->procs[0].name = *proc;
+    caddy->procs[0].state = state;
+    caddy->nprocs = 1;
+    pending[npending].cbfunc = s->cbfunc;
+    pending[npending].priority = s->priority;
+    pending[npending].caddy = caddy;
+    npending++;
+    PRRTE_THREADSHIFT(caddy, prrte_event_base, fire_batch, s->priority);
+    return true;
+}
+
 void prrte_state_base_activate_proc_state(prrte_process_name_t *proc,
                                          prrte_proc_state_t state)
 {
-    prrte_list_item_t *itm, *any=NULL, *error=NULL;
     prrte_state_t *s;
     prrte_state_caddy_t *caddy;
 
-    for (itm = prrte_list_get_first(&prrte_proc_states);
-         itm != prrte_list_get_end(&prrte_proc_states);
-         itm = prrte_list_get_next(itm)) {
-        s = (prrte_state_t*)itm;
-        if (s->proc_state == PRRTE_PROC_STATE_ANY) {
-            /* save this place */
-            any = itm;
-        }
-        if (s->proc_state == PRRTE_PROC_STATE_ERROR) {
-            error = itm;
+    if (NULL == (s = find_proc_state(state))) {
+        /* the state wasn't found, so execute the default
+         * handler if it is defined
+         */
+        if (PRRTE_PROC_STATE_ERROR < state && NULL != proc_dispatch.error) {
+            s = proc_dispatch.error;
+        } else if (NULL != proc_dispatch.any) {
+            s = proc_dispatch.any;
+        } else {
+            PRRTE_OUTPUT_VERBOSE((1, prrte_state_base_framework.framework_output,
+                                 "INCREMENT: ANY STATE NOT FOUND"));
+            return;
         }
-        if (s->proc_state == state) {
+        if (NULL == s->cbfunc) {
             PRRTE_OUTPUT_VERBOSE((1, prrte_state_base_framework.framework_output,
-                                 "%s ACTIVATING PROC %s STATE %s PRI %d",
-                                 PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
-                                 PRRTE_NAME_PRINT(proc),
-                                 prrte_proc_state_to_str(state), s->priority));
-            if (NULL == s->cbfunc) {
-                PRRTE_OUTPUT_VERBOSE((1, prrte_state_base_framework.framework_output,
-                                     "%s NULL CBFUNC FOR PROC %s STATE %s",
-                                     PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
-                                     PRRTE_NAME_PRINT(proc),
-                                     prrte_proc_state_to_str(state)));
-                return;
-            }
-            caddy = PRRTE_NEW(prrte_state_caddy_t);
-            caddy->name = *proc;
-            caddy->proc_state = state;
-            PRRTE_THREADSHIFT(caddy, prrte_event_base, s->cbfunc, s->priority);
+                                 "ACTIVATE: ANY STATE HANDLER NOT DEFINED"));
             return;
         }
-    }
-    /* if we get here, then the state wasn't found, so execute
-     * the default handler if it is defined
-     */
-    if (PRRTE_PROC_STATE_ERROR < state && NULL != error) {
-        s = (prrte_state_t*)error;
-    } else if (NULL != any) {
-        s = (prrte_state_t*)any;
-    } else {
+    } else if (NULL == s->cbfunc) {
         PRRTE_OUTPUT_VERBOSE((1, prrte_state_base_framework.framework_output,
-                             "INCREMENT: ANY STATE NOT FOUND"));
+                             "%s NULL CBFUNC FOR PROC %s STATE %s",
+                             PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                             PRRTE_NAME_PRINT(proc),
+                             prrte_proc_state_to_str(state)));
         return;
     }
-    if (NULL == s->cbfunc) {
-        PRRTE_OUTPUT_VERBOSE((1, prrte_state_base_framework.framework_output,
-                             "ACTIVATE: ANY STATE HANDLER NOT DEFINED"));
-        return;
-    }
-    caddy = PRRTE_NEW(prrte_state_caddy_t);
-    caddy->name = *proc;
-    caddy->proc_state = state;
     PRRTE_OUTPUT_VERBOSE((1, prrte_state_base_framework.framework_output,
                          "%s ACTIVATING PROC %s STATE %s PRI %d",
                          PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
                          PRRTE_NAME_PRINT(proc),
                          prrte_proc_state_to_str(state), s->priority));
-     PRRTE_THREADSHIFT(caddy, prrte_event_base, s->cbfunc, s->priority);
+    if (s->batch && prrte_state_base_batch_procs &&
+        batch_proc_state(s, proc, state)) {
+        return;
+    }
+    caddy = PRRTE_NEW(prrte_state_caddy_t);
+    caddy->name = *proc;
+    caddy->proc_state = state;
+    PRRTE_THREADSHIFT(caddy, prrte_event_base, s->cbfunc, s->priority);
 }
 
 int prrte_state_base_add_proc_state(prrte_proc_state_t state,
@@ -323,6 +470,7 @@ int prrte_state_base_add_proc_state(prrte_proc_state_t state,
     st->cbfunc = cbfunc;
     st->priority = priority;
     prrte_list_append(&prrte_proc_states, &(st->super));
+    rebuild_proc_dispatch();
 
     return PRRTE_SUCCESS;
 }
@@ -339,12 +487,27 @@ int prrte_state_base_set_proc_state_callback(prrte_proc_state_t state,
         st = (prrte_state_t*)item;
         if (st->proc_state == state) {
             st->cbfunc = cbfunc;
+            /* we cannot know if the new callback handles batches */
+            st->batch = false;
+            rebuild_proc_dispatch();
             return PRRTE_SUCCESS;
         }
     }
     return PRRTE_ERR_NOT_FOUND;
 }
 
+int prrte_state_base_set_proc_state_batch(prrte_proc_state_t state,
+                                         bool batch)
+{
+    prrte_state_t *st;
+
+    if (NULL == (st = find_proc_state(state))) {
+        return PRRTE_ERR_NOT_FOUND;
+    }
+    st->batch = batch;
+    return PRRTE_SUCCESS;
+}
+
 int prrte_state_base_set_proc_state_priority(prrte_proc_state_t state,
                                             int priority)
 {
@@ -375,6 +538,7 @@ int prrte_state_base_remove_proc_state(prrte_proc_state_t state)
         if (st->proc_state == state) {
             prrte_list_remove_item(&prrte_proc_states, item);
             PRRTE_RELEASE(item);
+            rebuild_proc_dispatch();
             return PRRTE_SUCCESS;
         }
     }
@@ -628,21 +792,15 @@ static void opcbfunc(pmix_status_t status, void *cbdata)
     PRRTE_PMIX_WAKEUP_THREAD(lock);
 }
 
-void prrte_state_base_track_procs(int fd, short argc, void *cbdata)
+static void track_proc(prrte_process_name_t *proc,
+                       prrte_proc_state_t state)
 {
-    prrte_state_caddy_t *caddy = (prrte_state_caddy_t*)cbdata;
-    prrte_process_name_t *proc;
-    prrte_proc_state_t state;
     prrte_job_t *jdata;
     prrte_proc_t *pdata;
     int i, rc;
     prrte_process_name_t parent, target;
     prrte_pmix_lock_t lock;
 
-    PRRTE_ACQUIRE_OBJECT(caddy);
-    proc = &caddy->name;
-    state = caddy->proc_state;
-
     prrte_output_verbose(5, prrte_state_base_framework.framework_output,
                         "%s state:base:track_procs called for proc %s state %s",
                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
@@ -651,11 +809,11 @@ void prrte_state_base_track_procs(int fd, short argc, void *cbdata)
 
     /* get the job object for this proc */
     if (NULL == (jdata = prrte_get_job_data_object(proc->jobid))) {
-        goto cleanup;
+        return;
     }
     pdata = (prrte_proc_t*)prrte_pointer_array_get_item(jdata->procs, proc->vpid);
     if (NULL == pdata) {
-        goto cleanup;
+        return;
     }
 
     if (PRRTE_PROC_STATE_RUNNING == state) {
@@ -705,7 +863,7 @@ void prrte_state_base_track_procs(int fd, short argc, void *cbdata)
                                  PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
                                  PRRTE_NAME_PRINT(proc),
                                  prrte_proc_state_to_str(state));
-            goto cleanup;
+            return;
         }
 
         /* update the proc state */
@@ -744,7 +902,7 @@ void prrte_state_base_track_procs(int fd, short argc, void *cbdata)
                 if (NULL != (pdata = (prrte_proc_t*)prrte_pointer_array_get_item(prrte_local_children, i)) &&
                     PRRTE_FLAG_TEST(pdata, PRRTE_PROC_FLAG_ALIVE)) {
                     /* at least one is still alive */
-                    goto cleanup;
+                    return;
                 }
             }
             /* call our appropriate exit procedure */
@@ -752,7 +910,7 @@ void prrte_state_base_track_procs(int fd, short argc, void *cbdata)
                                  "%s state:base all routes and children gone - exiting",
                                  PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME)));
             PRRTE_ACTIVATE_JOB_STATE(NULL, PRRTE_JOB_STATE_DAEMONS_TERMINATED);
-            goto cleanup;
+            return;
         }
         /* track job status */
         jdata->num_terminated++;
@@ -777,8 +935,22 @@ void prrte_state_base_track_procs(int fd, short argc, void *cbdata)
             _send_notification(PRRTE_ERR_PROC_ABORTED, pdata->state, &pdata->name, &parent);
         }
     }
+}
+
+void prrte_state_base_track_procs(int fd, short argc, void *cbdata)
+{
+    prrte_state_caddy_t *caddy = (prrte_state_caddy_t*)cbdata;
+    int n;
+
+    PRRTE_ACQUIRE_OBJECT(caddy);
 
- cleanup:
+    if (0 == caddy->nprocs) {
+        track_proc(&caddy->name, caddy->proc_state);
+    } else {
+        for (n=0; n < caddy->nprocs; n++) {
+            track_proc(&caddy->procs[n].name, caddy->procs[n].state);
+        }
+    }
     PRRTE_RELEASE(caddy);
 }
 
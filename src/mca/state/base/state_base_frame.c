@@ -45,6 +45,7 @@ prrte_state_base_module_t prrte_state = {0};
 bool prrte_state_base_run_fdcheck = false;
 int prrte_state_base_parent_fd = -1;
 bool prrte_state_base_ready_msg = true;
+bool prrte_state_base_batch_procs = true;
 
 static int prrte_state_base_register(prrte_mca_base_register_flag_t flags)
 {
@@ -56,6 +57,14 @@ static int prrte_state_base_register(prrte_mca_base_register_flag_t flags)
                                 PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
                                 &prrte_state_base_run_fdcheck);
 
+    prrte_state_base_batch_procs = true;
+    prrte_mca_base_var_register("prrte", "state", "base", "batch_procs",
+                                "Collect proc state updates that occur within a single pass of the event loop into one event for handlers that support it",
+                                PRRTE_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                PRRTE_INFO_LVL_9,
+                                PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                &prrte_state_base_batch_procs);
+
     return PRRTE_SUCCESS;
 }
 
@@ -91,6 +100,7 @@ static void prrte_state_construct(prrte_state_t *state)
     state->proc_state = PRRTE_PROC_STATE_UNDEF;
     state->cbfunc = NULL;
     state->priority = PRRTE_INFO_PRI;
+    state->batch = false;
 }
 PRRTE_CLASS_INSTANCE(prrte_state_t,
                    prrte_list_item_t,
@@ -101,6 +111,9 @@ static void prrte_state_caddy_construct(prrte_state_caddy_t *caddy)
 {
     memset(&caddy->ev, 0, sizeof(prrte_event_t));
     caddy->jdata = NULL;
+    caddy->procs = NULL;
+    caddy->nprocs = 0;
+    caddy->nalloc = 0;
 }
 static void prrte_state_caddy_destruct(prrte_state_caddy_t *caddy)
 {
@@ -108,6 +121,9 @@ static void prrte_state_caddy_destruct(prrte_state_caddy_t *caddy)
     if (NULL != caddy->jdata) {
         PRRTE_RELEASE(caddy->jdata);
     }
+    if (NULL != caddy->procs) {
+        free(caddy->procs);
+    }
 }
 PRRTE_CLASS_INSTANCE(prrte_state_caddy_t,
                    prrte_object_t,
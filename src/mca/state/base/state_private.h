@@ -35,6 +35,7 @@
 BEGIN_C_DECLS
 
 PRRTE_EXPORT extern bool prrte_state_base_run_fdcheck;
+PRRTE_EXPORT extern bool prrte_state_base_batch_procs;
 /*
  * Base functions
  */
@@ -71,6 +72,15 @@ PRRTE_EXPORT int prrte_state_base_set_proc_state_priority(prrte_proc_state_t sta
 
 PRRTE_EXPORT int prrte_state_base_remove_proc_state(prrte_proc_state_t state);
 
+/* mark the callback for a proc state as able to process a batch
+ * of proc state updates in a single caddy */
+PRRTE_EXPORT int prrte_state_base_set_proc_state_batch(prrte_proc_state_t state,
+                                                       bool batch);
+
+/* drop the dispatch tables - must be called whenever the job or
+ * proc state lists are emptied outside of the base functions */
+PRRTE_EXPORT void prrte_state_base_clear_dispatch(void);
+
 PRRTE_EXPORT void prrte_util_print_proc_state_machine(void);
 
 /* common state processing functions */
@@ -198,6 +198,9 @@ static int init(void)
                                                             proc_callbacks[i],
                                                             PRRTE_SYS_PRI))) {
             PRRTE_ERROR_LOG(rc);
+        } else {
+            /* track_procs can process many procs in one pass */
+            prrte_state_base_set_proc_state_batch(proc_states[i], true);
         }
     }
     if (5 < prrte_output_get_verbosity(prrte_state_base_framework.framework_output)) {
@@ -216,6 +219,7 @@ static int finalize(void)
         PRRTE_RELEASE(item);
     }
     PRRTE_DESTRUCT(&prrte_proc_states);
+    prrte_state_base_clear_dispatch();
 
     return PRRTE_SUCCESS;
 }
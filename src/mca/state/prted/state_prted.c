@@ -133,6 +133,9 @@ static int init(void)
                                                             proc_callbacks[i],
                                                             PRRTE_SYS_PRI))) {
             PRRTE_ERROR_LOG(rc);
+        } else {
+            /* track_procs can process many procs in one pass */
+            prrte_state_base_set_proc_state_batch(proc_states[i], true);
         }
     }
     if (5 < prrte_output_get_verbosity(prrte_state_base_framework.framework_output)) {
@@ -154,6 +157,7 @@ static int finalize(void)
         PRRTE_RELEASE(item);
     }
     PRRTE_DESTRUCT(&prrte_proc_states);
+    prrte_state_base_clear_dispatch();
 
     return PRRTE_SUCCESS;
 }
@@ -265,11 +269,9 @@ static void opcbfunc(pmix_status_t status, void *cbdata)
     lk->status = prrte_pmix_convert_status(status);
     PRRTE_PMIX_WAKEUP_THREAD(lk);
 }
-static void track_procs(int fd, short argc, void *cbdata)
+static void track_proc(prrte_process_name_t *proc,
+                       prrte_proc_state_t state)
 {
-    prrte_state_caddy_t *caddy = (prrte_state_caddy_t*)cbdata;
-    prrte_process_name_t *proc;
-    prrte_proc_state_t state;
     prrte_job_t *jdata;
     prrte_proc_t *pdata, *pptr;
     prrte_buffer_t *alert;
@@ -281,10 +283,6 @@ static void track_procs(int fd, short argc, void *cbdata)
     prrte_process_name_t target;
     prrte_pmix_lock_t lock;
 
-    PRRTE_ACQUIRE_OBJECT(caddy);
-    proc = &caddy->name;
-    state = caddy->proc_state;
-
     PRRTE_OUTPUT_VERBOSE((5, prrte_state_base_framework.framework_output,
                          "%s state:prted:track_procs called for proc %s state %s",
                          PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
@@ -294,12 +292,12 @@ static void track_procs(int fd, short argc, void *cbdata)
     /* get the job object for this proc */
     if (NULL == (jdata = prrte_get_job_data_object(proc->jobid))) {
         PRRTE_ERROR_LOG(PRRTE_ERR_NOT_FOUND);
-        goto cleanup;
+        return;
     }
     pdata = (prrte_proc_t*)prrte_pointer_array_get_item(jdata->procs, proc->vpid);
     if (NULL == pdata) {
         PRRTE_ERROR_LOG(PRRTE_ERR_NOT_FOUND);
-        goto cleanup;
+        return;
     }
 
     if (PRRTE_PROC_STATE_RUNNING == state) {
@@ -330,12 +328,12 @@ static void track_procs(int fd, short argc, void *cbdata)
             cmd = PRRTE_PLM_REGISTERED_CMD;
             if (PRRTE_SUCCESS != (rc = prrte_dss.pack(alert, &cmd, 1, PRRTE_PLM_CMD))) {
                 PRRTE_ERROR_LOG(rc);
-                goto cleanup;
+                return;
             }
             /* pack the jobid */
             if (PRRTE_SUCCESS != (rc = prrte_dss.pack(alert, &proc->jobid, 1, PRRTE_JOBID))) {
                 PRRTE_ERROR_LOG(rc);
-                goto cleanup;
+                return;
             }
             /* pack all the local child vpids */
             for (i=0; i < prrte_local_children->size; i++) {
@@ -345,7 +343,7 @@ static void track_procs(int fd, short argc, void *cbdata)
                 if (pptr->name.jobid == proc->jobid) {
                     if (PRRTE_SUCCESS != (rc = prrte_dss.pack(alert, &pptr->name.vpid, 1, PRRTE_VPID))) {
                         PRRTE_ERROR_LOG(rc);
-                        goto cleanup;
+                        return;
                     }
                 }
             }
@@ -417,7 +415,7 @@ static void track_procs(int fd, short argc, void *cbdata)
                                          "%s state:prted all routes gone but proc %s still alive",
                                          PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
                                          PRRTE_NAME_PRINT(&pdata->name)));
-                    goto cleanup;
+                    return;
                 }
             }
             /* call our appropriate exit procedure */
@@ -425,7 +423,7 @@ static void track_procs(int fd, short argc, void *cbdata)
                                  "%s state:prted all routes and children gone - exiting",
                                  PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME)));
             PRRTE_ACTIVATE_JOB_STATE(NULL, PRRTE_JOB_STATE_DAEMONS_TERMINATED);
-            goto cleanup;
+            return;
         }
         /* track job status */
         if (jdata->num_terminated == jdata->num_local_procs &&
@@ -435,7 +433,7 @@ static void track_procs(int fd, short argc, void *cbdata)
             alert = PRRTE_NEW(prrte_buffer_t);
             if (PRRTE_SUCCESS != (rc = prrte_dss.pack(alert, &cmd, 1, PRRTE_PLM_CMD))) {
                 PRRTE_ERROR_LOG(rc);
-                goto cleanup;
+                return;
             }
             /* pack the job info */
             if (PRRTE_SUCCESS != (rc = pack_state_update(alert, jdata))) {
@@ -537,8 +535,22 @@ static void track_procs(int fd, short argc, void *cbdata)
             PRRTE_RELEASE(jdata);
         }
     }
+}
 
-  cleanup:
+static void track_procs(int fd, short argc, void *cbdata)
+{
+    prrte_state_caddy_t *caddy = (prrte_state_caddy_t*)cbdata;
+    int n;
+
+    PRRTE_ACQUIRE_OBJECT(caddy);
+
+    if (0 == caddy->nprocs) {
+        track_proc(&caddy->name, caddy->proc_state);
+    } else {
+        for (n=0; n < caddy->nprocs; n++) {
+            track_proc(&caddy->procs[n].name, caddy->procs[n].state);
+        }
+    }
     PRRTE_RELEASE(caddy);
 }
 
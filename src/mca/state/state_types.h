@@ -60,10 +60,21 @@ typedef struct {
     prrte_proc_state_t proc_state;
     prrte_state_cbfunc_t cbfunc;
     int priority;
+    /* the cbfunc can process a batch of proc updates */
+    bool batch;
 } prrte_state_t;
 PRRTE_EXPORT PRRTE_CLASS_DECLARATION(prrte_state_t);
 
-/* caddy for passing job and proc data to state event handlers */
+/* a single proc state update within a batch */
+typedef struct {
+    prrte_process_name_t name;
+    prrte_proc_state_t state;
+} prrte_state_proc_update_t;
+
+/* caddy for passing job and proc data to state event handlers. If
+ * nprocs is non-zero, then the caddy carries a batch of proc state
+ * updates in the procs array and the name/proc_state fields are
+ * to be ignored */
 typedef struct {
     prrte_object_t super;
     prrte_event_t ev;
@@ -71,6 +82,9 @@ typedef struct {
     prrte_job_state_t job_state;
     prrte_process_name_t name;
     prrte_proc_state_t proc_state;
+    prrte_state_proc_update_t *procs;
+    int nprocs;
+    int nalloc;
 } prrte_state_caddy_t;
 PRRTE_EXPORT PRRTE_CLASS_DECLARATION(prrte_state_caddy_t);
 
@@ -453,6 +453,17 @@ typedef struct {
 
 #define PRRTE_PMIX_SHOW_HELP    "prrte.show.help"
 
+/* resource telemetry query and the values returned for each proc */
+#define PRRTE_PMIX_QUERY_TELEMETRY          "prrte.qry.telem"
+#define PRRTE_PMIX_TELEMETRY_PROC           "prrte.telem.proc"
+#define PRRTE_PMIX_TELEMETRY_TIME           "prrte.telem.time"      // (struct timeval) time of the sample
+#define PRRTE_PMIX_TELEMETRY_CPU            "prrte.telem.cpu"       // (double) cpu time in secs
+#define PRRTE_PMIX_TELEMETRY_RSS            "prrte.telem.rss"       // (float) resident set size in MBytes
+#define PRRTE_PMIX_TELEMETRY_PSS            "prrte.telem.pss"       // (float) proportional set size in MBytes
+#define PRRTE_PMIX_TELEMETRY_VSIZE          "prrte.telem.vsize"     // (float) virtual size in MBytes
+#define PRRTE_PMIX_TELEMETRY_THREADS        "prrte.telem.nthreads"  // (int16_t) number of threads
+#define PRRTE_PMIX_TELEMETRY_PROCESSOR      "prrte.telem.cpuid"     // (int16_t) processor last run on
+
 /* some helper functions */
 PRRTE_EXPORT pmix_proc_state_t prrte_pmix_convert_state(int state);
 PRRTE_EXPORT int prrte_pmix_convert_pstate(pmix_proc_state_t);
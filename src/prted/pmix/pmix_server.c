@@ -211,6 +211,16 @@ void pmix_server_register_params(void)
                                   PRRTE_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
                                   PRRTE_INFO_LVL_9, PRRTE_MCA_BASE_VAR_SCOPE_ALL,
                                   &prrte_pmix_server_globals.system_server);
+
+    /* how often to report the resource usage of our procs */
+    prrte_pmix_server_globals.telemetry_interval = 0;
+    (void) prrte_mca_base_var_register ("prrte", "pmix", NULL, "telemetry_interval",
+                                  "Time (in seconds) between samples of the resource usage of each daemon's "
+                                  "local procs, which are sent to the HNP and can be retrieved with a "
+                                  "PMIx query [default: 0 => disabled]",
+                                  PRRTE_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                  PRRTE_INFO_LVL_9, PRRTE_MCA_BASE_VAR_SCOPE_ALL,
+                                  &prrte_pmix_server_globals.telemetry_interval);
 }
 
 static void eviction_cbfunc(struct prrte_hotel_t *hotel,
@@ -569,6 +579,9 @@ void pmix_server_start(void)
         prrte_rml.recv_buffer_nb(PRRTE_NAME_WILDCARD, PRRTE_RML_TAG_LOGGING,
                                 PRRTE_RML_PERSISTENT, pmix_server_log, NULL);
     }
+
+    /* start the resource telemetry, if requested */
+    pmix_server_telemetry_start();
 }
 
 void pmix_server_finalize(void)
@@ -590,6 +603,7 @@ void pmix_server_finalize(void)
     if (PRRTE_PROC_IS_MASTER || PRRTE_PROC_IS_MASTER) {
         prrte_rml.recv_cancel(PRRTE_NAME_WILDCARD, PRRTE_RML_TAG_LOGGING);
     }
+    pmix_server_telemetry_stop();
 
     /* finalize our local data server */
     prrte_data_server_finalize();
@@ -344,6 +344,11 @@ PRRTE_EXPORT extern void pmix_server_notify(int status, prrte_process_name_t* se
                                             prrte_buffer_t *buffer,
                                             prrte_rml_tag_t tg, void *cbdata);
 
+/* resource telemetry */
+PRRTE_EXPORT extern void pmix_server_telemetry_start(void);
+PRRTE_EXPORT extern void pmix_server_telemetry_stop(void);
+PRRTE_EXPORT extern pmix_status_t pmix_server_telemetry_query(pmix_query_t *q, pmix_info_t *result);
+
 /* exposed shared variables */
 typedef struct {
   prrte_list_item_t super;
@@ -368,6 +373,7 @@ typedef struct {
     bool system_server;
     bool legacy;
     prrte_list_t psets;
+    int telemetry_interval;
 } pmix_server_globals_t;
 
 extern pmix_server_globals_t prrte_pmix_server_globals;
@@ -301,6 +301,13 @@ static void _query(int sd, short args, void *cbdata)
                     }
                 }
 #endif
+            } else if (0 == strcmp(q->keys[n], PRRTE_PMIX_QUERY_TELEMETRY)) {
+                kv = PRRTE_NEW(prrte_info_item_t);
+                if (PMIX_SUCCESS == pmix_server_telemetry_query(q, &kv->info)) {
+                    prrte_list_append(&results, &kv->super);
+                } else {
+                    PRRTE_RELEASE(kv);
+                }
             } else if (0 == strcmp(q->keys[n], PMIX_TIME_REMAINING)) {
                 if (PRRTE_SUCCESS == prrte_schizo.get_remaining_time(&key)) {
                     kv = PRRTE_NEW(prrte_info_item_t);
@@ -0,0 +1,548 @@
+/*
+ * Copyright (c) 2020      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Resource telemetry: when enabled, each daemon periodically samples
+ * its local procs and sends the values that changed since its last
+ * sample to its parent in the routing tree. Each daemon holds what it
+ * receives from its children until its own next sample, so the reports
+ * are aggregated at every level of the tree on their way to the HNP.
+ * The HNP keeps the latest values for each proc and returns them in
+ * response to a PRRTE_PMIX_QUERY_TELEMETRY query.
+ *
+ * Each report consists of one or more blocks, one per daemon:
+ *
+ *    daemon vpid, sample time, number of records, records
+ *
+ * where each record is the proc name, a mask of the fields that
+ * follow, and the fields themselves. The cpu time is sent as the
+ * increase since the prior record for that proc.
+ */
+
+#include "prrte_config.h"
+#include <unistd.h>
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif
+
+#include "src/class/prrte_hash_table.h"
+#include "src/util/output.h"
+#include "src/dss/dss.h"
+#include "src/mca/pstat/pstat.h"
+#include "src/mca/errmgr/errmgr.h"
+#include "src/util/name_fns.h"
+#include "src/threads/threads.h"
+#include "src/runtime/prrte_globals.h"
+#include "src/mca/rml/rml.h"
+
+#include "src/prted/pmix/pmix_server_internal.h"
+
+/* the fields carried in a record */
+#define PRRTE_TELEM_CPU         0x01
+#define PRRTE_TELEM_RSS         0x02
+#define PRRTE_TELEM_PSS         0x04
+#define PRRTE_TELEM_VSIZE       0x08
+#define PRRTE_TELEM_THREADS     0x10
+#define PRRTE_TELEM_PROCESSOR   0x20
+#define PRRTE_TELEM_ALL         0x3f
+/* the proc has terminated - forget it */
+#define PRRTE_TELEM_GONE        0x80
+
+typedef struct {
+    prrte_object_t super;
+    prrte_process_name_t name;
+    /* daemon that reported it and when - only used by the HNP */
+    prrte_vpid_t daemon;
+    struct timeval sample_time;
+    /* last values */
+    uint64_t cpu;   /* usecs */
+    float rss;
+    float pss;
+    float vsize;
+    int16_t nthreads;
+    int16_t processor;
+    /* sample in which we last saw this proc - only used by daemons */
+    uint32_t tick;
+} telem_record_t;
+static PRRTE_CLASS_INSTANCE(telem_record_t,
+                            prrte_object_t,
+                            NULL, NULL);
+
+static bool active = false;
+static prrte_event_t timer;
+static uint32_t tick = 0;
+/* the procs we are sampling */
+static prrte_hash_table_t local;
+/* the latest values of every proc - HNP only */
+static prrte_hash_table_t global;
+/* blocks received from our children since our last sample */
+static prrte_buffer_t pending;
+static int npending = 0;
+
+static void telemetry_recv(int status, prrte_process_name_t* sender,
+                           prrte_buffer_t *buffer,
+                           prrte_rml_tag_t tg, void *cbdata);
+
+static uint64_t telem_key(prrte_process_name_t *name)
+{
+    return ((uint64_t)name->jobid << 32) | (uint64_t)name->vpid;
+}
+
+static void release_records(prrte_hash_table_t *table)
+{
+    telem_record_t *rec;
+    uint64_t key;
+    void *node;
+
+    if (PRRTE_SUCCESS == prrte_hash_table_get_first_key_uint64(table, &key,
+                                                               (void**)&rec, &node)) {
+        do {
+            PRRTE_RELEASE(rec);
+        } while (PRRTE_SUCCESS == prrte_hash_table_get_next_key_uint64(table, &key,
+                                                                       (void**)&rec,
+                                                                       node, &node));
+    }
+}
+
+/* apply the blocks in a report to our table of procs */
+static void ingest(prrte_buffer_t *buffer)
+{
+    prrte_vpid_t daemon;
+    struct timeval tv;
+    int32_t n, nrecs, cnt;
+    prrte_process_name_t name;
+    uint8_t mask;
+    uint64_t delta;
+    telem_record_t *rec;
+    int rc;
+
+    cnt = 1;
+    while (PRRTE_SUCCESS == (rc = prrte_dss.unpack(buffer, &daemon, &cnt, PRRTE_VPID))) {
+        cnt = 1;
+        if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &tv, &cnt, PRRTE_TIMEVAL))) {
+            PRRTE_ERROR_LOG(rc);
+            return;
+        }
+        cnt = 1;
+        if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &nrecs, &cnt, PRRTE_INT32))) {
+            PRRTE_ERROR_LOG(rc);
+            return;
+        }
+        for (n=0; n < nrecs; n++) {
+            cnt = 1;
+            if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &name, &cnt, PRRTE_NAME))) {
+                PRRTE_ERROR_LOG(rc);
+                return;
+            }
+            cnt = 1;
+            if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &mask, &cnt, PRRTE_UINT8))) {
+                PRRTE_ERROR_LOG(rc);
+                return;
+            }
+            if (PRRTE_SUCCESS != prrte_hash_table_get_value_uint64(&global, telem_key(&name),
+                                                                   (void**)&rec)) {
+                rec = NULL;
+            }
+            if (PRRTE_TELEM_GONE & mask) {
+                if (NULL != rec) {
+                    prrte_hash_table_remove_value_uint64(&global, telem_key(&name));
+                    PRRTE_RELEASE(rec);
+                }
+                continue;
+            }
+            if (NULL == rec) {
+                rec = PRRTE_NEW(telem_record_t);
+                rec->name = name;
+                prrte_hash_table_set_value_uint64(&global, telem_key(&name), rec);
+            }
+            rec->daemon = daemon;
+            rec->sample_time = tv;
+            cnt = 1;
+            if (PRRTE_TELEM_CPU & mask) {
+                if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &delta, &cnt, PRRTE_UINT64))) {
+                    PRRTE_ERROR_LOG(rc);
+                    return;
+                }
+                rec->cpu += delta;
+            }
+            if (PRRTE_TELEM_RSS & mask) {
+                if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &rec->rss, &cnt, PRRTE_FLOAT))) {
+                    PRRTE_ERROR_LOG(rc);
+                    return;
+                }
+            }
+            if (PRRTE_TELEM_PSS & mask) {
+                if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &rec->pss, &cnt, PRRTE_FLOAT))) {
+                    PRRTE_ERROR_LOG(rc);
+                    return;
+                }
+            }
+            if (PRRTE_TELEM_VSIZE & mask) {
+                if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &rec->vsize, &cnt, PRRTE_FLOAT))) {
+                    PRRTE_ERROR_LOG(rc);
+                    return;
+                }
+            }
+            if (PRRTE_TELEM_THREADS & mask) {
+                if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &rec->nthreads, &cnt, PRRTE_INT16))) {
+                    PRRTE_ERROR_LOG(rc);
+                    return;
+                }
+            }
+            if (PRRTE_TELEM_PROCESSOR & mask) {
+                if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buffer, &rec->processor, &cnt, PRRTE_INT16))) {
+                    PRRTE_ERROR_LOG(rc);
+                    return;
+                }
+            }
+        }
+        cnt = 1;
+    }
+    if (PRRTE_ERR_UNPACK_READ_PAST_END_OF_BUFFER != rc) {
+        PRRTE_ERROR_LOG(rc);
+    }
+}
+
+/* pass everything we have collected up the tree */
+static void forward(void)
+{
+    prrte_buffer_t *buf;
+    int rc;
+
+    if (0 == npending) {
+        return;
+    }
+    if (PRRTE_PROC_IS_MASTER) {
+        ingest(&pending);
+    } else {
+        buf = PRRTE_NEW(prrte_buffer_t);
+        prrte_dss.copy_payload(buf, &pending);
+        if (PRRTE_SUCCESS != (rc = prrte_rml.send_buffer_nb(PRRTE_PROC_MY_PARENT, buf,
+                                                            PRRTE_RML_TAG_TELEMETRY,
+                                                            prrte_rml_send_callback, NULL))) {
+            PRRTE_ERROR_LOG(rc);
+            PRRTE_RELEASE(buf);
+        }
+    }
+    PRRTE_DESTRUCT(&pending);
+    PRRTE_CONSTRUCT(&pending, prrte_buffer_t);
+    npending = 0;
+}
+
+static int pack_record(prrte_buffer_t *buf, telem_record_t *rec, uint8_t mask,
+                       uint64_t delta)
+{
+    int rc;
+
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buf, &rec->name, 1, PRRTE_NAME))) {
+        return rc;
+    }
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buf, &mask, 1, PRRTE_UINT8))) {
+        return rc;
+    }
+    if ((PRRTE_TELEM_CPU & mask) &&
+        PRRTE_SUCCESS != (rc = prrte_dss.pack(buf, &delta, 1, PRRTE_UINT64))) {
+        return rc;
+    }
+    if ((PRRTE_TELEM_RSS & mask) &&
+        PRRTE_SUCCESS != (rc = prrte_dss.pack(buf, &rec->rss, 1, PRRTE_FLOAT))) {
+        return rc;
+    }
+    if ((PRRTE_TELEM_PSS & mask) &&
+        PRRTE_SUCCESS != (rc = prrte_dss.pack(buf, &rec->pss, 1, PRRTE_FLOAT))) {
+        return rc;
+    }
+    if ((PRRTE_TELEM_VSIZE & mask) &&
+        PRRTE_SUCCESS != (rc = prrte_dss.pack(buf, &rec->vsize, 1, PRRTE_FLOAT))) {
+        return rc;
+    }
+    if ((PRRTE_TELEM_THREADS & mask) &&
+        PRRTE_SUCCESS != (rc = prrte_dss.pack(buf, &rec->nthreads, 1, PRRTE_INT16))) {
+        return rc;
+    }
+    if ((PRRTE_TELEM_PROCESSOR & mask) &&
+        PRRTE_SUCCESS != (rc = prrte_dss.pack(buf, &rec->processor, 1, PRRTE_INT16))) {
+        return rc;
+    }
+    return PRRTE_SUCCESS;
+}
+
+static void sample(int fd, short args, void *cbdata)
+{
+    prrte_proc_t *child;
+    prrte_pstats_t stats;
+    telem_record_t *rec;
+    prrte_buffer_t recs;
+    struct timeval now, tv;
+    prrte_process_name_t *gone = NULL;
+    int i, nrecs = 0, ngone = 0, rc;
+    uint64_t cpu, delta, key;
+    uint8_t mask;
+    void *node;
+
+    ++tick;
+    gettimeofday(&now, NULL);
+    PRRTE_CONSTRUCT(&recs, prrte_buffer_t);
+
+    for (i=0; i < prrte_local_children->size; i++) {
+        if (NULL == (child = (prrte_proc_t*)prrte_pointer_array_get_item(prrte_local_children, i)) ||
+            !PRRTE_FLAG_TEST(child, PRRTE_PROC_FLAG_ALIVE) || 0 >= child->pid) {
+            continue;
+        }
+        PRRTE_CONSTRUCT(&stats, prrte_pstats_t);
+        if (PRRTE_SUCCESS != prrte_pstat.query(child->pid, &stats, NULL)) {
+            PRRTE_DESTRUCT(&stats);
+            continue;
+        }
+        cpu = (uint64_t)stats.time.tv_sec * 1000000 + stats.time.tv_usec;
+        if (PRRTE_SUCCESS != prrte_hash_table_get_value_uint64(&local, telem_key(&child->name),
+                                                               (void**)&rec)) {
+            /* first time we've seen it - send everything */
+            rec = PRRTE_NEW(telem_record_t);
+            rec->name = child->name;
+            prrte_hash_table_set_value_uint64(&local, telem_key(&child->name), rec);
+            mask = PRRTE_TELEM_ALL;
+        } else {
+            mask = 0;
+            if (cpu != rec->cpu) {
+                mask |= PRRTE_TELEM_CPU;
+            }
+            if (stats.rss != rec->rss) {
+                mask |= PRRTE_TELEM_RSS;
+            }
+            if (stats.pss != rec->pss) {
+                mask |= PRRTE_TELEM_PSS;
+            }
+            if (stats.vsize != rec->vsize) {
+                mask |= PRRTE_TELEM_VSIZE;
+            }
+            if (stats.num_threads != rec->nthreads) {
+                mask |= PRRTE_TELEM_THREADS;
+            }
+            if (stats.processor != rec->processor) {
+                mask |= PRRTE_TELEM_PROCESSOR;
+            }
+        }
+        rec->tick = tick;
+        delta = (cpu > rec->cpu) ? cpu - rec->cpu : 0;
+        rec->cpu = cpu;
+        rec->rss = stats.rss;
+        rec->pss = stats.pss;
+        rec->vsize = stats.vsize;
+        rec->nthreads = stats.num_threads;
+        rec->processor = stats.processor;
+        PRRTE_DESTRUCT(&stats);
+        /* nothing changed, nothing to say */
+        if (0 == mask) {
+            continue;
+        }
+        if (PRRTE_SUCCESS != (rc = pack_record(&recs, rec, mask, delta))) {
+            PRRTE_ERROR_LOG(rc);
+            goto done;
+        }
+        ++nrecs;
+    }
+
+    /* let them know about any procs that have gone away */
+    if (PRRTE_SUCCESS == prrte_hash_table_get_first_key_uint64(&local, &key,
+                                                               (void**)&rec, &node)) {
+        do {
+            if (rec->tick != tick) {
+                gone = (prrte_process_name_t*)realloc(gone, (ngone + 1) * sizeof(prrte_process_name_t));
+                gone[ngone++] = rec->name;
+            }
+        } while (PRRTE_SUCCESS == prrte_hash_table_get_next_key_uint64(&local, &key,
+                                                                       (void**)&rec,
+                                                                       node, &node));
+    }
+    for (i=0; i < ngone; i++) {
+        if (PRRTE_SUCCESS == prrte_hash_table_get_value_uint64(&local, telem_key(&gone[i]),
+                                                               (void**)&rec)) {
+            prrte_hash_table_remove_value_uint64(&local, telem_key(&gone[i]));
+            if (PRRTE_SUCCESS != (rc = pack_record(&recs, rec, PRRTE_TELEM_GONE, 0))) {
+                PRRTE_ERROR_LOG(rc);
+                PRRTE_RELEASE(rec);
+                goto done;
+            }
+            PRRTE_RELEASE(rec);
+            ++nrecs;
+        }
+    }
+
+    if (0 < nrecs) {
+        prrte_dss.pack(&pending, &PRRTE_PROC_MY_NAME->vpid, 1, PRRTE_VPID);
+        prrte_dss.pack(&pending, &now, 1, PRRTE_TIMEVAL);
+        prrte_dss.pack(&pending, &nrecs, 1, PRRTE_INT32);
+        prrte_dss.copy_payload(&pending, &recs);
+        ++npending;
+    }
+    forward();
+
+  done:
+    if (NULL != gone) {
+        free(gone);
+    }
+    PRRTE_DESTRUCT(&recs);
+    /* reset the timer */
+    tv.tv_sec = prrte_pmix_server_globals.telemetry_interval;
+    tv.tv_usec = 0;
+    prrte_event_evtimer_add(&timer, &tv);
+}
+
+static void telemetry_recv(int status, prrte_process_name_t* sender,
+                           prrte_buffer_t *buffer,
+                           prrte_rml_tag_t tg, void *cbdata)
+{
+    /* hold it until our next sample so we send
+     * a single report up the tree */
+    prrte_dss.copy_payload(&pending, buffer);
+    ++npending;
+    if (!active) {
+        /* we aren't sampling, so pass it along now */
+        forward();
+    }
+}
+
+void pmix_server_telemetry_start(void)
+{
+    struct timeval tv;
+
+    PRRTE_CONSTRUCT(&pending, prrte_buffer_t);
+    npending = 0;
+    PRRTE_CONSTRUCT(&local, prrte_hash_table_t);
+    prrte_hash_table_init(&local, 256);
+    if (PRRTE_PROC_IS_MASTER) {
+        PRRTE_CONSTRUCT(&global, prrte_hash_table_t);
+        prrte_hash_table_init(&global, 1024);
+    }
+
+    /* always listen so reports pass thru us even if
+     * we weren't asked to sample */
+    prrte_rml.recv_buffer_nb(PRRTE_NAME_WILDCARD, PRRTE_RML_TAG_TELEMETRY,
+                             PRRTE_RML_PERSISTENT, telemetry_recv, NULL);
+
+    if (0 < prrte_pmix_server_globals.telemetry_interval) {
+        prrte_event_evtimer_set(prrte_event_base, &timer, sample, NULL);
+        tv.tv_sec = prrte_pmix_server_globals.telemetry_interval;
+        tv.tv_usec = 0;
+        prrte_event_evtimer_add(&timer, &tv);
+        active = true;
+    }
+}
+
+void pmix_server_telemetry_stop(void)
+{
+    prrte_rml.recv_cancel(PRRTE_NAME_WILDCARD, PRRTE_RML_TAG_TELEMETRY);
+    if (active) {
+        prrte_event_evtimer_del(&timer);
+        active = false;
+    }
+    release_records(&local);
+    PRRTE_DESTRUCT(&local);
+    if (PRRTE_PROC_IS_MASTER) {
+        release_records(&global);
+        PRRTE_DESTRUCT(&global);
+    }
+    PRRTE_DESTRUCT(&pending);
+    npending = 0;
+}
+
+/* construct the response to a telemetry query - an array
+ * with one entry per proc, each of which is an array of
+ * the values we have for it */
+pmix_status_t pmix_server_telemetry_query(pmix_query_t *q, pmix_info_t *result)
+{
+    telem_record_t *rec;
+    prrte_process_name_t dname;
+    prrte_proc_t *daemon;
+    prrte_jobid_t jobid = PRRTE_JOBID_WILDCARD;
+    pmix_data_array_t *darray, *parray;
+    pmix_info_t *info, *pinfo;
+    pmix_proc_t pproc;
+    uint64_t key;
+    void *node;
+    size_t n, nprocs;
+    double cpu;
+    int rc;
+
+    if (!PRRTE_PROC_IS_MASTER) {
+        return PMIX_ERR_NOT_SUPPORTED;
+    }
+
+    /* they can restrict it to a single job */
+    for (n=0; n < q->nqual; n++) {
+        if (PMIX_CHECK_KEY(&q->qualifiers[n], PMIX_NSPACE)) {
+            PRRTE_PMIX_CONVERT_NSPACE(rc, &jobid, q->qualifiers[n].value.data.string);
+            if (PRRTE_SUCCESS != rc) {
+                return PMIX_ERR_BAD_PARAM;
+            }
+        }
+    }
+
+    nprocs = 0;
+    if (PRRTE_SUCCESS == prrte_hash_table_get_first_key_uint64(&global, &key,
+                                                               (void**)&rec, &node)) {
+        do {
+            if (PRRTE_JOBID_WILDCARD == jobid || jobid == rec->name.jobid) {
+                ++nprocs;
+            }
+        } while (PRRTE_SUCCESS == prrte_hash_table_get_next_key_uint64(&global, &key,
+                                                                       (void**)&rec,
+                                                                       node, &node));
+    }
+    if (0 == nprocs) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+
+    PMIX_DATA_ARRAY_CREATE(darray, nprocs, PMIX_INFO);
+#if PMIX_NUMERIC_VERSION < 0x00030100
+    PMIX_INFO_CREATE(darray->array, nprocs);
+#endif
+    info = (pmix_info_t*)darray->array;
+    n = 0;
+    dname.jobid = PRRTE_PROC_MY_NAME->jobid;
+    prrte_hash_table_get_first_key_uint64(&global, &key, (void**)&rec, &node);
+    do {
+        if (PRRTE_JOBID_WILDCARD != jobid && jobid != rec->name.jobid) {
+            continue;
+        }
+        PMIX_DATA_ARRAY_CREATE(parray, 9, PMIX_INFO);
+#if PMIX_NUMERIC_VERSION < 0x00030100
+        PMIX_INFO_CREATE(parray->array, 9);
+#endif
+        pinfo = (pmix_info_t*)parray->array;
+        PRRTE_PMIX_CONVERT_NAME(rc, &pproc, &rec->name);
+        PMIX_INFO_LOAD(&pinfo[0], PMIX_PROCID, &pproc, PMIX_PROC);
+        dname.vpid = rec->daemon;
+        if (NULL != (daemon = prrte_get_proc_object(&dname)) &&
+            NULL != daemon->node && NULL != daemon->node->name) {
+            PMIX_INFO_LOAD(&pinfo[1], PMIX_HOSTNAME, daemon->node->name, PMIX_STRING);
+        } else {
+            PMIX_INFO_LOAD(&pinfo[1], PMIX_HOSTNAME, "unknown", PMIX_STRING);
+        }
+        PMIX_INFO_LOAD(&pinfo[2], PRRTE_PMIX_TELEMETRY_TIME, &rec->sample_time, PMIX_TIMEVAL);
+        cpu = (double)rec->cpu / 1000000.0;
+        PMIX_INFO_LOAD(&pinfo[3], PRRTE_PMIX_TELEMETRY_CPU, &cpu, PMIX_DOUBLE);
+        PMIX_INFO_LOAD(&pinfo[4], PRRTE_PMIX_TELEMETRY_RSS, &rec->rss, PMIX_FLOAT);
+        PMIX_INFO_LOAD(&pinfo[5], PRRTE_PMIX_TELEMETRY_PSS, &rec->pss, PMIX_FLOAT);
+        PMIX_INFO_LOAD(&pinfo[6], PRRTE_PMIX_TELEMETRY_VSIZE, &rec->vsize, PMIX_FLOAT);
+        PMIX_INFO_LOAD(&pinfo[7], PRRTE_PMIX_TELEMETRY_THREADS, &rec->nthreads, PMIX_INT16);
+        PMIX_INFO_LOAD(&pinfo[8], PRRTE_PMIX_TELEMETRY_PROCESSOR, &rec->processor, PMIX_INT16);
+        PMIX_LOAD_KEY(info[n].key, PRRTE_PMIX_TELEMETRY_PROC);
+        info[n].value.type = PMIX_DATA_ARRAY;
+        info[n].value.data.darray = parray;
+        ++n;
+    } while (n < nprocs &&
+             PRRTE_SUCCESS == prrte_hash_table_get_next_key_uint64(&global, &key,
+                                                                   (void**)&rec,
+                                                                   node, &node));
+
+    PMIX_LOAD_KEY(result->key, PRRTE_PMIX_QUERY_TELEMETRY);
+    result->value.type = PMIX_DATA_ARRAY;
+    result->value.data.darray = darray;
+    return PMIX_SUCCESS;
+}
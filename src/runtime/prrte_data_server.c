@@ -34,7 +34,7 @@
 
 #include "src/util/argv.h"
 #include "src/util/output.h"
-#include "src/class/prrte_pointer_array.h"
+#include "src/class/prrte_hash_table.h"
 #include "src/dss/dss.h"
 #include "src/pmix/pmix-internal.h"
 
@@ -47,12 +47,13 @@
 
 #include "src/runtime/prrte_data_server.h"
 
+struct prrte_data_ref_t;
+
 /* define an object to hold data */
 typedef struct {
-    /* base object */
-    prrte_object_t super;
-    /* index of this object in the storage array */
-    prrte_std_cntr_t index;
+    /* base object - tracked on the list of data
+     * published from the owner's namespace */
+    prrte_list_item_t super;
     /* process that owns this data - only the
     * owner can remove it
     */
@@ -66,18 +67,23 @@ typedef struct {
     /* and the values themselves */
     pmix_info_t *info;
     size_t ninfo;
-    /* the value itself */
+    /* where each value sits in the key index - NULL once
+     * that value has been removed */
+    struct prrte_data_ref_t **refs;
+    /* number of values still present */
+    size_t nlive;
 } prrte_data_object_t;
 
 static void construct(prrte_data_object_t *ptr)
 {
-    ptr->index = -1;
     PMIX_PROC_CONSTRUCT(&ptr->owner);
     ptr->uid = UINT32_MAX;
     ptr->range = PMIX_RANGE_SESSION;
     ptr->persistence = PMIX_PERSIST_SESSION;
     ptr->info = NULL;
     ptr->ninfo = 0;
+    ptr->refs = NULL;
+    ptr->nlive = 0;
 }
 
 static void destruct(prrte_data_object_t *ptr)
@@ -85,10 +91,13 @@ static void destruct(prrte_data_object_t *ptr)
     if (NULL != ptr->info) {
         PMIX_INFO_FREE(ptr->info, ptr->ninfo);
     }
+    if (NULL != ptr->refs) {
+        free(ptr->refs);
+    }
 }
 
 static PRRTE_CLASS_INSTANCE(prrte_data_object_t,
-                          prrte_object_t,
+                          prrte_list_item_t,
                           construct, destruct);
 
 /* define a request object for delayed answers */
@@ -116,8 +125,60 @@ static PRRTE_CLASS_INSTANCE(prrte_data_req_t,
                           prrte_list_item_t,
                           rqcon, rqdes);
 
+/* everything known about a given key - the values published
+ * under it and the lookups waiting for it to appear */
+typedef struct {
+    prrte_object_t super;
+    char key[PMIX_MAX_KEYLEN+1];
+    prrte_list_t values;
+    prrte_list_t waiters;
+} prrte_data_key_t;
+static void dkcon(prrte_data_key_t *p)
+{
+    memset(p->key, 0, sizeof(p->key));
+    PRRTE_CONSTRUCT(&p->values, prrte_list_t);
+    PRRTE_CONSTRUCT(&p->waiters, prrte_list_t);
+}
+static void dkdes(prrte_data_key_t *p)
+{
+    PRRTE_LIST_DESTRUCT(&p->values);
+    PRRTE_LIST_DESTRUCT(&p->waiters);
+}
+static PRRTE_CLASS_INSTANCE(prrte_data_key_t,
+                          prrte_object_t,
+                          dkcon, dkdes);
+
+/* one published value on the list for its key */
+typedef struct prrte_data_ref_t {
+    prrte_list_item_t super;
+    prrte_data_key_t *dkey;
+    prrte_data_object_t *data;
+    size_t n;
+} prrte_data_ref_t;
+static PRRTE_CLASS_INSTANCE(prrte_data_ref_t,
+                          prrte_list_item_t,
+                          NULL, NULL);
+
+/* one pending lookup on the list for a key it is waiting on */
+typedef struct {
+    prrte_list_item_t super;
+    prrte_data_req_t *req;
+} prrte_data_waiter_t;
+static void dwdes(prrte_data_waiter_t *p)
+{
+    if (NULL != p->req) {
+        PRRTE_RELEASE(p->req);
+    }
+}
+static PRRTE_CLASS_INSTANCE(prrte_data_waiter_t,
+                          prrte_list_item_t,
+                          NULL, dwdes);
+
 /* local globals */
-static prrte_pointer_array_t prrte_data_server_store;
+/* key -> prrte_data_key_t */
+static prrte_hash_table_t prrte_data_server_keys;
+/* namespace -> list of prrte_data_object_t published from it */
+static prrte_hash_table_t prrte_data_server_owners;
 static prrte_list_t pending;
 static bool initialized = false;
 static int prrte_data_server_output = -1;
@@ -145,11 +206,13 @@ int prrte_data_server_init(void)
                                   prrte_data_server_verbosity);
     }
 
-    PRRTE_CONSTRUCT(&prrte_data_server_store, prrte_pointer_array_t);
-    if (PRRTE_SUCCESS != (rc = prrte_pointer_array_init(&prrte_data_server_store,
-                                                      1,
-                                                      INT_MAX,
-                                                      1))) {
+    PRRTE_CONSTRUCT(&prrte_data_server_keys, prrte_hash_table_t);
+    if (PRRTE_SUCCESS != (rc = prrte_hash_table_init(&prrte_data_server_keys, 1024))) {
+        PRRTE_ERROR_LOG(rc);
+        return rc;
+    }
+    PRRTE_CONSTRUCT(&prrte_data_server_owners, prrte_hash_table_t);
+    if (PRRTE_SUCCESS != (rc = prrte_hash_table_init(&prrte_data_server_owners, 32))) {
         PRRTE_ERROR_LOG(rc);
         return rc;
     }
@@ -167,23 +230,304 @@ int prrte_data_server_init(void)
 
 void prrte_data_server_finalize(void)
 {
-    prrte_std_cntr_t i;
-    prrte_data_object_t *data;
+    void *key, *node, *nxt;
+    size_t keysize;
+    prrte_data_key_t *dk;
+    prrte_list_t *owned;
+    int rc;
 
     if (!initialized) {
         return;
     }
     initialized = false;
 
-    for (i=0; i < prrte_data_server_store.size; i++) {
-        if (NULL != (data = (prrte_data_object_t*)prrte_pointer_array_get_item(&prrte_data_server_store, i))) {
-            PRRTE_RELEASE(data);
-        }
+    /* the key index holds the value refs and the waiters */
+    rc = prrte_hash_table_get_first_key_ptr(&prrte_data_server_keys, &key, &keysize,
+                                            (void**)&dk, &node);
+    while (PRRTE_SUCCESS == rc) {
+        PRRTE_RELEASE(dk);
+        rc = prrte_hash_table_get_next_key_ptr(&prrte_data_server_keys, &key, &keysize,
+                                               (void**)&dk, node, &nxt);
+        node = nxt;
     }
-    PRRTE_DESTRUCT(&prrte_data_server_store);
+    PRRTE_DESTRUCT(&prrte_data_server_keys);
+
+    /* the owner lists hold the data itself */
+    rc = prrte_hash_table_get_first_key_ptr(&prrte_data_server_owners, &key, &keysize,
+                                            (void**)&owned, &node);
+    while (PRRTE_SUCCESS == rc) {
+        PRRTE_LIST_RELEASE(owned);
+        rc = prrte_hash_table_get_next_key_ptr(&prrte_data_server_owners, &key, &keysize,
+                                               (void**)&owned, node, &nxt);
+        node = nxt;
+    }
+    PRRTE_DESTRUCT(&prrte_data_server_owners);
+
     PRRTE_LIST_DESTRUCT(&pending);
 }
 
+static prrte_data_key_t* get_key(const char *key, bool create)
+{
+    prrte_data_key_t *dk = NULL;
+    size_t len = strnlen(key, PMIX_MAX_KEYLEN);
+
+    if (0 == len) {
+        return NULL;
+    }
+    if (PRRTE_SUCCESS == prrte_hash_table_get_value_ptr(&prrte_data_server_keys,
+                                                        key, len, (void**)&dk)) {
+        return dk;
+    }
+    if (!create) {
+        return NULL;
+    }
+    dk = PRRTE_NEW(prrte_data_key_t);
+    memcpy(dk->key, key, len);
+    prrte_hash_table_set_value_ptr(&prrte_data_server_keys, dk->key, len, dk);
+    return dk;
+}
+
+/* drop a key from the index once nothing refers to it */
+static void release_key(prrte_data_key_t *dk)
+{
+    if (0 != prrte_list_get_size(&dk->values) ||
+        0 != prrte_list_get_size(&dk->waiters)) {
+        return;
+    }
+    prrte_hash_table_remove_value_ptr(&prrte_data_server_keys, dk->key,
+                                      strnlen(dk->key, PMIX_MAX_KEYLEN));
+    PRRTE_RELEASE(dk);
+}
+
+/* index each of the values in a newly published object */
+static int store_data(prrte_data_object_t *data)
+{
+    prrte_list_t *owned = NULL;
+    prrte_data_key_t *dk;
+    prrte_data_ref_t *ref;
+    size_t n, len;
+
+    data->refs = (prrte_data_ref_t**)calloc(data->ninfo, sizeof(prrte_data_ref_t*));
+    if (NULL == data->refs) {
+        return PRRTE_ERR_OUT_OF_RESOURCE;
+    }
+    for (n=0; n < data->ninfo; n++) {
+        if (NULL == (dk = get_key(data->info[n].key, true))) {
+            /* nothing can ever look up an empty key */
+            continue;
+        }
+        ref = PRRTE_NEW(prrte_data_ref_t);
+        ref->dkey = dk;
+        ref->data = data;
+        ref->n = n;
+        prrte_list_append(&ref->dkey->values, &ref->super);
+        data->refs[n] = ref;
+        data->nlive++;
+    }
+
+    len = strnlen(data->owner.nspace, PMIX_MAX_NSLEN);
+    if (PRRTE_SUCCESS != prrte_hash_table_get_value_ptr(&prrte_data_server_owners,
+                                                        data->owner.nspace, len,
+                                                        (void**)&owned)) {
+        owned = PRRTE_NEW(prrte_list_t);
+        prrte_hash_table_set_value_ptr(&prrte_data_server_owners,
+                                       data->owner.nspace, len, owned);
+    }
+    prrte_list_append(owned, &data->super);
+    return PRRTE_SUCCESS;
+}
+
+/* remove one value from an object - the object itself
+ * remains until the caller releases it */
+static void remove_value(prrte_data_object_t *data, size_t n)
+{
+    prrte_data_ref_t *ref = data->refs[n];
+    prrte_data_key_t *dk;
+
+    if (NULL == ref) {
+        return;
+    }
+    dk = ref->dkey;
+    prrte_list_remove_item(&dk->values, &ref->super);
+    PRRTE_RELEASE(ref);
+    release_key(dk);
+    data->refs[n] = NULL;
+    memset(data->info[n].key, 0, PMIX_MAX_KEYLEN+1);
+    data->nlive--;
+}
+
+static void remove_data(prrte_data_object_t *data)
+{
+    prrte_list_t *owned = NULL;
+    size_t n, len;
+
+    for (n=0; n < data->ninfo; n++) {
+        remove_value(data, n);
+    }
+    len = strnlen(data->owner.nspace, PMIX_MAX_NSLEN);
+    if (PRRTE_SUCCESS == prrte_hash_table_get_value_ptr(&prrte_data_server_owners,
+                                                        data->owner.nspace, len,
+                                                        (void**)&owned)) {
+        prrte_list_remove_item(owned, &data->super);
+        if (0 == prrte_list_get_size(owned)) {
+            prrte_hash_table_remove_value_ptr(&prrte_data_server_owners,
+                                              data->owner.nspace, len);
+            PRRTE_RELEASE(owned);
+        }
+    }
+    PRRTE_RELEASE(data);
+}
+
+/* park a lookup on each of the keys it is waiting for */
+static void wait_for_keys(prrte_data_req_t *req)
+{
+    prrte_data_waiter_t *w;
+    prrte_data_key_t *dk;
+    int i;
+
+    prrte_list_append(&pending, &req->super);
+    for (i=0; NULL != req->keys[i]; i++) {
+        if (NULL == (dk = get_key(req->keys[i], true))) {
+            continue;
+        }
+        w = PRRTE_NEW(prrte_data_waiter_t);
+        PRRTE_RETAIN(req);
+        w->req = req;
+        prrte_list_append(&dk->waiters, &w->super);
+    }
+}
+
+/* a pending lookup has been answered - remove it everywhere */
+static void release_request(prrte_data_req_t *req)
+{
+    prrte_data_waiter_t *w, *wnext;
+    prrte_data_key_t *dk;
+    int i;
+
+    for (i=0; NULL != req->keys[i]; i++) {
+        if (NULL == (dk = get_key(req->keys[i], false))) {
+            continue;
+        }
+        PRRTE_LIST_FOREACH_SAFE(w, wnext, &dk->waiters, prrte_data_waiter_t) {
+            if (w->req == req) {
+                prrte_list_remove_item(&dk->waiters, &w->super);
+                PRRTE_RELEASE(w);
+            }
+        }
+        release_key(dk);
+    }
+    prrte_list_remove_item(&pending, &req->super);
+    PRRTE_RELEASE(req);
+}
+
+/* drop the values a failed lookup would have consumed */
+static void release_consumed(prrte_list_t *consumed)
+{
+    prrte_data_ref_t *rref;
+
+    while (NULL != (rref = (prrte_data_ref_t*)prrte_list_remove_first(consumed))) {
+        PRRTE_RELEASE(rref->data);
+        PRRTE_RELEASE(rref);
+    }
+    PRRTE_DESTRUCT(consumed);
+}
+
+/* send the answers collected for a pending lookup */
+static int reply_to_waiter(prrte_data_req_t *req, pmix_proc_t *psender)
+{
+    prrte_buffer_t *reply;
+    pmix_data_buffer_t pbkt;
+    pmix_byte_object_t pbo;
+    prrte_byte_object_t bo, *boptr;
+    prrte_ds_info_t *rinfo;
+    uint8_t command = PRRTE_PMIX_LOOKUP_CMD;
+    pmix_status_t ret;
+    size_t n;
+    int rc, status;
+
+    n = prrte_list_get_size(&req->answers);
+
+    /* send it back to the requestor */
+    prrte_output_verbose(1, prrte_data_server_output,
+                         "%s data server: returning data to %s:%d",
+                         PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                         req->requestor.nspace, req->requestor.rank);
+
+    reply = PRRTE_NEW(prrte_buffer_t);
+    /* start with their room number */
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(reply, &req->room_number, 1, PRRTE_INT))) {
+        PRRTE_RELEASE(reply);
+        return rc;
+    }
+    /* we are responding to a lookup cmd */
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(reply, &command, 1, PRRTE_UINT8))) {
+        PRRTE_RELEASE(reply);
+        return rc;
+    }
+    /* if we found all of the requested keys, then indicate so */
+    if (n == (size_t)prrte_argv_count(req->keys)) {
+        status = PRRTE_SUCCESS;
+    } else {
+        status = PRRTE_ERR_PARTIAL_SUCCESS;
+    }
+    /* return the status */
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(reply, &status, 1, PRRTE_INT))) {
+        PRRTE_RELEASE(reply);
+        return rc;
+    }
+
+    /* pack the rest into a pmix_data_buffer_t */
+    PMIX_DATA_BUFFER_CONSTRUCT(&pbkt);
+
+    /* pack the number of returned info's */
+    if (PMIX_SUCCESS != (ret = PMIx_Data_pack(psender, &pbkt, &n, 1, PMIX_SIZE))) {
+        PMIX_ERROR_LOG(ret);
+        PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
+        PRRTE_RELEASE(reply);
+        return PRRTE_ERR_PACK_FAILURE;
+    }
+    /* loop thru and pack the individual responses - this is somewhat less
+     * efficient than packing an info array, but avoids another malloc
+     * operation just to assemble all the return values into a contiguous
+     * array */
+    PRRTE_LIST_FOREACH(rinfo, &req->answers, prrte_ds_info_t) {
+        /* pack the data owner */
+        if (PMIX_SUCCESS != (ret = PMIx_Data_pack(psender, &pbkt, &rinfo->source, 1, PMIX_PROC))) {
+            PMIX_ERROR_LOG(ret);
+            PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
+            PRRTE_RELEASE(reply);
+            return PRRTE_ERR_PACK_FAILURE;
+        }
+        /* pack the data */
+        if (PMIX_SUCCESS != (ret = PMIx_Data_pack(psender, &pbkt, rinfo->info, 1, PMIX_INFO))) {
+            PMIX_ERROR_LOG(ret);
+            PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
+            PRRTE_RELEASE(reply);
+            return PRRTE_ERR_PACK_FAILURE;
+        }
+    }
+
+    /* unload the pmix buffer */
+    PMIX_DATA_BUFFER_UNLOAD(&pbkt, pbo.bytes, pbo.size);
+    bo.bytes = (uint8_t*)pbo.bytes;
+    bo.size = pbo.size;
+
+    /* pack it into our reply */
+    boptr = &bo;
+    rc = prrte_dss.pack(reply, &boptr, 1, PRRTE_BYTE_OBJECT);
+    free(bo.bytes);
+    if (PRRTE_SUCCESS != rc) {
+        PRRTE_RELEASE(reply);
+        return rc;
+    }
+    if (0 > (rc = prrte_rml.send_buffer_nb(&req->proxy, reply, PRRTE_RML_TAG_DATA_CLIENT,
+                                          prrte_rml_send_callback, NULL))) {
+        PRRTE_RELEASE(reply);
+        return rc;
+    }
+    return PRRTE_SUCCESS;
+}
+
 void prrte_data_server(int status, prrte_process_name_t* sender,
                       prrte_buffer_t* buffer, prrte_rml_tag_t tag,
                       void* cbdata)
@@ -192,15 +536,19 @@ void prrte_data_server(int status, prrte_process_name_t* sender,
     prrte_std_cntr_t count;
     prrte_data_object_t *data;
     prrte_byte_object_t bo, *boptr;
-    prrte_buffer_t *answer, *reply;
-    int rc, k;
+    prrte_buffer_t *answer;
+    int rc;
     uint32_t ninfo, i;
     char **keys = NULL, *str;
     bool wait = false;
     int room_number;
     uint32_t uid = UINT32_MAX;
     pmix_data_range_t range;
-    prrte_data_req_t *req, *rqnext;
+    prrte_data_req_t *req;
+    prrte_data_key_t *dk;
+    prrte_data_ref_t *ref, *rnext, *rref;
+    prrte_data_waiter_t *w, *rw;
+    prrte_data_object_t *dnext;
     pmix_data_buffer_t pbkt;
     pmix_byte_object_t pbo;
     pmix_status_t ret;
@@ -208,7 +556,7 @@ void prrte_data_server(int status, prrte_process_name_t* sender,
     prrte_ds_info_t *rinfo;
     size_t n, nanswers;
     pmix_info_t *info;
-    prrte_list_t answers;
+    prrte_list_t answers, ready, consumed, *owned;
 
     prrte_output_verbose(1, prrte_data_server_output,
                         "%s data server got message from %s",
@@ -327,135 +675,65 @@ void prrte_data_server(int status, prrte_process_name_t* sender,
         }
 
         /* store this object */
-        data->index = prrte_pointer_array_add(&prrte_data_server_store, data);
+        if (PRRTE_SUCCESS != (rc = store_data(data))) {
+            PRRTE_ERROR_LOG(rc);
+            PRRTE_RELEASE(data);
+            goto SEND_ERROR;
+        }
 
         prrte_output_verbose(1, prrte_data_server_output,
                             "%s data server: checking for pending requests",
                             PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME));
 
-        /* check for pending requests that match this data */
-        reply = NULL;
-        PRRTE_LIST_FOREACH_SAFE(req, rqnext, &pending, prrte_data_req_t) {
-            if (req->uid != data->uid) {
+        /* check for pending requests waiting on any of these keys */
+        PRRTE_CONSTRUCT(&ready, prrte_list_t);
+        for (n=0; n < data->ninfo; n++) {
+            if (NULL == data->refs[n]) {
                 continue;
             }
-            /* if the published range is constrained to namespace, then only
-             * consider this data if the publisher is
-             * in the same namespace as the requestor */
-            if (PMIX_RANGE_NAMESPACE == data->range) {
-                if (0 != strncmp(req->requestor.nspace, data->owner.nspace, PMIX_MAX_NSLEN)) {
+            PRRTE_LIST_FOREACH(w, &data->refs[n]->dkey->waiters, prrte_data_waiter_t) {
+                req = w->req;
+                if (req->uid != data->uid) {
                     continue;
                 }
-            }
-            for (i=0; NULL != req->keys[i]; i++) {
-                /* cycle thru the data keys for matches */
-                for (n=0; n < data->ninfo; n++) {
-                    prrte_output_verbose(10, prrte_data_server_output,
-                                        "%s\tCHECKING %s TO %s",
-                                        PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
-                                        data->info[n].key, req->keys[i]);
-                    if (0 == strncmp(data->info[n].key, req->keys[i], PMIX_MAX_KEYLEN)) {
-                        prrte_output_verbose(10, prrte_data_server_output,
-                                            "%s data server: packaging return",
-                                            PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME));
-                        /* track this response */
-                        prrte_output_verbose(10, prrte_data_server_output,
-                                            "%s data server: adding %s data %s from %s:%d to response",
-                                            PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), data->info[n].key,
-                                            PMIx_Data_type_string(data->info[n].value.type),
-                                            data->owner.nspace, data->owner.rank);
-                        rinfo = PRRTE_NEW(prrte_ds_info_t);
-                        memcpy(&rinfo->source, &data->owner, sizeof(pmix_proc_t));
-                        rinfo->info = &data->info[n];
-                        prrte_list_append(&req->answers, &rinfo->super);
-                        break;  // a key can only occur once
+                /* if the published range is constrained to namespace, then only
+                 * consider this data if the publisher is
+                 * in the same namespace as the requestor */
+                if (PMIX_RANGE_NAMESPACE == data->range) {
+                    if (0 != strncmp(req->requestor.nspace, data->owner.nspace, PMIX_MAX_NSLEN)) {
+                        continue;
                     }
                 }
-            }
-            if (0 < (n = prrte_list_get_size(&req->answers))) {
-                /* send it back to the requestor */
-                prrte_output_verbose(1, prrte_data_server_output,
-                                     "%s data server: returning data to %s:%d",
-                                     PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
-                                     req->requestor.nspace, req->requestor.rank);
-
-                reply = PRRTE_NEW(prrte_buffer_t);
-                /* start with their room number */
-                if (PRRTE_SUCCESS != (rc = prrte_dss.pack(reply, &req->room_number, 1, PRRTE_INT))) {
-                    PRRTE_ERROR_LOG(rc);
-                    goto SEND_ERROR;
-                }
-                /* we are responding to a lookup cmd */
-                command = PRRTE_PMIX_LOOKUP_CMD;
-                if (PRRTE_SUCCESS != (rc = prrte_dss.pack(reply, &command, 1, PRRTE_UINT8))) {
-                    PRRTE_ERROR_LOG(rc);
-                    goto SEND_ERROR;
-                }
-                /* if we found all of the requested keys, then indicate so */
-                if (n == (size_t)prrte_argv_count(req->keys)) {
-                    i = PRRTE_SUCCESS;
-                } else {
-                    i = PRRTE_ERR_PARTIAL_SUCCESS;
-                }
-                /* return the status */
-                if (PRRTE_SUCCESS != (rc = prrte_dss.pack(reply, &i, 1, PRRTE_INT))) {
-                    PRRTE_ERROR_LOG(rc);
-                    goto SEND_ERROR;
+                prrte_output_verbose(10, prrte_data_server_output,
+                                    "%s data server: adding %s data %s from %s:%d to response",
+                                    PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), data->info[n].key,
+                                    PMIx_Data_type_string(data->info[n].value.type),
+                                    data->owner.nspace, data->owner.rank);
+                if (0 == prrte_list_get_size(&req->answers)) {
+                    /* first answer for this request */
+                    rw = PRRTE_NEW(prrte_data_waiter_t);
+                    PRRTE_RETAIN(req);
+                    rw->req = req;
+                    prrte_list_append(&ready, &rw->super);
                 }
+                /* track this response */
+                rinfo = PRRTE_NEW(prrte_ds_info_t);
+                memcpy(&rinfo->source, &data->owner, sizeof(pmix_proc_t));
+                rinfo->info = &data->info[n];
+                prrte_list_append(&req->answers, &rinfo->super);
+            }
+        }
 
-                /* pack the rest into a pmix_data_buffer_t */
-                PMIX_DATA_BUFFER_CONSTRUCT(&pbkt);
-
-                /* pack the number of returned info's */
-                if (PMIX_SUCCESS != (ret = PMIx_Data_pack(&psender, &pbkt, &n, 1, PMIX_SIZE))) {
-                    PMIX_ERROR_LOG(ret);
-                    PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
-                    rc = PRRTE_ERR_PACK_FAILURE;
-                    goto SEND_ERROR;
-                }
-                /* loop thru and pack the individual responses - this is somewhat less
-                 * efficient than packing an info array, but avoids another malloc
-                 * operation just to assemble all the return values into a contiguous
-                 * array */
-                while (NULL != (rinfo = (prrte_ds_info_t*)prrte_list_remove_first(&req->answers))) {
-                    /* pack the data owner */
-                    if (PMIX_SUCCESS != (ret = PMIx_Data_pack(&psender, &pbkt, &rinfo->source, 1, PMIX_PROC))) {
-                        PMIX_ERROR_LOG(ret);
-                        PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
-                        rc = PRRTE_ERR_PACK_FAILURE;
-                        goto SEND_ERROR;
-                    }
-                    /* pack the data */
-                    if (PMIX_SUCCESS != (ret = PMIx_Data_pack(&psender, &pbkt, rinfo->info, 1, PMIX_INFO))) {
-                        PMIX_ERROR_LOG(ret);
-                        PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
-                        rc = PRRTE_ERR_PACK_FAILURE;
-                        goto SEND_ERROR;
-                    }
-                }
-                PRRTE_LIST_DESTRUCT(&req->answers);
-                PRRTE_CONSTRUCT(&req->answers, prrte_list_t);
-
-                /* unload the pmix buffer */
-                PMIX_DATA_BUFFER_UNLOAD(&pbkt, pbo.bytes, pbo.size);
-                bo.bytes = (uint8_t*)pbo.bytes;
-                bo.size = pbo.size;
-
-                /* pack it into our reply */
-                boptr = &bo;
-                if (PRRTE_SUCCESS != (rc = prrte_dss.pack(reply, &boptr, 1, PRRTE_BYTE_OBJECT))) {
-                    PRRTE_ERROR_LOG(rc);
-                    free(bo.bytes);
-                    goto SEND_ERROR;
-                }
-                free(bo.bytes);
-                if (0 > (rc = prrte_rml.send_buffer_nb(&req->proxy, reply, PRRTE_RML_TAG_DATA_CLIENT,
-                                                      prrte_rml_send_callback, NULL))) {
-                    PRRTE_ERROR_LOG(rc);
-                    PRRTE_RELEASE(reply);
-                }
+        /* respond to each request we found data for */
+        while (NULL != (rw = (prrte_data_waiter_t*)prrte_list_remove_first(&ready))) {
+            if (PRRTE_SUCCESS != (rc = reply_to_waiter(rw->req, &psender))) {
+                PRRTE_ERROR_LOG(rc);
             }
+            /* this lookup has now been answered */
+            release_request(rw->req);
+            PRRTE_RELEASE(rw);
         }
+        PRRTE_DESTRUCT(&ready);
 
         /* tell the user it was wonderful... */
         rc = PRRTE_SUCCESS;
@@ -550,16 +828,18 @@ void prrte_data_server(int status, prrte_process_name_t* sender,
         PMIX_DATA_BUFFER_CONSTRUCT(&pbkt);
         PRRTE_CONSTRUCT(&answers, prrte_list_t);
 
+        PRRTE_CONSTRUCT(&consumed, prrte_list_t);
+
         for (i=0; NULL != keys[i]; i++) {
             prrte_output_verbose(10, prrte_data_server_output,
                                 "%s data server: looking for %s",
                                 PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), keys[i]);
-            /* cycle across the stored data, looking for a match */
-            for (k=0; k < prrte_data_server_store.size; k++) {
-                data = (prrte_data_object_t*)prrte_pointer_array_get_item(&prrte_data_server_store, k);
-                if (NULL == data) {
-                    continue;
-                }
+            if (NULL == (dk = get_key(keys[i], false))) {
+                continue;
+            }
+            /* cycle across the values published under this key */
+            PRRTE_LIST_FOREACH(ref, &dk->values, prrte_data_ref_t) {
+                data = ref->data;
                 /* for security reasons, can only access data posted by the same user id */
                 if (uid != data->uid) {
                     prrte_output_verbose(10, prrte_data_server_output,
@@ -580,25 +860,24 @@ void prrte_data_server(int status, prrte_process_name_t* sender,
                         continue;
                     }
                 }
-                /* see if we have this key */
-                for (n=0; n < data->ninfo; n++) {
-                    prrte_output_verbose(10, prrte_data_server_output,
-                                        "%s COMPARING %s %s",
-                                        PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
-                                        keys[i], data->info[n].key);
-                    if (0 == strncmp(data->info[n].key, keys[i], PMIX_MAX_KEYLEN)) {
-                        rinfo = PRRTE_NEW(prrte_ds_info_t);
-                        memcpy(&rinfo->source, &data->owner, sizeof(pmix_proc_t));
-                        rinfo->info = &data->info[n];
-                        rinfo->persistence = data->persistence;
-                        prrte_list_append(&answers, &rinfo->super);
-                        prrte_output_verbose(1, prrte_data_server_output,
-                                            "%s data server: adding %s to data from %s:%d",
-                                            PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), data->info[n].key,
-                                            data->owner.nspace, data->owner.rank);
-                    }
+                rinfo = PRRTE_NEW(prrte_ds_info_t);
+                memcpy(&rinfo->source, &data->owner, sizeof(pmix_proc_t));
+                rinfo->info = &data->info[ref->n];
+                rinfo->persistence = data->persistence;
+                prrte_list_append(&answers, &rinfo->super);
+                prrte_output_verbose(1, prrte_data_server_output,
+                                    "%s data server: adding %s to data from %s:%d",
+                                    PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME), data->info[ref->n].key,
+                                    data->owner.nspace, data->owner.rank);
+                if (PMIX_PERSIST_FIRST_READ == data->persistence) {
+                    /* remove it once the answer has been packed */
+                    rref = PRRTE_NEW(prrte_data_ref_t);
+                    PRRTE_RETAIN(data);
+                    rref->data = data;
+                    rref->n = ref->n;
+                    prrte_list_append(&consumed, &rref->super);
                 }
-            }  // loop over stored data
+            }
         }  // loop over keys
 
         if (0 < (nanswers = prrte_list_get_size(&answers))) {
@@ -607,6 +886,7 @@ void prrte_data_server(int status, prrte_process_name_t* sender,
                 PMIX_ERROR_LOG(ret);
                 rc = PRRTE_ERR_PACK_FAILURE;
                 PRRTE_LIST_DESTRUCT(&answers);
+                release_consumed(&consumed);
                 prrte_argv_free(keys);
                 goto SEND_ERROR;
             }
@@ -620,6 +900,7 @@ void prrte_data_server(int status, prrte_process_name_t* sender,
                     PMIX_ERROR_LOG(ret);
                     rc = PRRTE_ERR_PACK_FAILURE;
                     PRRTE_LIST_DESTRUCT(&answers);
+                    release_consumed(&consumed);
                     prrte_argv_free(keys);
                     goto SEND_ERROR;
                 }
@@ -627,21 +908,35 @@ void prrte_data_server(int status, prrte_process_name_t* sender,
                     PMIX_ERROR_LOG(ret);
                     rc = PRRTE_ERR_PACK_FAILURE;
                     PRRTE_LIST_DESTRUCT(&answers);
+                    release_consumed(&consumed);
                     prrte_argv_free(keys);
                     goto SEND_ERROR;
                 }
-                if (PMIX_PERSIST_FIRST_READ == rinfo->persistence) {
-                    prrte_output_verbose(1, prrte_data_server_output,
-                                        "%s REMOVING DATA FROM %s:%d FOR KEY %s",
-                                        PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
-                                        rinfo->source.nspace, rinfo->source.rank,
-                                        rinfo->info->key);
-                    memset(rinfo->info->key, 0, PMIX_MAX_KEYLEN+1);
-                }
             }
         }
         PRRTE_LIST_DESTRUCT(&answers);
 
+        /* remove any values that were only to be read once */
+        while (NULL != (rref = (prrte_data_ref_t*)prrte_list_remove_first(&consumed))) {
+            prrte_output_verbose(1, prrte_data_server_output,
+                                "%s REMOVING DATA FROM %s:%d FOR KEY %s",
+                                PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
+                                rref->data->owner.nspace, rref->data->owner.rank,
+                                rref->data->info[rref->n].key);
+            /* the object may already be gone if this lookup
+             * consumed more than one of its values */
+            if (0 < rref->data->nlive) {
+                remove_value(rref->data, rref->n);
+                /* if all the data has been removed, then remove the object */
+                if (0 == rref->data->nlive) {
+                    remove_data(rref->data);
+                }
+            }
+            PRRTE_RELEASE(rref->data);
+            PRRTE_RELEASE(rref);
+        }
+        PRRTE_DESTRUCT(&consumed);
+
         if (nanswers == (size_t)prrte_argv_count(keys)) {
             rc = PRRTE_SUCCESS;
         } else {
@@ -663,7 +958,7 @@ void prrte_data_server(int status, prrte_process_name_t* sender,
                 req->uid = uid;
                 req->range = range;
                 req->keys = keys;
-                prrte_list_append(&pending, &req->super);
+                wait_for_keys(req);
                 /* drop the partial response we have - we'll build it when everything
                  * becomes available */
                 PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
@@ -787,12 +1082,13 @@ void prrte_data_server(int status, prrte_process_name_t* sender,
 
         /* cycle across the provided keys */
         for (i=0; NULL != keys[i]; i++) {
-            /* cycle across the stored data, looking for a match */
-            for (k=0; k < prrte_data_server_store.size; k++) {
-                data = (prrte_data_object_t*)prrte_pointer_array_get_item(&prrte_data_server_store, k);
-                if (NULL == data) {
-                    continue;
-                }
+            if (NULL == (dk = get_key(keys[i], false))) {
+                continue;
+            }
+            /* hold the key while we remove values from it */
+            PRRTE_RETAIN(dk);
+            PRRTE_LIST_FOREACH_SAFE(ref, rnext, &dk->values, prrte_data_ref_t) {
+                data = ref->data;
                 /* can only access data posted by the same user id */
                 if (uid != data->uid) {
                     continue;
@@ -806,25 +1102,14 @@ void prrte_data_server(int status, prrte_process_name_t* sender,
                 if (range != data->range) {
                     continue;
                 }
-                /* see if we have this key */
-                nanswers = 0;
-                for (n=0; n < data->ninfo; n++) {
-                    if (0 == strlen(data->info[n].key)) {
-                        ++nanswers;
-                        continue;
-                    }
-                    if (0 == strncmp(data->info[n].key, keys[i], PMIX_MAX_KEYLEN)) {
-                        /* found it -  delete the object from the data store */
-                        memset(data->info[n].key, 0, PMIX_MAX_KEYLEN+1);
-                        ++nanswers;
-                    }
-                }
+                /* found it -  delete the value from the data store */
+                remove_value(data, ref->n);
                 /* if all the data has been removed, then remove the object */
-                if (nanswers == data->ninfo) {
-                    prrte_pointer_array_set_item(&prrte_data_server_store, k, NULL);
-                    PRRTE_RELEASE(data);
+                if (0 == data->nlive) {
+                    remove_data(data);
                 }
             }
+            PRRTE_RELEASE(dk);
         }
         prrte_argv_free(keys);
 
@@ -854,27 +1139,28 @@ void prrte_data_server(int status, prrte_process_name_t* sender,
                             PRRTE_NAME_PRINT(PRRTE_PROC_MY_NAME),
                             requestor.nspace, requestor.rank);
 
-        /* cycle across the stored data, looking for a match */
-        for (k=0; k < prrte_data_server_store.size; k++) {
-            data = (prrte_data_object_t*)prrte_pointer_array_get_item(&prrte_data_server_store, k);
-            if (NULL == data) {
-                continue;
-            }
-            /* check if data posted by the specified process */
-            if (0 != strncmp(requestor.nspace, data->owner.nspace, PMIX_MAX_NSLEN) ||
-                (PMIX_RANK_WILDCARD != requestor.rank && requestor.rank != data->owner.rank)) {
-                continue;
-            }
-            /* check persistence - if it is intended to persist beyond the
-             * proc itself, then we only delete it if rank=wildcard*/
-            if ((data->persistence == PMIX_PERSIST_APP ||
-                 data->persistence == PMIX_PERSIST_SESSION) &&
-                PMIX_RANK_WILDCARD != requestor.rank) {
-                continue;
+        /* cycle across the data published from this namespace */
+        if (PRRTE_SUCCESS == prrte_hash_table_get_value_ptr(&prrte_data_server_owners, requestor.nspace,
+                                                            strnlen(requestor.nspace, PMIX_MAX_NSLEN),
+                                                            (void**)&owned)) {
+            /* hold the list - removing its last entry releases it */
+            PRRTE_RETAIN(owned);
+            PRRTE_LIST_FOREACH_SAFE(data, dnext, owned, prrte_data_object_t) {
+                /* check if data posted by the specified process */
+                if (PMIX_RANK_WILDCARD != requestor.rank && requestor.rank != data->owner.rank) {
+                    continue;
+                }
+                /* check persistence - if it is intended to persist beyond the
+                 * proc itself, then we only delete it if rank=wildcard*/
+                if ((data->persistence == PMIX_PERSIST_APP ||
+                     data->persistence == PMIX_PERSIST_SESSION) &&
+                    PMIX_RANK_WILDCARD != requestor.rank) {
+                    continue;
+                }
+                /* remove the object */
+                remove_data(data);
             }
-            /* remove the object */
-            prrte_pointer_array_set_item(&prrte_data_server_store, k, NULL);
-            PRRTE_RELEASE(data);
+            PRRTE_RELEASE(owned);
         }
         /* no response is required */
         PRRTE_RELEASE(answer);
@@ -104,6 +104,7 @@ int prrte_finalize(void)
     }
 }
     PRRTE_RELEASE(prrte_node_topologies);
+    PRRTE_RELEASE(prrte_node_topology_sigs);
 
 {
     prrte_pointer_array_t * array = prrte_node_pool;
@@ -28,6 +28,8 @@
 #include "constants.h"
 #include "types.h"
 
+#include <string.h>
+
 #ifdef HAVE_SYS_TIME_H
 #include <sys/time.h>
 #endif
@@ -100,6 +102,7 @@ char *prrte_set_slots = NULL;
 bool prrte_soft_locations = false;
 bool prrte_nidmap_communicated = false;
 bool prrte_node_info_communicated = false;
+bool prrte_lazy_node_info = true;
 
 /* launch agents */
 char *prrte_launch_agent = NULL;
@@ -125,6 +128,7 @@ int prrte_stack_trace_wait_timeout = 30;
 prrte_hash_table_t *prrte_job_data = NULL;
 prrte_pointer_array_t *prrte_node_pool = NULL;
 prrte_pointer_array_t *prrte_node_topologies = NULL;
+prrte_hash_table_t *prrte_node_topology_sigs = NULL;
 prrte_pointer_array_t *prrte_local_children = NULL;
 prrte_vpid_t prrte_total_procs = 0;
 
@@ -407,6 +411,57 @@ prrte_job_t* prrte_get_job_data_object(prrte_jobid_t job)
     return jdata;
 }
 
+prrte_topology_t* prrte_get_topology_object(const char *sig)
+{
+    prrte_topology_t *t;
+
+    if (NULL == prrte_node_topology_sigs || NULL == sig) {
+        return NULL;
+    }
+
+    t = NULL;
+    prrte_hash_table_get_value_ptr(prrte_node_topology_sigs, sig, strlen(sig), (void**)&t);
+    return t;
+}
+
+int prrte_set_topology_object(prrte_topology_t *t)
+{
+    prrte_topology_t *old;
+    int rc;
+
+    if (0 <= t->index) {
+        /* if something else was already at this position, it
+         * is about to be replaced - drop it from the index */
+        old = (prrte_topology_t*)prrte_pointer_array_get_item(prrte_node_topologies, t->index);
+        if (NULL != old && old != t && NULL != old->sig &&
+            prrte_get_topology_object(old->sig) == old) {
+            prrte_hash_table_remove_value_ptr(prrte_node_topology_sigs, old->sig, strlen(old->sig));
+        }
+        if (PRRTE_SUCCESS != (rc = prrte_pointer_array_set_item(prrte_node_topologies, t->index, t))) {
+            PRRTE_ERROR_LOG(rc);
+            return rc;
+        }
+    } else if (0 > (t->index = prrte_pointer_array_add(prrte_node_topologies, t))) {
+        PRRTE_ERROR_LOG(PRRTE_ERR_OUT_OF_RESOURCE);
+        return PRRTE_ERR_OUT_OF_RESOURCE;
+    }
+
+    if (NULL != t->sig) {
+        rc = prrte_hash_table_set_value_ptr(prrte_node_topology_sigs, t->sig, strlen(t->sig), t);
+        if (PRRTE_SUCCESS != rc) {
+            PRRTE_ERROR_LOG(rc);
+            return rc;
+        }
+    }
+
+    /* the mappers will want the object counts for every node
+     * that shares this topology - compute them now, once */
+    if (NULL != t->topo) {
+        prrte_hwloc_base_summarize(t->topo);
+    }
+    return PRRTE_SUCCESS;
+}
+
 prrte_proc_t* prrte_get_proc_object(prrte_process_name_t *proc)
 {
     prrte_job_t *jdata;
@@ -911,6 +966,7 @@ PRRTE_CLASS_INSTANCE(prrte_attribute_t,
 
 static void tcon(prrte_topology_t *t)
 {
+    t->index = -1;
     t->topo = NULL;
     t->sig = NULL;
 }
@@ -439,6 +439,20 @@ PRRTE_EXPORT prrte_node_rank_t prrte_get_proc_node_rank(prrte_process_name_t *pr
 /* check to see if two nodes match */
 PRRTE_EXPORT bool prrte_node_match(prrte_node_t *n1, char *name);
 
+/**
+ * Lookup a known topology by its signature - returns
+ * NULL if no node with that topology has been seen
+ */
+PRRTE_EXPORT prrte_topology_t* prrte_get_topology_object(const char *sig);
+
+/**
+ * Record a topology in the global array and index it by
+ * signature. If t->index is already set, the topology is
+ * stored at that position - otherwise it is appended and
+ * t->index is set to its location
+ */
+PRRTE_EXPORT int prrte_set_topology_object(prrte_topology_t *t);
+
 /* global variables used by RTE - instanced in prrte_globals.c */
 PRRTE_EXPORT extern bool prrte_debug_daemons_flag;
 PRRTE_EXPORT extern bool prrte_debug_daemons_file_flag;
@@ -482,6 +496,7 @@ PRRTE_EXPORT extern bool prrte_soft_locations;
 PRRTE_EXPORT extern bool prrte_hnp_connected;
 PRRTE_EXPORT extern bool prrte_nidmap_communicated;
 PRRTE_EXPORT extern bool prrte_node_info_communicated;
+PRRTE_EXPORT extern bool prrte_lazy_node_info;
 
 /* launch agents */
 PRRTE_EXPORT extern char *prrte_launch_agent;
@@ -504,6 +519,7 @@ PRRTE_EXPORT extern prrte_timer_t *prrte_mpiexec_timeout;
 PRRTE_EXPORT extern prrte_hash_table_t *prrte_job_data;
 PRRTE_EXPORT extern prrte_pointer_array_t *prrte_node_pool;
 PRRTE_EXPORT extern prrte_pointer_array_t *prrte_node_topologies;
+PRRTE_EXPORT extern prrte_hash_table_t *prrte_node_topology_sigs;
 PRRTE_EXPORT extern prrte_pointer_array_t *prrte_local_children;
 PRRTE_EXPORT extern prrte_vpid_t prrte_total_procs;
 
@@ -309,6 +309,12 @@ int prrte_init(int* pargc, char*** pargv, prrte_proc_type_t flags)
         error = "setup node topologies array";
         goto error;
     }
+    prrte_node_topology_sigs = PRRTE_NEW(prrte_hash_table_t);
+    if (PRRTE_SUCCESS != (ret = prrte_hash_table_init(prrte_node_topology_sigs, 32))) {
+        PRRTE_ERROR_LOG(ret);
+        error = "setup node topologies index";
+        goto error;
+    }
 
     /* open the SCHIZO framework as everyone needs it, and the
      * ess will use it to help select its component */
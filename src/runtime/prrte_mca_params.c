@@ -716,6 +716,13 @@ int prrte_register_params(void)
                                   PRRTE_INFO_LVL_9, PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
                                   &prrte_soft_locations);
 
+    prrte_lazy_node_info = true;
+    (void) prrte_mca_base_var_register ("prrte", "prrte", NULL, "lazy_node_info",
+                                  "Only apply the per-node slot, flag and topology info on a daemon when the node is actually used by a job [Default = enabled]",
+                                  PRRTE_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                  PRRTE_INFO_LVL_9, PRRTE_MCA_BASE_VAR_SCOPE_READONLY,
+                                  &prrte_lazy_node_info);
+
     /* allow specification of the cores to be used by daemons */
     prrte_daemon_cores = NULL;
     (void) prrte_mca_base_var_register ("prrte", "prrte", NULL, "daemon_cores",
@@ -1813,10 +1813,10 @@ static int create_app(int argc, char* argv[],
             prrte_list_append(&app->info, &val->super);
         }
     }
-    if (prrte_cmd_line_is_taken(prrte_cmd_line, "preload-files")) {
+    if (NULL != (pvalue = prrte_cmd_line_get_param(prrte_cmd_line, "preload-files", 0, 0))) {
         val = PRRTE_NEW(prrte_ds_info_t);
         PMIX_INFO_CREATE(val->info, 1);
-        PMIX_INFO_LOAD(val->info, PMIX_PRELOAD_FILES, NULL, PMIX_BOOL);
+        PMIX_INFO_LOAD(val->info, PMIX_PRELOAD_FILES, pvalue->data.string, PMIX_STRING);
         prrte_list_append(&app->info, &val->super);
     }
 
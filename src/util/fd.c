@@ -41,6 +41,9 @@
 #ifdef HAVE_DIRENT_H
 #include <dirent.h>
 #endif
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
 #ifdef HAVE_STRINGS_H
 #include <strings.h>
 #endif
@@ -189,14 +192,49 @@ const char *prrte_fd_get_peer_name(int fd)
 
 static int fdmax = -1;
 
+/* close the fds in [lo, hi] with a single call if the kernel
+ * lets us - returns false if it isn't supported */
+static bool close_fd_range(unsigned int lo, unsigned int hi)
+{
+    if (hi < lo) {
+        return true;
+    }
+#if defined(HAVE_CLOSE_RANGE)
+    return (0 == close_range(lo, hi, 0));
+#elif defined(SYS_close_range)
+    return (0 == syscall(SYS_close_range, lo, hi, 0));
+#else
+    return false;
+#endif
+}
+
+bool prrte_fd_have_close_range(void)
+{
+    /* the range is empty, so this only asks the kernel */
+    return close_fd_range(~0U, ~0U);
+}
+
 /* close all open file descriptors w/ exception of stdin/stdout/stderr
    and the pipe up to the parent. */
 void prrte_close_open_file_descriptors(int protected_fd)
 {
-    DIR *dir = opendir("/proc/self/fd");
+    DIR *dir;
     int fd;
     struct dirent *files;
 
+    /* try close_range first - it doesn't allocate or walk /proc.
+     * The scan below does both, so anyone calling us from a vfork'd
+     * child must first check prrte_fd_have_close_range() */
+    if (protected_fd < 3) {
+        if (close_fd_range(3, ~0U)) {
+            return;
+        }
+    } else if (close_fd_range(3, protected_fd - 1) &&
+               close_fd_range(protected_fd + 1, ~0U)) {
+        return;
+    }
+
+    dir = opendir("/proc/self/fd");
     if (NULL == dir) {
         goto slow;
     }
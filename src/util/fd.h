@@ -111,6 +111,12 @@ PRRTE_EXPORT const char *prrte_fd_get_peer_name(int fd);
  */
 PRRTE_EXPORT void prrte_close_open_file_descriptors(int protected_fd);
 
+/**
+ * Can prrte_close_open_file_descriptors() close everything with
+ * close_range, i.e., without allocating or scanning /proc?
+ */
+PRRTE_EXPORT bool prrte_fd_have_close_range(void);
+
 END_C_DECLS
 
 #endif
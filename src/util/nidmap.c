@@ -30,42 +30,51 @@
 
 #include "src/util/nidmap.h"
 
-int prrte_util_nidmap_create(prrte_pointer_array_t *pool,
-                            prrte_buffer_t *buffer)
+/* nidmap encodings - the ranges encoding is used whenever the
+ * node names collapse into runs of sequentially numbered hosts,
+ * which is the case on nearly every cluster. Otherwise we fall
+ * back to shipping the compressed list of names */
+#define PRRTE_NIDMAP_LEGACY  0
+#define PRRTE_NIDMAP_RANGES  1
+
+/* numbers with more digits than this are treated as part of the name */
+#define PRRTE_NIDMAP_MAX_DIGITS  9
+
+/* locate the last run of digits in a hostname - returns false
+ * if the name has no (usable) number in it */
+static bool nidmap_split_name(const char *name, size_t *begin,
+                              size_t *end, uint32_t *num)
+{
+    size_t len = strlen(name), b, e;
+
+    for (e=len; 0 < e && !isdigit((unsigned char)name[e-1]); e--);
+    if (0 == e) {
+        return false;
+    }
+    for (b=e-1; 0 < b && isdigit((unsigned char)name[b-1]); b--);
+    if (PRRTE_NIDMAP_MAX_DIGITS < e - b) {
+        return false;
+    }
+    *begin = b;
+    *end = e;
+    *num = strtoul(&name[b], NULL, 10);
+    return true;
+}
+
+static int pack_legacy(prrte_pointer_array_t *pool,
+                       prrte_buffer_t *buffer)
 {
     char *raw = NULL;
-    uint8_t *vpids=NULL, u8;
+    uint8_t *vpids=NULL;
     uint16_t u16;
     uint32_t u32;
     int n, ndaemons, rc, nbytes;
     bool compressed;
-    char **names = NULL, **ranks = NULL;
+    char **names = NULL;
     prrte_node_t *nptr;
     prrte_byte_object_t bo, *boptr;
     size_t sz;
 
-    /* pack a flag indicating if the HNP was included in the allocation */
-    if (prrte_hnp_is_allocated) {
-        u8 = 1;
-    } else {
-        u8 = 0;
-    }
-    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buffer, &u8, 1, PRRTE_UINT8))) {
-        PRRTE_ERROR_LOG(rc);
-        return rc;
-    }
-
-    /* pack a flag indicating if we are in a managed allocation */
-    if (prrte_managed_allocation) {
-        u8 = 1;
-    } else {
-        u8 = 0;
-    }
-    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buffer, &u8, 1, PRRTE_UINT8))) {
-        PRRTE_ERROR_LOG(rc);
-        return rc;
-    }
-
     /* daemon vpids start from 0 and increase linearly by one
      * up to the number of nodes in the system. The vpid is
      * a 32-bit value. We don't know how many of the nodes
@@ -208,9 +217,6 @@ int prrte_util_nidmap_create(prrte_pointer_array_t *pool,
     if (NULL != raw) {
         free(raw);
     }
-    if (NULL != ranks) {
-        prrte_argv_free(ranks);
-    }
     if (NULL != vpids) {
         free(vpids);
     }
@@ -218,44 +224,295 @@ int prrte_util_nidmap_create(prrte_pointer_array_t *pool,
     return rc;
 }
 
-int prrte_util_decode_nidmap(prrte_buffer_t *buf)
+/* describe the nodes as a table of name ranges - each range
+ * covers consecutive nodes in the pool named <prefix><N><suffix>
+ * for N = start..start+count-1, with N zero-padded to width
+ * digits (0 => no padding, -1 => the name has no number and
+ * the range covers exactly one node). Daemon vpids are described
+ * by a separate table of runs, each covering count consecutive
+ * nodes whose vpids increase by one from start (UINT32_MAX =>
+ * the nodes have no daemon). Node order is preserved, so ranges
+ * are only formed from names that are adjacent in the pool.
+ *
+ * Returns PRRTE_ERR_TAKE_NEXT_OPTION if the names don't collapse
+ * well enough for this to beat the legacy encoding */
+static int pack_ranges(prrte_pointer_array_t *pool,
+                       prrte_buffer_t *buffer)
 {
-    uint8_t u8, *vp8 = NULL;
-    uint16_t *vp16 = NULL;
-    uint32_t *vp32 = NULL, vpid;
-    int cnt, rc, nbytes, n;
-    bool compressed;
-    size_t sz;
-    prrte_byte_object_t *boptr;
-    char *raw = NULL, **names = NULL;
-    prrte_node_t *nd;
-    prrte_job_t *daemons;
-    prrte_proc_t *proc;
-    prrte_topology_t *t = NULL;
+    char **prefixes = NULL, **suffixes = NULL;
+    int32_t *widths = NULL, nranges = 0, nvruns = 0, width;
+    uint32_t *starts = NULL, *counts = NULL;
+    uint32_t *vstarts = NULL, *vcounts = NULL;
+    uint32_t num, vpid;
+    int n, r, nnodes = 0, rc = PRRTE_SUCCESS;
+    size_t b, e;
+    char digits[PRRTE_NIDMAP_MAX_DIGITS+2];
+    prrte_node_t *nptr;
+    bool extended;
+
+    prefixes = (char**)calloc(pool->size + 1, sizeof(char*));
+    suffixes = (char**)calloc(pool->size + 1, sizeof(char*));
+    widths = (int32_t*)malloc(pool->size * sizeof(int32_t));
+    starts = (uint32_t*)malloc(pool->size * sizeof(uint32_t));
+    counts = (uint32_t*)malloc(pool->size * sizeof(uint32_t));
+    vstarts = (uint32_t*)malloc(pool->size * sizeof(uint32_t));
+    vcounts = (uint32_t*)malloc(pool->size * sizeof(uint32_t));
+    if (NULL == prefixes || NULL == suffixes || NULL == widths || NULL == starts ||
+        NULL == counts || NULL == vstarts || NULL == vcounts) {
+        rc = PRRTE_ERR_OUT_OF_RESOURCE;
+        goto cleanup;
+    }
 
-    /* unpack the flag indicating if HNP is in allocation */
-    cnt = 1;
-    if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buf, &u8, &cnt, PRRTE_UINT8))) {
+    for (n=0; n < pool->size; n++) {
+        if (NULL == (nptr = (prrte_node_t*)prrte_pointer_array_get_item(pool, n))) {
+            continue;
+        }
+        ++nnodes;
+
+        /* extend the current vpid run if we can */
+        if (NULL == nptr->daemon) {
+            vpid = UINT32_MAX;
+        } else {
+            vpid = nptr->daemon->name.vpid;
+        }
+        if (0 < nvruns &&
+            ((UINT32_MAX == vpid && UINT32_MAX == vstarts[nvruns-1]) ||
+             (UINT32_MAX != vpid && UINT32_MAX != vstarts[nvruns-1] &&
+              vpid == vstarts[nvruns-1] + vcounts[nvruns-1]))) {
+            vcounts[nvruns-1]++;
+        } else {
+            vstarts[nvruns] = vpid;
+            vcounts[nvruns] = 1;
+            ++nvruns;
+        }
+
+        /* extend the current name range if this is its next member */
+        if (!nidmap_split_name(nptr->name, &b, &e, &num)) {
+            prefixes[nranges] = strdup(nptr->name);
+            suffixes[nranges] = strdup("");
+            widths[nranges] = -1;
+            starts[nranges] = 0;
+            counts[nranges] = 1;
+            ++nranges;
+            continue;
+        }
+        extended = false;
+        if (0 < nranges && 0 <= widths[nranges-1] &&
+            num == starts[nranges-1] + counts[nranges-1] &&
+            strlen(prefixes[nranges-1]) == b &&
+            0 == strncmp(prefixes[nranges-1], nptr->name, b) &&
+            0 == strcmp(suffixes[nranges-1], &nptr->name[e])) {
+            /* the number must also be rendered the same way */
+            snprintf(digits, sizeof(digits), "%0*u", (int)widths[nranges-1], num);
+            if (strlen(digits) == e - b &&
+                0 == strncmp(digits, &nptr->name[b], e - b)) {
+                counts[nranges-1]++;
+                extended = true;
+            }
+        }
+        if (!extended) {
+            /* only a leading zero tells us the number is padded */
+            if ('0' == nptr->name[b] && 1 < e - b) {
+                width = e - b;
+            } else {
+                width = 0;
+            }
+            prefixes[nranges] = (char*)malloc(b + 1);
+            memcpy(prefixes[nranges], nptr->name, b);
+            prefixes[nranges][b] = '\0';
+            suffixes[nranges] = strdup(&nptr->name[e]);
+            widths[nranges] = width;
+            starts[nranges] = num;
+            counts[nranges] = 1;
+            ++nranges;
+        }
+    }
+
+    /* if the names are irregular, the compressed list will be smaller */
+    if (1 < nranges && nnodes < 2 * nranges) {
+        rc = PRRTE_ERR_TAKE_NEXT_OPTION;
+        goto cleanup;
+    }
+
+    /* pack the name ranges */
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buffer, &nranges, 1, PRRTE_INT32))) {
         PRRTE_ERROR_LOG(rc);
         goto cleanup;
     }
-    if (1 == u8) {
-        prrte_hnp_is_allocated = true;
-    } else {
-        prrte_hnp_is_allocated = false;
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buffer, prefixes, nranges, PRRTE_STRING))) {
+        PRRTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buffer, suffixes, nranges, PRRTE_STRING))) {
+        PRRTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buffer, widths, nranges, PRRTE_INT32))) {
+        PRRTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buffer, starts, nranges, PRRTE_UINT32))) {
+        PRRTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buffer, counts, nranges, PRRTE_UINT32))) {
+        PRRTE_ERROR_LOG(rc);
+        goto cleanup;
     }
 
-    /* unpack the flag indicating if we are in managed allocation */
-    cnt = 1;
-    if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buf, &u8, &cnt, PRRTE_UINT8))) {
+    /* pack the vpid runs */
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buffer, &nvruns, 1, PRRTE_INT32))) {
         PRRTE_ERROR_LOG(rc);
         goto cleanup;
     }
-    if (1 == u8) {
-        prrte_managed_allocation = true;
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buffer, vstarts, nvruns, PRRTE_UINT32))) {
+        PRRTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buffer, vcounts, nvruns, PRRTE_UINT32))) {
+        PRRTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+
+  cleanup:
+    for (r=0; r < nranges; r++) {
+        free(prefixes[r]);
+        free(suffixes[r]);
+    }
+    if (NULL != prefixes) {
+        free(prefixes);
+    }
+    if (NULL != suffixes) {
+        free(suffixes);
+    }
+    if (NULL != widths) {
+        free(widths);
+    }
+    if (NULL != starts) {
+        free(starts);
+    }
+    if (NULL != counts) {
+        free(counts);
+    }
+    if (NULL != vstarts) {
+        free(vstarts);
+    }
+    if (NULL != vcounts) {
+        free(vcounts);
+    }
+    return rc;
+}
+
+int prrte_util_nidmap_create(prrte_pointer_array_t *pool,
+                            prrte_buffer_t *buffer)
+{
+    uint8_t u8;
+    int rc;
+    prrte_buffer_t bucket;
+
+    /* pack a flag indicating if the HNP was included in the allocation */
+    if (prrte_hnp_is_allocated) {
+        u8 = 1;
     } else {
-        prrte_managed_allocation = false;
+        u8 = 0;
+    }
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buffer, &u8, 1, PRRTE_UINT8))) {
+        PRRTE_ERROR_LOG(rc);
+        return rc;
+    }
+
+    /* pack a flag indicating if we are in a managed allocation */
+    if (prrte_managed_allocation) {
+        u8 = 1;
+    } else {
+        u8 = 0;
+    }
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buffer, &u8, 1, PRRTE_UINT8))) {
+        PRRTE_ERROR_LOG(rc);
+        return rc;
+    }
+
+    /* try the ranges encoding first - we don't know if it will
+     * pay off until we have seen all the names, so build it in
+     * a separate bucket */
+    PRRTE_CONSTRUCT(&bucket, prrte_buffer_t);
+    rc = pack_ranges(pool, &bucket);
+    if (PRRTE_SUCCESS == rc) {
+        u8 = PRRTE_NIDMAP_RANGES;
+        if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buffer, &u8, 1, PRRTE_UINT8))) {
+            PRRTE_ERROR_LOG(rc);
+        } else if (PRRTE_SUCCESS != (rc = prrte_dss.copy_payload(buffer, &bucket))) {
+            PRRTE_ERROR_LOG(rc);
+        }
+        PRRTE_DESTRUCT(&bucket);
+        return rc;
+    }
+    PRRTE_DESTRUCT(&bucket);
+    if (PRRTE_ERR_TAKE_NEXT_OPTION != rc) {
+        return rc;
+    }
+
+    u8 = PRRTE_NIDMAP_LEGACY;
+    if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buffer, &u8, 1, PRRTE_UINT8))) {
+        PRRTE_ERROR_LOG(rc);
+        return rc;
+    }
+    return pack_legacy(pool, buffer);
+}
+
+/* create the node object for the n'th node in the nidmap and,
+ * if it hosts a daemon, the daemon's proc object */
+static void nidmap_add_node(int n, char *name, uint32_t vpid,
+                            prrte_job_t *daemons, prrte_topology_t *t)
+{
+    prrte_node_t *nd;
+    prrte_proc_t *proc;
+    char *raw;
+
+    /* add this name to the pool */
+    nd = PRRTE_NEW(prrte_node_t);
+    nd->name = name;
+    nd->index = n;
+    prrte_pointer_array_set_item(prrte_node_pool, n, nd);
+    /* see if this is our node */
+    if (prrte_check_host_is_local(name)) {
+        /* add our aliases as an attribute - will include all the interface aliases captured in prrte_init */
+        raw = prrte_argv_join(prrte_process_info.aliases, ',');
+        prrte_set_attribute(&nd->attributes, PRRTE_NODE_ALIAS, PRRTE_ATTR_LOCAL, raw, PRRTE_STRING);
+        free(raw);
+    }
+    /* set the topology - always default to homogeneous
+     * as that is the most common scenario */
+    nd->topology = t;
+    /* see if it has a daemon on it */
+    if (UINT32_MAX != vpid) {
+        if (NULL == (proc = (prrte_proc_t*)prrte_pointer_array_get_item(daemons->procs, vpid))) {
+            proc = PRRTE_NEW(prrte_proc_t);
+            proc->name.jobid = PRRTE_PROC_MY_NAME->jobid;
+            proc->name.vpid = vpid;
+            proc->state = PRRTE_PROC_STATE_RUNNING;
+            PRRTE_FLAG_SET(proc, PRRTE_PROC_FLAG_ALIVE);
+            daemons->num_procs++;
+            prrte_pointer_array_set_item(daemons->procs, proc->name.vpid, proc);
+        }
+        PRRTE_RETAIN(nd);
+        proc->node = nd;
+        PRRTE_RETAIN(proc);
+        nd->daemon = proc;
     }
+}
+
+static int unpack_legacy(prrte_buffer_t *buf, prrte_job_t *daemons,
+                         prrte_topology_t *t)
+{
+    uint8_t *vp8 = NULL;
+    uint16_t *vp16 = NULL;
+    uint32_t *vp32 = NULL, vpid;
+    int cnt, rc, nbytes, n;
+    bool compressed;
+    size_t sz;
+    prrte_byte_object_t *boptr;
+    char *raw = NULL, **names = NULL;
 
     /* unpack compression flag for node names */
     cnt = 1;
@@ -366,44 +623,14 @@ int prrte_util_decode_nidmap(prrte_buffer_t *buf)
     }
 
     /* if we are the HNP, we don't need any of this stuff */
-    if (PRRTE_PROC_IS_MASTER) {
+    if (NULL == daemons) {
         rc = PRRTE_SUCCESS;
         goto cleanup;
     }
 
-    /* get the daemon job object */
-    daemons = prrte_get_job_data_object(PRRTE_PROC_MY_NAME->jobid);
-
-    /* get our topology */
-    for (n=0; n < prrte_node_topologies->size; n++) {
-        if (NULL != (t = (prrte_topology_t*)prrte_pointer_array_get_item(prrte_node_topologies, n))) {
-            break;
-        }
-    }
-    if (NULL == t) {
-        /* should never happen */
-        PRRTE_ERROR_LOG(PRRTE_ERR_NOT_FOUND);
-        rc = PRRTE_ERR_NOT_FOUND;
-        goto cleanup;
-    }
     /* create the node pool array - this will include
      * _all_ nodes known to the allocation */
     for (n=0; NULL != names[n]; n++) {
-        /* add this name to the pool */
-        nd = PRRTE_NEW(prrte_node_t);
-        nd->name = strdup(names[n]);
-        nd->index = n;
-        prrte_pointer_array_set_item(prrte_node_pool, n, nd);
-        /* see if this is our node */
-        if (prrte_check_host_is_local(names[n])) {
-            /* add our aliases as an attribute - will include all the interface aliases captured in prrte_init */
-            raw = prrte_argv_join(prrte_process_info.aliases, ',');
-            prrte_set_attribute(&nd->attributes, PRRTE_NODE_ALIAS, PRRTE_ATTR_LOCAL, raw, PRRTE_STRING);
-            free(raw);
-        }
-        /* set the topology - always default to homogeneous
-         * as that is the most common scenario */
-        nd->topology = t;
         /* see if it has a daemon on it */
         if (1 == nbytes && UINT8_MAX != vp8[n]) {
             vpid = vp8[n];
@@ -414,30 +641,9 @@ int prrte_util_decode_nidmap(prrte_buffer_t *buf)
         } else {
             vpid = UINT32_MAX;
         }
-        if (UINT32_MAX != vpid) {
-            if (NULL == (proc = (prrte_proc_t*)prrte_pointer_array_get_item(daemons->procs, vpid))) {
-                proc = PRRTE_NEW(prrte_proc_t);
-                proc->name.jobid = PRRTE_PROC_MY_NAME->jobid;
-                proc->name.vpid = vpid;
-                proc->state = PRRTE_PROC_STATE_RUNNING;
-                PRRTE_FLAG_SET(proc, PRRTE_PROC_FLAG_ALIVE);
-                daemons->num_procs++;
-                prrte_pointer_array_set_item(daemons->procs, proc->name.vpid, proc);
-            }
-            PRRTE_RETAIN(nd);
-            proc->node = nd;
-            PRRTE_RETAIN(proc);
-            nd->daemon = proc;
-        }
+        nidmap_add_node(n, strdup(names[n]), vpid, daemons, t);
     }
 
-    /* update num procs */
-    if (prrte_process_info.num_daemons != daemons->num_procs) {
-        prrte_process_info.num_daemons = daemons->num_procs;
-    }
-    /* need to update the routing plan */
-    prrte_routed.update_routing_plan();
-
   cleanup:
     if (NULL != vp8) {
         free(vp8);
@@ -454,6 +660,249 @@ int prrte_util_decode_nidmap(prrte_buffer_t *buf)
     return rc;
 }
 
+/* expand the ranges table built by pack_ranges - the only
+ * per-node work is rendering each node's name */
+static int unpack_ranges(prrte_buffer_t *buf, prrte_job_t *daemons,
+                         prrte_topology_t *t)
+{
+    char **prefixes = NULL, **suffixes = NULL, *name;
+    int32_t *widths = NULL, nranges = 0, nvruns = 0;
+    uint32_t *starts = NULL, *counts = NULL;
+    uint32_t *vstarts = NULL, *vcounts = NULL;
+    uint32_t k, vpid;
+    int cnt, rc, n, r, v;
+    size_t vk;
+
+    cnt = 1;
+    if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buf, &nranges, &cnt, PRRTE_INT32))) {
+        PRRTE_ERROR_LOG(rc);
+        return rc;
+    }
+    if (nranges <= 0) {
+        PRRTE_ERROR_LOG(PRRTE_ERR_BAD_PARAM);
+        return PRRTE_ERR_BAD_PARAM;
+    }
+    prefixes = (char**)calloc(nranges, sizeof(char*));
+    suffixes = (char**)calloc(nranges, sizeof(char*));
+    widths = (int32_t*)malloc(nranges * sizeof(int32_t));
+    starts = (uint32_t*)malloc(nranges * sizeof(uint32_t));
+    counts = (uint32_t*)malloc(nranges * sizeof(uint32_t));
+    if (NULL == prefixes || NULL == suffixes || NULL == widths ||
+        NULL == starts || NULL == counts) {
+        rc = PRRTE_ERR_OUT_OF_RESOURCE;
+        goto cleanup;
+    }
+    cnt = nranges;
+    if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buf, prefixes, &cnt, PRRTE_STRING))) {
+        PRRTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    cnt = nranges;
+    if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buf, suffixes, &cnt, PRRTE_STRING))) {
+        PRRTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    cnt = nranges;
+    if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buf, widths, &cnt, PRRTE_INT32))) {
+        PRRTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    cnt = nranges;
+    if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buf, starts, &cnt, PRRTE_UINT32))) {
+        PRRTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    cnt = nranges;
+    if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buf, counts, &cnt, PRRTE_UINT32))) {
+        PRRTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+
+    cnt = 1;
+    if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buf, &nvruns, &cnt, PRRTE_INT32))) {
+        PRRTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    if (nvruns <= 0) {
+        PRRTE_ERROR_LOG(PRRTE_ERR_BAD_PARAM);
+        rc = PRRTE_ERR_BAD_PARAM;
+        goto cleanup;
+    }
+    vstarts = (uint32_t*)malloc(nvruns * sizeof(uint32_t));
+    vcounts = (uint32_t*)malloc(nvruns * sizeof(uint32_t));
+    if (NULL == vstarts || NULL == vcounts) {
+        rc = PRRTE_ERR_OUT_OF_RESOURCE;
+        goto cleanup;
+    }
+    cnt = nvruns;
+    if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buf, vstarts, &cnt, PRRTE_UINT32))) {
+        PRRTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    cnt = nvruns;
+    if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buf, vcounts, &cnt, PRRTE_UINT32))) {
+        PRRTE_ERROR_LOG(rc);
+        goto cleanup;
+    }
+
+    /* if we are the HNP, we don't need any of this stuff */
+    if (NULL == daemons) {
+        goto cleanup;
+    }
+
+    /* create the node pool array - this will include
+     * _all_ nodes known to the allocation */
+    n = 0;
+    v = 0;
+    vk = 0;
+    for (r=0; r < nranges; r++) {
+        for (k=0; k < counts[r]; k++) {
+            if (0 > widths[r]) {
+                name = strdup(prefixes[r]);
+            } else if (0 > prrte_asprintf(&name, "%s%0*u%s", prefixes[r],
+                                          (int)widths[r], starts[r] + k,
+                                          suffixes[r])) {
+                rc = PRRTE_ERR_OUT_OF_RESOURCE;
+                goto cleanup;
+            }
+            /* step thru the vpid runs alongside the names */
+            while (v < nvruns && vk == vcounts[v]) {
+                ++v;
+                vk = 0;
+            }
+            if (v == nvruns) {
+                free(name);
+                PRRTE_ERROR_LOG(PRRTE_ERR_BAD_PARAM);
+                rc = PRRTE_ERR_BAD_PARAM;
+                goto cleanup;
+            }
+            if (UINT32_MAX == vstarts[v]) {
+                vpid = UINT32_MAX;
+            } else {
+                vpid = vstarts[v] + vk;
+            }
+            ++vk;
+            nidmap_add_node(n, name, vpid, daemons, t);
+            ++n;
+        }
+    }
+
+  cleanup:
+    for (r=0; NULL != prefixes && r < nranges; r++) {
+        if (NULL != prefixes[r]) {
+            free(prefixes[r]);
+        }
+        if (NULL != suffixes[r]) {
+            free(suffixes[r]);
+        }
+    }
+    if (NULL != prefixes) {
+        free(prefixes);
+    }
+    if (NULL != suffixes) {
+        free(suffixes);
+    }
+    if (NULL != widths) {
+        free(widths);
+    }
+    if (NULL != starts) {
+        free(starts);
+    }
+    if (NULL != counts) {
+        free(counts);
+    }
+    if (NULL != vstarts) {
+        free(vstarts);
+    }
+    if (NULL != vcounts) {
+        free(vcounts);
+    }
+    return rc;
+}
+
+int prrte_util_decode_nidmap(prrte_buffer_t *buf)
+{
+    uint8_t u8;
+    int cnt, rc, n;
+    prrte_job_t *daemons = NULL;
+    prrte_topology_t *t = NULL;
+
+    /* unpack the flag indicating if HNP is in allocation */
+    cnt = 1;
+    if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buf, &u8, &cnt, PRRTE_UINT8))) {
+        PRRTE_ERROR_LOG(rc);
+        return rc;
+    }
+    if (1 == u8) {
+        prrte_hnp_is_allocated = true;
+    } else {
+        prrte_hnp_is_allocated = false;
+    }
+
+    /* unpack the flag indicating if we are in managed allocation */
+    cnt = 1;
+    if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buf, &u8, &cnt, PRRTE_UINT8))) {
+        PRRTE_ERROR_LOG(rc);
+        return rc;
+    }
+    if (1 == u8) {
+        prrte_managed_allocation = true;
+    } else {
+        prrte_managed_allocation = false;
+    }
+
+    /* if we are the HNP, we only need to get past the node
+     * info - otherwise, get the objects it will populate */
+    if (!PRRTE_PROC_IS_MASTER) {
+        /* get the daemon job object */
+        daemons = prrte_get_job_data_object(PRRTE_PROC_MY_NAME->jobid);
+
+        /* get our topology */
+        for (n=0; n < prrte_node_topologies->size; n++) {
+            if (NULL != (t = (prrte_topology_t*)prrte_pointer_array_get_item(prrte_node_topologies, n))) {
+                break;
+            }
+        }
+        if (NULL == t) {
+            /* should never happen */
+            PRRTE_ERROR_LOG(PRRTE_ERR_NOT_FOUND);
+            return PRRTE_ERR_NOT_FOUND;
+        }
+    }
+
+    /* unpack the encoding */
+    cnt = 1;
+    if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buf, &u8, &cnt, PRRTE_UINT8))) {
+        PRRTE_ERROR_LOG(rc);
+        return rc;
+    }
+    if (PRRTE_NIDMAP_RANGES == u8) {
+        rc = unpack_ranges(buf, daemons, t);
+    } else if (PRRTE_NIDMAP_LEGACY == u8) {
+        rc = unpack_legacy(buf, daemons, t);
+    } else {
+        rc = PRRTE_ERR_BAD_PARAM;
+    }
+    if (PRRTE_SUCCESS != rc) {
+        PRRTE_ERROR_LOG(rc);
+        return rc;
+    }
+
+    /* if we are the HNP, we don't need any of this stuff */
+    if (PRRTE_PROC_IS_MASTER) {
+        return PRRTE_SUCCESS;
+    }
+
+    /* update num procs */
+    if (prrte_process_info.num_daemons != daemons->num_procs) {
+        prrte_process_info.num_daemons = daemons->num_procs;
+    }
+    /* need to update the routing plan */
+    prrte_routed.update_routing_plan();
+
+    return PRRTE_SUCCESS;
+}
+
 int prrte_util_pass_node_info(prrte_buffer_t *buffer)
 {
     uint16_t *slots=NULL, slot = UINT16_MAX;
@@ -657,8 +1106,8 @@ int prrte_util_pass_node_info(prrte_buffer_t *buffer)
             /* mark that this was not compressed */
             i8 = 0;
             compressed = false;
-            bo.bytes = flags;
-            bo.size = nbitmap;
+            bo.bytes = (uint8_t*)slots;
+            bo.size = nslots;
         }
         /* indicate compression */
         if (PRRTE_SUCCESS != (rc = prrte_dss.pack(buffer, &i8, 1, PRRTE_INT8))) {
@@ -741,11 +1190,92 @@ int prrte_util_pass_node_info(prrte_buffer_t *buffer)
     return rc;
 }
 
+/* per-node info received from the HNP. The values are indexed
+ * by the node's position in the node pool, and are only applied
+ * to a node object when that node is actually used - most daemons
+ * only ever touch their own node and the few nodes that host
+ * procs of the jobs they are launching */
+typedef struct {
+    int ntopos;
+    int8_t *topos;       // NULL => uniform topology
+    int nslots;
+    uint16_t *slots;     // NULL => uniform slots
+    uint16_t uslots;
+    int nflags;
+    uint8_t *flags;      // bitmap, NULL => uniform flags
+    bool uflags;
+    int nloaded;
+    uint8_t *loaded;
+} prrte_node_info_t;
+
+static prrte_node_info_t node_info = {0};
+static bool node_info_pending = false;
+
+static void node_info_release(void)
+{
+    if (NULL != node_info.topos) {
+        free(node_info.topos);
+    }
+    if (NULL != node_info.slots) {
+        free(node_info.slots);
+    }
+    if (NULL != node_info.flags) {
+        free(node_info.flags);
+    }
+    if (NULL != node_info.loaded) {
+        free(node_info.loaded);
+    }
+    memset(&node_info, 0, sizeof(node_info));
+    node_info_pending = false;
+}
+
+static void node_info_apply(prrte_node_t *nptr)
+{
+    int n = nptr->index;
+    bool given;
+
+    if (n < 0) {
+        return;
+    }
+    if (NULL != node_info.topos && n < node_info.ntopos) {
+        nptr->topology = prrte_pointer_array_get_item(prrte_node_topologies, node_info.topos[n]);
+    }
+    if (NULL == node_info.slots) {
+        nptr->slots = node_info.uslots;
+    } else if (n < node_info.nslots) {
+        nptr->slots = node_info.slots[n];
+    }
+    if (NULL == node_info.flags) {
+        given = node_info.uflags;
+    } else if (n/8 < node_info.nflags) {
+        given = (node_info.flags[n/8] & (1 << (7 - (n % 8))));
+    } else {
+        return;
+    }
+    if (given) {
+        PRRTE_FLAG_SET(nptr, PRRTE_NODE_FLAG_SLOTS_GIVEN);
+    } else {
+        PRRTE_FLAG_UNSET(nptr, PRRTE_NODE_FLAG_SLOTS_GIVEN);
+    }
+}
+
+void prrte_util_node_info_load(prrte_node_t *nptr)
+{
+    if (!node_info_pending || nptr->index < 0 ||
+        node_info.nloaded <= nptr->index) {
+        return;
+    }
+    if (!node_info.loaded[nptr->index]) {
+        node_info_apply(nptr);
+        node_info.loaded[nptr->index] = 1;
+    }
+}
+
 int prrte_util_parse_node_info(prrte_buffer_t *buf)
 {
     int8_t i8;
     bool compressed;
-    int rc = PRRTE_SUCCESS, cnt, n, m, index;
+    int rc = PRRTE_SUCCESS, cnt, n, index;
     prrte_node_t *nptr;
     size_t sz;
     prrte_byte_object_t *boptr;
@@ -756,6 +1286,11 @@ int prrte_util_parse_node_info(prrte_buffer_t *buf)
     hwloc_topology_t topo;
     char *sig;
     prrte_buffer_t bucket;
+    prrte_job_t *daemons;
+    prrte_proc_t *dmn;
+
+    /* discard anything left over from a prior allocation */
+    node_info_release();
 
     /* check to see if we have uniform topologies */
     cnt = 1;
@@ -808,6 +1343,7 @@ int prrte_util_parse_node_info(prrte_buffer_t *buf)
         if (NULL != boptr->bytes) {
             free(boptr->bytes);
         }
+        free(boptr);
         /* setup to unpack */
         PRRTE_CONSTRUCT(&bucket, prrte_buffer_t);
         prrte_dss.load(&bucket, bytes, sz);
@@ -836,7 +1372,10 @@ int prrte_util_parse_node_info(prrte_buffer_t *buf)
             t2->index = index;
             t2->sig = sig;
             t2->topo = topo;
-            prrte_pointer_array_set_item(prrte_node_topologies, index, t2);
+            if (PRRTE_SUCCESS != (rc = prrte_set_topology_object(t2))) {
+                PRRTE_ERROR_LOG(rc);
+                goto cleanup;
+            }
         }
         PRRTE_DESTRUCT(&bucket);
 
@@ -885,18 +1424,21 @@ int prrte_util_parse_node_info(prrte_buffer_t *buf)
         free(boptr);
         PRRTE_CONSTRUCT(&bucket, prrte_buffer_t);
         prrte_dss.load(&bucket, bytes, sz);
-        /* cycle across the node pool and assign the values */
+        /* record the topology index of each node in the pool */
+        node_info.ntopos = prrte_node_pool->size;
+        node_info.topos = (int8_t*)calloc(node_info.ntopos, sizeof(int8_t));
         for (n=0; n < prrte_node_pool->size; n++) {
-            if (NULL != (nptr = (prrte_node_t*)prrte_pointer_array_get_item(prrte_node_pool, n))) {
+            if (NULL != prrte_pointer_array_get_item(prrte_node_pool, n)) {
                 /* unpack the next topology index */
                 cnt = 1;
-                if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(&bucket, &i8, &cnt, PRRTE_INT8))) {
+                if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(&bucket, &node_info.topos[n], &cnt, PRRTE_INT8))) {
                     PRRTE_ERROR_LOG(rc);
+                    PRRTE_DESTRUCT(&bucket);
                     goto cleanup;
                 }
-                nptr->topology = prrte_pointer_array_get_item(prrte_node_topologies, index);
             }
         }
+        PRRTE_DESTRUCT(&bucket);
     }
 
     /* check to see if we have uniform slot assignments */
@@ -908,12 +1450,7 @@ int prrte_util_parse_node_info(prrte_buffer_t *buf)
 
     /* if so, then make every node the same */
     if (0 > i8) {
-        i8 = -1 * i8;
-        for (n=0; n < prrte_node_pool->size; n++) {
-            if (NULL != (nptr = (prrte_node_t*)prrte_pointer_array_get_item(prrte_node_pool, n))) {
-                nptr->slots = i8;
-            }
-        }
+        node_info.uslots = -1 * i8;
     } else {
         /* if compressed, get the uncompressed size */
         if (1 == i8) {
@@ -943,6 +1480,7 @@ int prrte_util_parse_node_info(prrte_buffer_t *buf)
             }
         } else {
             slots = (uint16_t*)boptr->bytes;
+            sz = boptr->size;
             boptr->bytes = NULL;
             boptr->size = 0;
         }
@@ -950,13 +1488,10 @@ int prrte_util_parse_node_info(prrte_buffer_t *buf)
             free(boptr->bytes);
         }
         free(boptr);
-        /* cycle across the node pool and assign the values */
-        for (n=0, m=0; n < prrte_node_pool->size; n++) {
-            if (NULL != (nptr = (prrte_node_t*)prrte_pointer_array_get_item(prrte_node_pool, n))) {
-                nptr->slots = slots[m];
-                ++m;
-            }
-        }
+        /* the sender indexes the array by node pool position */
+        node_info.slots = slots;
+        node_info.nslots = sz / sizeof(uint16_t);
+        slots = NULL;
     }
 
     /* check to see if we have uniform flag assignments */
@@ -968,33 +1503,26 @@ int prrte_util_parse_node_info(prrte_buffer_t *buf)
 
     /* if so, then make every node the same */
     if (0 > i8) {
-         i8 += 2;
-        for (n=0; n < prrte_node_pool->size; n++) {
-            if (NULL != (nptr = (prrte_node_t*)prrte_pointer_array_get_item(prrte_node_pool, n))) {
-                if (i8) {
-                    PRRTE_FLAG_SET(nptr, PRRTE_NODE_FLAG_SLOTS_GIVEN);
-                } else {
-                    PRRTE_FLAG_UNSET(nptr, PRRTE_NODE_FLAG_SLOTS_GIVEN);
-                }
-            }
-        }
+        i8 += 2;
+        node_info.uflags = (0 != i8);
     } else {
-        /* if compressed, get the uncompressed size */
-        if (1 == i8) {
+        /* if compressed, get the uncompressed size - the flags
+         * are marked 2 when compressed and 3 when not */
+        if (2 == i8) {
             cnt = 1;
             if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buf, &sz, &cnt, PRRTE_SIZE))) {
                 PRRTE_ERROR_LOG(rc);
                 goto cleanup;
             }
         }
-        /* unpack the slots object */
+        /* unpack the flags object */
         cnt = 1;
         if (PRRTE_SUCCESS != (rc = prrte_dss.unpack(buf, &boptr, &cnt, PRRTE_BYTE_OBJECT))) {
             PRRTE_ERROR_LOG(rc);
             goto cleanup;
         }
         /* if compressed, decompress */
-        if (1 == i8) {
+        if (2 == i8) {
             if (!prrte_compress.decompress_block((uint8_t**)&flags, sz,
                                                 boptr->bytes, boptr->size)) {
                 PRRTE_ERROR_LOG(PRRTE_ERROR);
@@ -1007,6 +1535,7 @@ int prrte_util_parse_node_info(prrte_buffer_t *buf)
             }
         } else {
             flags = (uint8_t*)boptr->bytes;
+            sz = boptr->size;
             boptr->bytes = NULL;
             boptr->size = 0;
         }
@@ -1014,17 +1543,32 @@ int prrte_util_parse_node_info(prrte_buffer_t *buf)
             free(boptr->bytes);
         }
         free(boptr);
-        /* cycle across the node pool and assign the values */
-        for (n=0, m=0; n < prrte_node_pool->size; n++) {
+        /* the sender packs one bit per node pool position */
+        node_info.flags = flags;
+        node_info.nflags = sz;
+        flags = NULL;
+    }
+
+    node_info.nloaded = prrte_node_pool->size;
+    node_info.loaded = (uint8_t*)calloc(node_info.nloaded, sizeof(uint8_t));
+    node_info_pending = true;
+
+    if (prrte_lazy_node_info) {
+        /* we always need our own node - everything else is
+         * applied when a job is mapped onto it */
+        daemons = prrte_get_job_data_object(PRRTE_PROC_MY_NAME->jobid);
+        if (NULL != daemons &&
+            NULL != (dmn = (prrte_proc_t*)prrte_pointer_array_get_item(daemons->procs, PRRTE_PROC_MY_NAME->vpid)) &&
+            NULL != dmn->node) {
+            prrte_util_node_info_load(dmn->node);
+        }
+    } else {
+        for (n=0; n < prrte_node_pool->size; n++) {
             if (NULL != (nptr = (prrte_node_t*)prrte_pointer_array_get_item(prrte_node_pool, n))) {
-                if (flags[m]) {
-                    PRRTE_FLAG_SET(nptr, PRRTE_NODE_FLAG_SLOTS_GIVEN);
-                } else {
-                    PRRTE_FLAG_UNSET(nptr, PRRTE_NODE_FLAG_SLOTS_GIVEN);
-                }
-                ++m;
+                node_info_apply(nptr);
             }
         }
+        node_info_release();
     }
 
   cleanup:
@@ -1213,6 +1757,8 @@ int prrte_util_decode_ppn(prrte_job_t *jdata,
             }
             /* add the node to the job map if not already assigned */
             if (!PRRTE_FLAG_TEST(node, PRRTE_NODE_FLAG_MAPPED)) {
+                /* make sure its slots and topology are current */
+                prrte_util_node_info_load(node);
                 PRRTE_RETAIN(node);
                 prrte_pointer_array_add(jdata->map->nodes, node);
                 PRRTE_FLAG_SET(node, PRRTE_NODE_FLAG_MAPPED);
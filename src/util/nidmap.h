@@ -41,6 +41,10 @@ PRRTE_EXPORT int prrte_util_pass_node_info(prrte_buffer_t *buf);
 
 PRRTE_EXPORT int prrte_util_parse_node_info(prrte_buffer_t *buf);
 
+/* apply any pending node info to the given node - the info
+ * passed by the HNP is only applied to a node on first use */
+PRRTE_EXPORT void prrte_util_node_info_load(prrte_node_t *node);
+
 
 /* pass info about node assignments for a specific job */
 PRRTE_EXPORT int prrte_util_generate_ppn(prrte_job_t *jdata,
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2020      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Stress the PRRTE data server: publish a large number of keys,
+ * look every one of them up, unpublish them all, and time each
+ * phase. A second, smaller set of keys is published with
+ * first-read persistence to check that they are gone once read.
+ *
+ * Usage: prte -n 1 ./pubsub-stress [-n nkeys] [-b keys/call]
+ * Only rank 0 runs the test if more procs are started.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include <pmix.h>
+
+#define ERR(msg, ...)                                                   \
+    do {                                                                \
+        fprintf(stderr, "ERROR: %s:%d  " msg "\n", __FILE__, __LINE__, ## __VA_ARGS__); \
+        exit(1);                                                        \
+    } while(0);
+
+static double elapsed(struct timeval *start)
+{
+    struct timeval stop;
+
+    gettimeofday(&stop, NULL);
+    return (double)(stop.tv_sec - start->tv_sec) +
+           (double)(stop.tv_usec - start->tv_usec) / 1000000.0;
+}
+
+static void publish(const char *prefix, size_t first, size_t nkeys, bool once)
+{
+    pmix_info_t *info;
+    pmix_persistence_t persist = PMIX_PERSIST_FIRST_READ;
+    size_t n, ninfo;
+    int rc;
+
+    ninfo = nkeys + (once ? 1 : 0);
+    PMIX_INFO_CREATE(info, ninfo);
+    for (n=0; n < nkeys; n++) {
+        snprintf(info[n].key, PMIX_MAX_KEYLEN, "%s-%lu", prefix, (unsigned long)(first + n));
+        info[n].value.type = PMIX_SIZE;
+        info[n].value.data.size = first + n;
+    }
+    if (once) {
+        PMIX_INFO_LOAD(&info[nkeys], PMIX_PERSISTENCE, &persist, PMIX_PERSIST);
+    }
+    if (PMIX_SUCCESS != (rc = PMIx_Publish(info, ninfo))) {
+        ERR("PMIx_Publish of %s-%lu failed: %s", prefix, (unsigned long)first, PMIx_Error_string(rc));
+    }
+    PMIX_INFO_FREE(info, ninfo);
+}
+
+/* returns the status of the lookup - all values found are checked */
+static int lookup(const char *prefix, size_t first, size_t nkeys)
+{
+    pmix_pdata_t *pdata;
+    size_t n;
+    int rc;
+
+    PMIX_PDATA_CREATE(pdata, nkeys);
+    for (n=0; n < nkeys; n++) {
+        snprintf(pdata[n].key, PMIX_MAX_KEYLEN, "%s-%lu", prefix, (unsigned long)(first + n));
+    }
+    rc = PMIx_Lookup(pdata, nkeys, NULL, 0);
+    if (PMIX_SUCCESS == rc) {
+        for (n=0; n < nkeys; n++) {
+            if (PMIX_SIZE != pdata[n].value.type ||
+                first + n != pdata[n].value.data.size) {
+                ERR("PMIx_Lookup returned the wrong value for %s", pdata[n].key);
+            }
+        }
+    }
+    PMIX_PDATA_FREE(pdata, nkeys);
+    return rc;
+}
+
+static void unpublish(const char *prefix, size_t first, size_t nkeys)
+{
+    char **keys;
+    size_t n;
+    int rc;
+
+    keys = (char**)calloc(nkeys + 1, sizeof(char*));
+    for (n=0; n < nkeys; n++) {
+        keys[n] = (char*)malloc(PMIX_MAX_KEYLEN);
+        snprintf(keys[n], PMIX_MAX_KEYLEN, "%s-%lu", prefix, (unsigned long)(first + n));
+    }
+    if (PMIX_SUCCESS != (rc = PMIx_Unpublish(keys, NULL, 0))) {
+        ERR("PMIx_Unpublish of %s-%lu failed: %s", prefix, (unsigned long)first, PMIx_Error_string(rc));
+    }
+    for (n=0; n < nkeys; n++) {
+        free(keys[n]);
+    }
+    free(keys);
+}
+
+int main(int argc, char **argv)
+{
+    pmix_proc_t myproc;
+    size_t nkeys = 1000000, batch = 1000, nonce, n, m;
+    struct timeval start;
+    int i, rc;
+
+    for (i=1; i < argc; i++) {
+        if (0 == strcmp(argv[i], "-n") && i+1 < argc) {
+            nkeys = strtoul(argv[++i], NULL, 10);
+        } else if (0 == strcmp(argv[i], "-b") && i+1 < argc) {
+            batch = strtoul(argv[++i], NULL, 10);
+        } else {
+            fprintf(stderr, "Usage: %s [-n nkeys] [-b keys/call]\n", argv[0]);
+            exit(1);
+        }
+    }
+    if (0 == nkeys || 0 == batch) {
+        fprintf(stderr, "nkeys and keys/call must be positive\n");
+        exit(1);
+    }
+    nonce = (nkeys < 1000) ? nkeys : 1000;
+
+    if (PMIX_SUCCESS != (rc = PMIx_Init(&myproc, NULL, 0))) {
+        ERR("PMIx_Init failed: %s", PMIx_Error_string(rc));
+    }
+    /* the keys are global, so only one proc can drive the test */
+    if (0 != myproc.rank) {
+        goto done;
+    }
+
+    gettimeofday(&start, NULL);
+    for (n=0; n < nkeys; n += m) {
+        m = (nkeys - n < batch) ? nkeys - n : batch;
+        publish("stress", n, m, false);
+    }
+    fprintf(stdout, "publish   %lu keys: %f sec\n", (unsigned long)nkeys, elapsed(&start));
+
+    gettimeofday(&start, NULL);
+    for (n=0; n < nkeys; n += m) {
+        m = (nkeys - n < batch) ? nkeys - n : batch;
+        if (PMIX_SUCCESS != (rc = lookup("stress", n, m))) {
+            ERR("PMIx_Lookup of stress-%lu failed: %s", (unsigned long)n, PMIx_Error_string(rc));
+        }
+    }
+    fprintf(stdout, "lookup    %lu keys: %f sec\n", (unsigned long)nkeys, elapsed(&start));
+
+    /* values that may only be read once must be gone after
+     * the first lookup */
+    gettimeofday(&start, NULL);
+    for (n=0; n < nonce; n += m) {
+        m = (nonce - n < batch) ? nonce - n : batch;
+        publish("once", n, m, true);
+        if (PMIX_SUCCESS != (rc = lookup("once", n, m))) {
+            ERR("PMIx_Lookup of once-%lu failed: %s", (unsigned long)n, PMIx_Error_string(rc));
+        }
+        if (PMIX_SUCCESS == lookup("once", n, m)) {
+            ERR("once-%lu could be read twice", (unsigned long)n);
+        }
+    }
+    fprintf(stdout, "read-once %lu keys: %f sec\n", (unsigned long)nonce, elapsed(&start));
+
+    gettimeofday(&start, NULL);
+    for (n=0; n < nkeys; n += m) {
+        m = (nkeys - n < batch) ? nkeys - n : batch;
+        unpublish("stress", n, m);
+    }
+    fprintf(stdout, "unpublish %lu keys: %f sec\n", (unsigned long)nkeys, elapsed(&start));
+
+    /* nothing should be left */
+    for (n=0; n < nkeys; n += nkeys / 10 + 1) {
+        if (PMIX_SUCCESS == lookup("stress", n, 1)) {
+            ERR("stress-%lu was still published", (unsigned long)n);
+        }
+    }
+
+  done:
+    if (PMIX_SUCCESS != (rc = PMIx_Finalize(NULL, 0))) {
+        ERR("PMIx_Finalize failed: %s", PMIx_Error_string(rc));
+    }
+    return 0;
+}